@@ -40,21 +40,32 @@ SYSTEM_VERSION_PATCH
  #define DEVICE_GUN     2
  /// Vest device type identifier
  #define DEVICE_VEST    3
+ /// Spectator display device type identifier
+ #define DEVICE_SPECTATOR 4
  
  // -----------------------------------------------------------------------------
  // Nexus Configuration
  // -----------------------------------------------------------------------------
- /// Project ID for Nexus network
- #define NEXUS_PROJECT_ID 1
+ /// Project ID of the first arena; the Manager hosts arenas on consecutive project IDs
+ #define NEXUS_BASE_PROJECT_ID 1
+ /// Project ID for Nexus network (each arena is its own project; DEVICE_ARENA from SelectDevice.h)
+ #define NEXUS_PROJECT_ID (NEXUS_BASE_PROJECT_ID + DEVICE_ARENA)
  /// Bitmask of groups for this device (1 << (DEVICE_TYPE - 1))
  #define NEXUS_GROUPS     (1 << (DEVICE_TYPE - 1))
  /// Device ID within the Nexus network (provided by SelectDevice.h)
  #define NEXUS_DEVICE_ID  DEVICE_ID
  
- // Group identifiers for manager, gun, and vest
- #define NEXUS_GROUP_MANAGER 0x01
- #define NEXUS_GROUP_GUN     0x02
- #define NEXUS_GROUP_VEST    0x04
+ // Group identifiers for manager, gun, vest, and spectator displays
+ #define NEXUS_GROUP_MANAGER   0x01
+ #define NEXUS_GROUP_GUN       0x02
+ #define NEXUS_GROUP_VEST      0x04
+ #define NEXUS_GROUP_SPECTATOR 0x08
+
+ /// Pre-shared secret the Manager and Vests derive hit report keys from; never sent.
+ /// Injected per installation from the git-ignored secrets.ini (see secrets.ini.example).
+ #ifndef HIT_REPORT_SECRET
+ #error "HIT_REPORT_SECRET is not defined: copy secrets.ini.example to secrets.ini and set a secret"
+ #endif
  
  // -----------------------------------------------------------------------------
  // Conversion Functions
@@ -62,7 +73,7 @@ SYSTEM_VERSION_PATCH
  /**
   * @brief Convert a device type constant to its corresponding Nexus group bitmask.
   *
-  * @param deviceType One of DEVICE_MANAGER, DEVICE_GUN, DEVICE_VEST
+  * @param deviceType One of DEVICE_MANAGER, DEVICE_GUN, DEVICE_VEST, DEVICE_SPECTATOR
   * @return Nexus group mask (NEXUS_GROUP_*) or 0 if invalid
   */
  inline uint8_t deviceTypeToGroup(uint8_t deviceType) {
@@ -70,6 +81,7 @@ SYSTEM_VERSION_PATCH
          case DEVICE_MANAGER: return NEXUS_GROUP_MANAGER;
          case DEVICE_GUN:     return NEXUS_GROUP_GUN;
          case DEVICE_VEST:    return NEXUS_GROUP_VEST;
+         case DEVICE_SPECTATOR: return NEXUS_GROUP_SPECTATOR;
          default:             return 0;
      }
  }
@@ -77,7 +89,7 @@ SYSTEM_VERSION_PATCH
  /**
   * @brief Convert a Nexus group bitmask to its corresponding device type constant.
   *
-  * @param group One of NEXUS_GROUP_MANAGER, NEXUS_GROUP_GUN, NEXUS_GROUP_VEST
+  * @param group One of NEXUS_GROUP_MANAGER, NEXUS_GROUP_GUN, NEXUS_GROUP_VEST, NEXUS_GROUP_SPECTATOR
   * @return DEVICE_* constant or 0 if invalid
   */
  inline uint8_t groupToDeviceType(uint8_t group) {
@@ -85,6 +97,7 @@ SYSTEM_VERSION_PATCH
          case NEXUS_GROUP_MANAGER: return DEVICE_MANAGER;
          case NEXUS_GROUP_GUN:     return DEVICE_GUN;
          case NEXUS_GROUP_VEST:    return DEVICE_VEST;
+         case NEXUS_GROUP_SPECTATOR: return DEVICE_SPECTATOR;
          default:                  return 0;
      }
  }
@@ -92,14 +105,15 @@ SYSTEM_VERSION_PATCH
  /**
   * @brief Get a human-readable string for a device type constant.
   *
-  * @param deviceType DEVICE_MANAGER, DEVICE_GUN, or DEVICE_VEST
-  * @return "Manager", "Gun", "Vest", or "Unknown"
+  * @param deviceType DEVICE_MANAGER, DEVICE_GUN, DEVICE_VEST, or DEVICE_SPECTATOR
+  * @return "Manager", "Gun", "Vest", "Spectator", or "Unknown"
   */
  inline String deviceTypeString(int deviceType) {
      switch (deviceType) {
          case DEVICE_MANAGER: return "Manager";
          case DEVICE_GUN:     return "Gun";
          case DEVICE_VEST:    return "Vest";
+         case DEVICE_SPECTATOR: return "Spectator";
          default:             return "Unknown";
      }
  }
@@ -107,14 +121,15 @@ SYSTEM_VERSION_PATCH
  /**
   * @brief Get a human-readable string for a Nexus group bitmask.
   *
-  * @param group NEXUS_GROUP_MANAGER, NEXUS_GROUP_GUN, or NEXUS_GROUP_VEST
-  * @return "Manager", "Gun", "Vest", or "Unknown"
+  * @param group NEXUS_GROUP_MANAGER, NEXUS_GROUP_GUN, NEXUS_GROUP_VEST, or NEXUS_GROUP_SPECTATOR
+  * @return "Manager", "Gun", "Vest", "Spectator", or "Unknown"
   */
  inline String deviceGroupString(uint8_t group) {
      switch (group) {
          case NEXUS_GROUP_MANAGER: return "Manager";
          case NEXUS_GROUP_GUN:     return "Gun";
          case NEXUS_GROUP_VEST:    return "Vest";
+         case NEXUS_GROUP_SPECTATOR: return "Spectator";
          default:                  return "Unknown";
      }
  }
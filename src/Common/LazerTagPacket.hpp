@@ -13,6 +13,10 @@
  #include "Modules/Game.hpp"      ///< Defines GameStatus struct
  #include "Modules/Player.hpp"    ///< Defines Player state data
  #include "Modules/Gun.hpp"       ///< Defines GunData struct
+ #include "Modules/HitReport.hpp" ///< Defines HitTable, HitBatch, HitReport and HitMarker
+ #include "Modules/Scoreboard.hpp" ///< Defines Scoreboard
+ #include "Modules/Replica.hpp"  ///< Defines ReplicaFrame
+ #include "Modules/Loadout.hpp"  ///< Defines Loadout and GunStart
  #include "Components/Nexus/Nexus.hpp" ///< Nexus packet layer
  
  #include "Constants_common.h"    ///< Common constants and macros
@@ -27,6 +31,19 @@
   *  - COMMS_FIRECODE:   Transmit fire event code (uint32_t)
   *  - COMMS_GAMESTATUS: Transmit overall game status (GameStatus)
   *  - COMMS_MARK:       Transmit hit marker (no payload)
+  *  - COMMS_IRPROTOCOL: Select the IR protocol for the game (IRprotocolID)
+  *  - COMMS_IRSTATS_REQUEST: Ask a vest for its IR decode counters (no payload)
+  *  - COMMS_IRSTATS:    IR decode counters of a vest (IRhitStats)
+  *  - COMMS_SHOTCOUNT:  Shots a gun fired during the game (uint32_t)
+  *  - COMMS_HITTABLE:   Opponents and key nonce for vest-local damage (HitTable)
+  *  - COMMS_HITREPORT:  Signed hit a vest already applied (HitReport)
+  *  - COMMS_HITBATCH:   Fire codes a vest received within its coalescing window (HitBatch)
+  *  - COMMS_HITMARKER:  Hit confirmation to the shooter's gun (HitMarker)
+  *  - COMMS_SCOREBOARD: Live match state for spectator displays (Scoreboard)
+  *  - COMMS_REPLICA:    Match state from the primary Manager to a standby (ReplicaFrame, up to this size)
+  *  - COMMS_GUNSTART:   Game start data of a gun, naming its loadout by hash (GunStart)
+  *  - COMMS_LOADOUT_REQUEST: A gun misses a loadout in its cache (uint64_t hash)
+  *  - COMMS_LOADOUT:    Loadout blob for a gun's cache (Loadout)
   *  - COMMS_size:       Sentinel value for command count
   */
  enum CommsCommand : uint32_t {
@@ -37,6 +54,19 @@
      COMMS_MARK,       ///< Mark marker (no payload)
      COMMS_DEMARK,     ///< Demark marker (no payload)
      COMMS_GUNNAME,    ///< Gun name (32 characters)
+     COMMS_IRPROTOCOL, ///< IR protocol used for fire codes
+     COMMS_IRSTATS_REQUEST, ///< Request for IR decode counters (no payload)
+     COMMS_IRSTATS,    ///< IR decode counters
+     COMMS_SHOTCOUNT,  ///< Shots fired by a gun
+     COMMS_HITTABLE,   ///< Hit table for vest-local damage
+     COMMS_HITREPORT,  ///< Signed hit report of a vest
+     COMMS_HITBATCH,   ///< Batch of fire codes from a vest
+     COMMS_HITMARKER,  ///< Hit confirmation for a gun
+     COMMS_SCOREBOARD, ///< Scoreboard for spectator displays
+     COMMS_REPLICA,    ///< Replication frame for a standby Manager
+     COMMS_GUNSTART,   ///< Game start data of a gun
+     COMMS_LOADOUT_REQUEST, ///< Loadout a gun does not hold
+     COMMS_LOADOUT,    ///< Loadout blob
      COMMS_size        ///< Total number of commands
  };
  
@@ -53,7 +83,20 @@
      sizeof(GameStatus),    ///< COMMS_GAMESTATUS
      0,                     ///< COMMS_MARK
      0,                     ///< COMMS_DEMARK
-     MAX_GUN_NAME_LENGTH    ///< COMMS_GUNNAME
+     MAX_GUN_NAME_LENGTH,   ///< COMMS_GUNNAME
+     sizeof(IRprotocolID),  ///< COMMS_IRPROTOCOL
+     0,                     ///< COMMS_IRSTATS_REQUEST
+     sizeof(IRhitStats),    ///< COMMS_IRSTATS
+     sizeof(uint32_t),      ///< COMMS_SHOTCOUNT
+     sizeof(HitTable),      ///< COMMS_HITTABLE
+     sizeof(HitReport),     ///< COMMS_HITREPORT
+     sizeof(HitBatch),      ///< COMMS_HITBATCH
+     sizeof(HitMarker),     ///< COMMS_HITMARKER
+     sizeof(Scoreboard),    ///< COMMS_SCOREBOARD
+     sizeof(ReplicaFrame),  ///< COMMS_REPLICA
+     sizeof(GunStart),      ///< COMMS_GUNSTART
+     sizeof(uint64_t),      ///< COMMS_LOADOUT_REQUEST
+     sizeof(Loadout)        ///< COMMS_LOADOUT
  };
  
  #endif // LAZERTAGPACKET_HPP 
\ No newline at end of file
@@ -0,0 +1,182 @@
+/**
+ * @file IRchannelSimulator.hpp
+ * @brief Host stand-in for the optical IR channel, used to evaluate codecs before flashing.
+ *
+ * Encodes frames with IRencoder, renders them into an edge timeline with
+ * configurable jitter, multipath echo, ambient-light glitches and dropouts,
+ * and replays the timeline through IRreceiver::feedEdge(). Reports decode
+ * rate, false positives and decode time per frame.
+ *
+ * Not included by IRremoteESP32.hpp; include it explicitly where needed.
+ * test/test_ir_channel runs it as a benchmark (pio test -e native).
+ * NEC_THRESHOLD and NEC_BOUNCE_STOP_FILTER can be overridden with -D to
+ * compare settings.
+ */
+
+ #ifndef IRCHANNELSIMULATOR_HPP
+ #define IRCHANNELSIMULATOR_HPP
+
+ #include "IRremoteESP32.hpp"
+ #ifndef ARDUINO
+ #include <chrono>
+ #endif
+
+ /**
+  * @struct IRchannelConfig
+  * @brief Impairments applied to every simulated frame.
+  *
+  * Probabilities are in percent per pulse.
+  */
+ struct IRchannelConfig {
+   uint16_t jitter;         ///< Maximum edge displacement, uniform ± (µs).
+   uint8_t  echoPercent;    ///< Chance a mark is stretched by a multipath echo.
+   uint16_t echoDelay;      ///< Echo stretch of the mark, taken from the next space (µs).
+   uint8_t  glitchPercent;  ///< Chance a space contains an ambient-light glitch.
+   uint16_t glitchWidth;    ///< Width of a glitch mark (µs).
+   uint8_t  dropoutPercent; ///< Chance a mark is lost entirely.
+   uint32_t seed;           ///< PRNG seed, so runs are reproducible.
+
+   /** Default constructor describes a clean channel. */
+   IRchannelConfig()
+     : jitter(0), echoPercent(0), echoDelay(0), glitchPercent(0), glitchWidth(0),
+       dropoutPercent(0), seed(1) {}
+ };
+
+ /**
+  * @struct IRchannelResult
+  * @brief Outcome of a simulation run.
+  */
+ struct IRchannelResult {
+   uint32_t framesSent;     ///< Frames put on the simulated channel.
+   uint32_t decoded;        ///< Frames decoded with the sent value.
+   uint32_t falsePositives; ///< Frames decoded with any other value.
+   float    decodeMicros;   ///< CPU time spent inside feedEdge() (µs).
+
+   /** Default constructor zeroes the result. */
+   IRchannelResult() : framesSent(0), decoded(0), falsePositives(0), decodeMicros(0.0f) {}
+
+   /** @brief Fraction of sent frames that decoded correctly. */
+   float decodeRate() const { return framesSent ? float(decoded) / framesSent : 0.0f; }
+   /** @brief Wrong frames per sent frame. */
+   float falsePositiveRate() const { return framesSent ? float(falsePositives) / framesSent : 0.0f; }
+   /** @brief Average decode time per sent frame (µs). */
+   float microsPerFrame() const { return framesSent ? decodeMicros / framesSent : 0.0f; }
+ };
+
+ /**
+  * @class IRchannelSimulator
+  * @brief Renders frames through an impaired channel into a receiver.
+  */
+ class IRchannelSimulator {
+ public:
+   /**
+    * @brief Constructs a simulator.
+    * @param channel Impairments to apply.
+    */
+   explicit IRchannelSimulator(const IRchannelConfig &channel)
+     : config(channel), state(channel.seed ? channel.seed : 1), clock(0), lastEdge(0) {}
+
+   /**
+    * @brief Sends frames through the channel into a receiver and scores the output.
+    *
+    * The receiver must have @p Protocol enabled. Frames are separated by the
+    * encoder's inter-frame gap; the receiver's buffer is drained after each one.
+    *
+    * @tparam Protocol Descriptor used for encoding (e.g. NECProtocol).
+    * @param receiver Receiver under test.
+    * @param codes    Frame values to send.
+    * @param count    Number of frames.
+    * @param result   Accumulates the outcome.
+    */
+   template <typename Protocol>
+   void run(IRreceiver &receiver, const uint32_t *codes, size_t count, IRchannelResult &result) {
+     IRpulseTrain train;
+     for (size_t i = 0; i < count; ++i) {
+       IRencoder<Protocol>::encode(codes[i], train);
+       render(receiver, train, result);
+       ++result.framesSent;
+
+       while (receiver.available()) {
+         if (receiver.readFull() == codes[i]) ++result.decoded;
+         else ++result.falsePositives;
+       }
+     }
+   }
+
+ private:
+   IRchannelConfig config; ///< Impairments.
+   uint32_t state;         ///< xorshift32 PRNG state.
+   uint32_t clock;         ///< Simulated time (µs).
+   uint32_t lastEdge;      ///< Timestamp of the last delivered edge.
+
+   /** @brief Next pseudo-random number (xorshift32). */
+   uint32_t next() {
+     state ^= state << 13;
+     state ^= state >> 17;
+     state ^= state << 5;
+     return state;
+   }
+
+   /** @brief True with the given probability in percent. */
+   bool chance(uint8_t percent) { return percent && (next() % 100) < percent; }
+
+   /**
+    * @brief Delivers one edge at time @p t, displaced by jitter.
+    *
+    * Edges never move before the previous one, so the receiver always sees
+    * a monotonic clock.
+    */
+   void edge(IRreceiver &receiver, uint32_t t, IRchannelResult &result) {
+     if (config.jitter) {
+       int32_t offset = int32_t(next() % (2UL * config.jitter + 1)) - config.jitter;
+       t = uint32_t(int32_t(t) + offset);
+     }
+     if (int32_t(t - lastEdge) <= 0) t = lastEdge + 1;
+     lastEdge = t;
+
+     // On the host micros() follows simulated time, so use the wall clock
+ #ifdef ARDUINO
+     uint32_t start = micros();
+     receiver.feedEdge(t);
+     result.decodeMicros += micros() - start;
+ #else
+     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+     receiver.feedEdge(t);
+     result.decodeMicros += std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+ #endif
+   }
+
+   /** @brief Renders one pulse train as impaired edges. */
+   void render(IRreceiver &receiver, const IRpulseTrain &train, IRchannelResult &result) {
+     uint32_t carry = 0; // Echo time borrowed from the next space
+     for (uint8_t i = 0; i < train.length; ++i) {
+       uint32_t duration = train.durations[i];
+
+       if (IRpulseTrain::isMark(i)) {
+         if (chance(config.dropoutPercent)) { // Mark lost: the space continues
+           clock += duration;
+           continue;
+         }
+         if (chance(config.echoPercent)) {
+           duration += config.echoDelay;
+           carry = config.echoDelay;
+         }
+         edge(receiver, clock, result);
+         clock += duration;
+         edge(receiver, clock, result);
+       } else {
+         duration = duration > carry ? duration - carry : 0;
+         carry = 0;
+         uint32_t width = config.glitchWidth;
+         if (width && duration > 3 * width && chance(config.glitchPercent)) {
+           uint32_t at = clock + width + next() % (duration - 2 * width);
+           edge(receiver, at, result);
+           edge(receiver, at + width, result);
+         }
+         clock += duration;
+       }
+     }
+   }
+ };
+
+ #endif // IRCHANNELSIMULATOR_HPP
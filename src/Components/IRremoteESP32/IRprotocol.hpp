@@ -0,0 +1,346 @@
+/**
+ * @file IRprotocol.hpp
+ * @brief Compile-time IR protocol descriptors and the codec templates built on them.
+ *
+ * A protocol is described by a struct of static constexpr timings (header
+ * mark/space, bit mark, one/zero space, bit count, tolerance) plus a validity
+ * check. IRencoder and IRdecoder are instantiated per descriptor, so the
+ * sender and receiver always agree and adding a protocol costs nothing at
+ * runtime.
+ */
+
+ #ifndef IRPROTOCOL_HPP
+ #define IRPROTOCOL_HPP
+
+ #include "IRremoteESP32.hpp"
+
+ /**
+  * @brief Identifiers of the available IR protocols.
+  */
+ enum IRprotocolID : uint8_t {
+   IR_PROTOCOL_NEC,   /**< Standard 32-bit NEC. */
+   IR_PROTOCOL_TAG,   /**< Short laser-tag frame (shooter + shot + CRC-4). */
+   IRprotocolID_size
+ };
+
+ /** @brief Bitmask selecting a protocol in a receiver's enabled set. */
+ inline uint8_t irProtocolMask(IRprotocolID id) { return 1 << id; }
+
+ /**
+  * @struct NECProtocol
+  * @brief Descriptor of the standard NEC protocol (pulse-distance, MSB first).
+  */
+ struct NECProtocol {
+   static constexpr IRprotocolID id = IR_PROTOCOL_NEC; ///< Protocol identifier.
+   static constexpr uint32_t headerMark  = NEC_HEADER_MARK;  ///< Header mark (µs).
+   static constexpr uint32_t headerSpace = NEC_HEADER_SPACE; ///< Header space (µs).
+   static constexpr uint32_t bitMark     = NEC_BIT_MARK;     ///< Bit mark (µs).
+   static constexpr uint32_t oneSpace    = NEC_ONE_SPACE;    ///< "1" space (µs).
+   static constexpr uint32_t zeroSpace   = NEC_ZERO_SPACE;   ///< "0" space (µs).
+   static constexpr uint8_t  bits        = NEC_BITS;         ///< Bits per frame.
+   static constexpr uint32_t tolerance   = NEC_THRESHOLD;    ///< Allowed deviation (µs).
+   static constexpr uint32_t bounceFilter = NEC_BOUNCE_STOP_FILTER; ///< Shorter pulses are glitches (µs).
+
+   /**
+    * @brief Checks that address and command are followed by their inverses.
+    * @param data Raw 32-bit frame.
+    */
+   static constexpr bool validate(uint32_t data) {
+     return (((data >> 24) & 0xFF) ^ 0xFF) == ((data >> 16) & 0xFF)
+         && (((data >> 8) & 0xFF) ^ 0xFF) == (data & 0xFF);
+   }
+ };
+
+ /** Tag protocol time unit (microseconds). */
+ #define TAG_UNIT 200UL
+ /** Payload bits of a tag frame (shooter ID + shot counter). */
+ #define TAG_PAYLOAD_BITS 16
+ /** CRC bits appended to a tag frame. */
+ #define TAG_CRC_BITS 4
+
+ /**
+  * @brief CRC-4/ITU (x^4 + x + 1) over the low @p nbits of @p value, MSB first.
+  */
+ inline uint8_t crc4(uint32_t value, uint8_t nbits) {
+   uint8_t crc = 0;
+   for (int8_t i = nbits - 1; i >= 0; --i) {
+     uint8_t in = ((value >> i) & 1) ^ ((crc >> 3) & 1);
+     crc = ((crc << 1) & 0x0F) ^ (in ? 0x03 : 0x00);
+   }
+   return crc;
+ }
+
+ /**
+  * @struct TagProtocol
+  * @brief Descriptor of the short laser-tag protocol.
+  *
+  * 20-bit pulse-distance frame, MSB first: 8-bit shooter ID, 8-bit shot
+  * counter, 4-bit CRC. With a 200 µs unit a frame takes at most 14 ms on air
+  * (about 5x shorter than NEC). Marks are 8 carrier cycles at 38 kHz, so the
+  * receivers must accept short bursts.
+  */
+ struct TagProtocol {
+   static constexpr IRprotocolID id = IR_PROTOCOL_TAG;        ///< Protocol identifier.
+   static constexpr uint32_t headerMark  = 6 * TAG_UNIT;       ///< Header mark (µs).
+   static constexpr uint32_t headerSpace = 3 * TAG_UNIT;       ///< Header space (µs).
+   static constexpr uint32_t bitMark     = TAG_UNIT;           ///< Bit mark (µs).
+   static constexpr uint32_t oneSpace    = 2 * TAG_UNIT;       ///< "1" space (µs).
+   static constexpr uint32_t zeroSpace   = TAG_UNIT;           ///< "0" space (µs).
+   static constexpr uint8_t  bits        = TAG_PAYLOAD_BITS + TAG_CRC_BITS; ///< Bits per frame.
+   static constexpr uint32_t tolerance   = 90UL;               ///< Allowed deviation (µs).
+   static constexpr uint32_t bounceFilter = TAG_UNIT / 2;      ///< Shorter pulses are glitches (µs).
+
+   /**
+    * @brief Checks the CRC-4 of a frame.
+    * @param data Raw 20-bit frame.
+    */
+   static bool validate(uint32_t data) {
+     return crc4(data >> TAG_CRC_BITS, TAG_PAYLOAD_BITS) == (data & 0x0F);
+   }
+ };
+
+ /**
+  * @brief A tag protocol frame: shooter ID, shot counter and CRC-4.
+  */
+ struct TAG_DATA {
+   uint32_t data; /**< Raw 20-bit frame (shooter:8 | shot:8 | crc:4). */
+
+   /** Construct from a raw frame. */
+   TAG_DATA(uint32_t value = 0) : data(value) {}
+   /** Construct from shooter ID and shot counter (computes the CRC). */
+   TAG_DATA(uint8_t shooter, uint8_t shot) {
+     uint32_t payload = (static_cast<uint32_t>(shooter) << 8) | shot;
+     data = (payload << TAG_CRC_BITS) | crc4(payload, TAG_PAYLOAD_BITS);
+   }
+
+   /** @brief Shooter ID carried by the frame. */
+   uint8_t shooter() const { return (data >> (TAG_CRC_BITS + 8)) & 0xFF; }
+   /** @brief Shot counter carried by the frame. */
+   uint8_t shot() const { return (data >> TAG_CRC_BITS) & 0xFF; }
+   /** @brief True if the CRC matches the payload. */
+   bool isValid() const { return TagProtocol::validate(data); }
+ };
+
+ /**
+  * @brief Encoder for a protocol descriptor.
+  * @tparam Protocol Descriptor struct (e.g. NECProtocol).
+  */
+ template <typename Protocol>
+ struct IRencoder {
+   static_assert(2 * Protocol::bits + 4 <= IR_MAX_PULSES, "Protocol frame does not fit in an IRpulseTrain");
+
+   /**
+    * @brief Fills a pulse train with one frame.
+    *
+    * Layout: header mark/space, one mark/space pair per bit (MSB first),
+    * a final bit mark and an inter-frame gap.
+    *
+    * @param data  Frame bits.
+    * @param out   Train to overwrite.
+    * @param nbits Number of bits to encode.
+    */
+   static void encode(uint32_t data, IRpulseTrain &out, uint8_t nbits = Protocol::bits) {
+     out.clear();
+     out.add(Protocol::headerMark);
+     out.add(Protocol::headerSpace);
+     for (uint32_t mask = 1UL << (nbits - 1); mask; mask >>= 1) {
+       out.add(Protocol::bitMark);
+       out.add((data & mask) ? Protocol::oneSpace : Protocol::zeroSpace);
+     }
+     out.add(Protocol::bitMark);
+     out.add(IR_SENDER_FRAME_GAP);
+   }
+
+   /** @brief Worst-case airtime of a frame (all ones, no gap) in microseconds. */
+   static constexpr uint32_t maxFrameTime() {
+     return Protocol::headerMark + Protocol::headerSpace
+          + Protocol::bits * (Protocol::bitMark + Protocol::oneSpace)
+          + Protocol::bitMark;
+   }
+ };
+
+ /**
+  * @brief Pulse-duration state machine for a protocol descriptor.
+  *
+  * Feed it the duration between consecutive edges; it reports when a full
+  * frame has been assembled. A pulse shorter than Protocol::bounceFilter is a
+  * glitch: it is merged with the pulses on both sides, so a brief flash inside
+  * a space (or dropout inside a mark) does not split it. This delays every
+  * pulse by one edge.
+  *
+  * Timing is self-calibrating: the header mark sets a scale (Q8, see
+  * IR_SCALE_ONE) that stretches every expected duration and the tolerance
+  * for the rest of the frame. Each valid frame also pulls a running
+  * calibration towards its own scale, which tracks the receiver's typical
+  * skew over time. A header is accepted if its scale lies within
+  * IR_SCALE_WINDOW of the calibration and within [IR_SCALE_MIN,
+  * IR_SCALE_MAX], so once a receiver has calibrated, ambient pulses far
+  * from its skew no longer start frames.
+  *
+  * Outcomes and the error of every matched pulse are counted in an
+  * IRdecodeStats at the cost of a few increments per pulse.
+  *
+  * @tparam Protocol Descriptor struct (e.g. NECProtocol).
+  */
+ template <typename Protocol>
+ class IRdecoder {
+ public:
+   /** @brief Constructs a decoder waiting for a header, with nominal timing. */
+   IRdecoder()
+     : stage(headerMark), bitCount(0), dataRead(0), scale(IR_SCALE_ONE), calibration(IR_SCALE_ONE),
+       pending(0), merging(false) {}
+
+   /** @brief Drops any partial frame. */
+   void reset() {
+     stage = headerMark;
+     pending = 0;
+     merging = false;
+   }
+
+   /** @brief Forgets the running calibration. */
+   void resetCalibration() { calibration = IR_SCALE_ONE; }
+
+   /** @brief Current decoding stage. */
+   NEC_STAGE getStage() const { return stage; }
+
+   /** @brief The last completed frame. */
+   uint32_t frame() const { return dataRead; }
+
+   /** @brief Running timing calibration (Q8, IR_SCALE_ONE = nominal). */
+   uint16_t getCalibration() const { return calibration; }
+
+   /** @brief Decode-quality counters. */
+   const IRdecodeStats &getStats() const { return stats; }
+
+   /** @brief Zeroes the decode-quality counters. */
+   void clearStats() { stats.clear(); }
+
+   /**
+    * @brief Accepts the time since the previous edge.
+    *
+    * Glitches are merged into the pending pulse; otherwise the pending pulse
+    * is passed to the state machine and @p duration becomes pending.
+    *
+    * @param duration Time since the previous edge (µs).
+    * @param validate True to require Protocol::validate() on completion.
+    * @return True when this edge completed a frame that passed
+    *         Protocol::validate() (if @p validate is set).
+    */
+   bool feed(uint32_t duration, bool validate = false) {
+     if (merging) { // Tail after a glitch has the pending pulse's polarity
+       pending += duration;
+       merging = false;
+       return false;
+     }
+     if (duration < Protocol::bounceFilter) {
+       pending += duration;
+       merging = true;
+       return false;
+     }
+     uint32_t pulse = pending;
+     pending = duration;
+     return pulse && step(pulse, validate);
+   }
+
+ private:
+   NEC_STAGE stage;      ///< Current decoding stage.
+   uint8_t bitCount;     ///< Bits received in the current frame.
+   uint32_t dataRead;    ///< Accumulated frame bits.
+   uint16_t scale;       ///< Timing scale of the current frame (Q8).
+   uint16_t calibration; ///< Running timing scale of this receiver (Q8).
+   uint32_t pending;     ///< Pulse waiting for the next edge (glitches merged in).
+   bool merging;         ///< True if the pending pulse absorbed a glitch and awaits its tail.
+   IRdecodeStats stats;  ///< Decode-quality counters.
+
+   /**
+    * @brief Advances the state machine by one pulse.
+    *
+    * @param duration Pulse length (µs).
+    * @param validate True to require Protocol::validate() on completion.
+    * @return True when this pulse completed a valid frame.
+    */
+   bool step(uint32_t duration, bool validate) {
+     switch (stage) {
+       case headerMark:
+         if (measureHeader(duration)) {
+           stage = headerSpace;
+           bitCount = 0;
+           dataRead = 0;
+           ++stats.started;
+         } else {
+           ++stats.failed[headerMark];
+         }
+         return false;
+
+       case headerSpace:
+         if (!matches(duration, Protocol::headerSpace)) return fail();
+         stage = bitMark;
+         return false;
+
+       case bitMark:
+         if (!matches(duration, Protocol::bitMark)) return fail();
+         stage = bitSpace;
+         return false;
+
+       case bitSpace:
+         if (matches(duration, Protocol::oneSpace)) {
+           dataRead = (dataRead << 1) | 1;
+         } else if (matches(duration, Protocol::zeroSpace)) {
+           dataRead = (dataRead << 1);
+         } else {
+           return fail();
+         }
+
+         if (++bitCount < Protocol::bits) {
+           stage = bitMark;
+           return false;
+         }
+         stage = headerMark;
+         if (validate && !Protocol::validate(dataRead)) {
+           ++stats.invalid;
+           return false;
+         }
+         ++stats.completed;
+         calibration += (static_cast<int16_t>(scale) - static_cast<int16_t>(calibration)) >> IR_SCALE_SMOOTHING;
+         return true;
+     }
+     return false;
+   }
+
+   /** @brief Counts a failure at the current stage and waits for a new header. */
+   bool fail() {
+     ++stats.failed[stage];
+     stage = headerMark;
+     return false;
+   }
+
+   /**
+    * @brief Derives the frame's timing scale from its header mark.
+    * @return True if the scale is within the window around the calibration.
+    */
+   bool measureHeader(uint32_t duration) {
+     uint32_t measured = (duration * IR_SCALE_ONE + Protocol::headerMark / 2) / Protocol::headerMark;
+     uint32_t low  = calibration > IR_SCALE_MIN + IR_SCALE_WINDOW ? calibration - IR_SCALE_WINDOW : IR_SCALE_MIN;
+     uint32_t high = calibration + IR_SCALE_WINDOW < IR_SCALE_MAX ? calibration + IR_SCALE_WINDOW : IR_SCALE_MAX;
+     if (measured < low || measured > high) return false;
+     scale = measured;
+     return true;
+   }
+
+   /**
+    * @brief Compares a pulse to a nominal duration at the frame's scale.
+    *
+    * On a match the absolute error is added to the error histogram.
+    */
+   bool matches(uint32_t duration, uint32_t nominal) {
+     uint32_t expected  = (nominal * scale) >> 8;
+     uint32_t tolerance = (Protocol::tolerance * scale) >> 8;
+     uint32_t error = duration > expected ? duration - expected : expected - duration;
+     if (error > tolerance) return false;
+     uint32_t bin = error * IR_ERROR_BINS / (tolerance + 1);
+     ++stats.errorHistogram[bin];
+     return true;
+   }
+ };
+
+ #endif // IRPROTOCOL_HPP
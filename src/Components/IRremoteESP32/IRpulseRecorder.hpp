@@ -0,0 +1,75 @@
+/**
+ * @file IRpulseRecorder.hpp
+ * @brief Host stand-in for the IR transmitter that records the emitted pulse timeline.
+ *
+ * When attached to an IRsender, frames are played into this recorder instead of
+ * the LEDC/timer hardware, so the exact mark/space sequence can be inspected.
+ */
+
+ #ifndef IRPULSERECORDER_HPP
+ #define IRPULSERECORDER_HPP
+
+ #include "IRremoteESP32.hpp"
+
+ /** Maximum number of pulses kept by an IRpulseRecorder. */
+ #define IR_RECORDER_CAPACITY 512
+
+ /**
+  * @struct IRrecordedPulse
+  * @brief One entry of a recorded timeline.
+  */
+ struct IRrecordedPulse {
+   uint32_t start;     ///< Offset from the start of the recording (µs).
+   uint16_t duration;  ///< Length of the pulse (µs).
+   bool     mark;      ///< True if the carrier was on.
+ };
+
+ /**
+  * @class IRpulseRecorder
+  * @brief Collects the pulse trains an IRsender would put on air.
+  */
+ class IRpulseRecorder {
+ private:
+   IRrecordedPulse pulses[IR_RECORDER_CAPACITY]; ///< Recorded timeline.
+   uint16_t count;                               ///< Number of recorded pulses.
+   uint32_t clock;                               ///< Running time offset (µs).
+   uint16_t frames;                              ///< Number of recorded frames.
+
+ public:
+   /** @brief Constructs an empty recorder. */
+   IRpulseRecorder() : count(0), clock(0), frames(0) {}
+
+   /** @brief Discards the recorded timeline. */
+   void reset() { count = 0; clock = 0; frames = 0; }
+
+   /**
+    * @brief Appends every pulse of a train to the timeline.
+    * @param train Pulse train as produced by the sender.
+    */
+   void play(const IRpulseTrain &train) {
+     for (uint8_t i = 0; i < train.length; ++i) {
+       if (count < IR_RECORDER_CAPACITY) {
+         pulses[count].start    = clock;
+         pulses[count].duration = train.durations[i];
+         pulses[count].mark     = IRpulseTrain::isMark(i);
+         ++count;
+       }
+       clock += train.durations[i];
+     }
+     ++frames;
+   }
+
+   /** @brief Number of recorded pulses. */
+   uint16_t size() const { return count; }
+
+   /** @brief Number of recorded frames. */
+   uint16_t frameCount() const { return frames; }
+
+   /** @brief Total recorded airtime in microseconds. */
+   uint32_t elapsed() const { return clock; }
+
+   /** @brief Access a recorded pulse by index. */
+   const IRrecordedPulse &operator[](uint16_t index) const { return pulses[index]; }
+ };
+
+ #endif // IRPULSERECORDER_HPP
@@ -1,9 +1,10 @@
 /**
  * @file IRreceiver.hpp
- * @brief IR NEC protocol receiver for ESP32 using PushButton interrupts and PacketBuffer.
+ * @brief IR NEC/tag protocol receiver for ESP32 using PushButton interrupts and PacketBuffer.
  *
- * Implements a state machine to decode incoming NEC IR signals, validate data,
- * and enqueue complete frames into a PacketBuffer for later retrieval.
+ * The GPIO interrupt only timestamps edges into a lock-free RingBuffer. The
+ * protocol state machines run later, outside the ISR, draining the edges in
+ * batches, validating data and enqueuing complete frames into a PacketBuffer.
  */
 
  #ifndef IRRECEIVER_HPP
@@ -12,21 +13,30 @@
  #include "IRremoteESP32.hpp"
  #include "Components/Pushbutton/PushButton.hpp"
  #include "Utilities/PacketBuffer.hpp"
+ #include "Utilities/RingBuffer.hpp"
  
  /**
   * @class IRreceiver
-  * @brief Decodes NEC IR commands via GPIO interrupts and buffers results.
+  * @brief Decodes NEC and tag IR frames via GPIO interrupts and buffers results.
+  *
+  * Each pulse is fed to every enabled protocol decoder. Decoded frames are
+  * stored as raw bits in NEC_DATA; tag frames can be read back via TAG_DATA.
+  * Call captureEdge() from the pin ISR and decodeNEC() from the main loop.
+  * Recorded edge streams can be replayed through feedEdge().
   */
  class IRreceiver {
  private:
    int recvPin;                       ///< GPIO pin connected to IR receiver.
    Pushbutton isr;                    ///< Debounced ISR handler for signal edges.
-   volatile uint32_t dataRead;       ///< Accumulated raw bits.
-   volatile uint32_t lastTime;       ///< Timestamp of last edge.
-   volatile NEC_STAGE nec_stage;     ///< Current NEC decoding stage.
-   volatile int bitCount;            ///< Number of bits received so far.
+   RingBuffer<uint32_t, IR_EDGE_BUFFER_SIZE> edges; ///< Edge timestamps written by the ISR.
+   IRdecoder<NECProtocol> nec;       ///< NEC pulse state machine.
+   IRdecoder<TagProtocol> tag;       ///< Tag pulse state machine.
+   uint8_t protocols;                ///< Enabled protocols (irProtocolMask bits).
+   uint32_t lastTime;                ///< Timestamp of last edge.
    bool validateData;                ///< True to enforce address/command inverse checks.
    PacketBuffer<NEC_DATA> buffer;    ///< FIFO buffer of decoded frames.
+   volatile uint32_t overflows;      ///< Edges dropped by the ISR (ring full).
+   uint32_t dropped;                 ///< Frames dropped (frame buffer full).
  
  public:
    /**
@@ -39,12 +49,12 @@
    IRreceiver(int pin, ISRpointer isrPointer, bool validate = false)
      : recvPin(pin)
      , isr(pin, NEC_BOUNCE_STOP_FILTER, true, isrPointer)
-     , dataRead(0)
+     , protocols(irProtocolMask(IR_PROTOCOL_NEC))
      , lastTime(0)
-     , nec_stage(headerMark)
-     , bitCount(0)
      , validateData(validate)
      , buffer(IR_RECEIVER_BUFFER_SIZE)
+     , overflows(0)
+     , dropped(0)
    {}
  
    /** @brief Destructor clears pending buffer. */
@@ -54,12 +64,53 @@
     * @brief Initializes the receiver pin and ISR; call this in setup().
     */
    void init() {
+     edges.clear();
      lastTime = micros();
-     nec_stage = headerMark;
+     nec.reset();
+     tag.reset();
      pinMode(recvPin, INPUT);
      isr.init(true, true);
    }
  
+   /**
+    * @brief Selects which protocols are decoded.
+    * @param mask OR of irProtocolMask() values.
+    */
+   void setProtocols(uint8_t mask) {
+     protocols = mask;
+     nec.reset();
+     tag.reset();
+   }
+ 
+   /**
+    * @brief Running timing calibration of a protocol decoder.
+    * @param id Protocol to query.
+    * @return Scale in Q8 (IR_SCALE_ONE = nominal timing).
+    */
+   uint16_t getCalibration(IRprotocolID id) const {
+     return id == IR_PROTOCOL_TAG ? tag.getCalibration() : nec.getCalibration();
+   }
+
+   /**
+    * @brief Decode-quality counters of all protocols on this receiver.
+    * @return Snapshot of the summed counters.
+    */
+   IRdecodeStats getStats() const {
+     IRdecodeStats total = nec.getStats();
+     total += tag.getStats();
+     total.dropped   = dropped;
+     total.overflows = overflows;
+     return total;
+   }
+
+   /** @brief Zeroes the decode-quality counters. */
+   void clearStats() {
+     nec.clearStats();
+     tag.clearStats();
+     dropped = 0;
+     overflows = 0;
+   }
+
    /** @brief Number of decoded frames available. */
    int available() const { return buffer.size(); }
  
@@ -84,70 +135,50 @@
    /** @brief To be called from ISR: handles edge detection. */
    void handleInterrupt() { isr.handleInterrupt(); }
  
+   /**
+    * @brief ISR body: timestamps the edge and returns.
+    *
+    * If the edge ring is full the edge is dropped and counted; the decoder
+    * resynchronizes on the next header.
+    */
+   void IRAM_ATTR captureEdge() {
+     if (!edges.push(micros())) overflows = overflows + 1;
+   }
+ 
+   /** @brief Number of captured edges not yet decoded. */
+   size_t pendingEdges() const { return edges.size(); }
+ 
    /**
     * @brief Main decode routine; call repeatedly (e.g., in loop()).
     *
-    * Processes timing intervals to reconstruct bits, validates NEC checksum,
-    * and enqueues frames into the buffer when complete.
+    * Drains all edges captured since the last call and runs them through the
+    * enabled protocol state machines, enqueuing completed frames into the buffer.
     */
    void decodeNEC() {
-     if (buffer.isFull()) return;
-     uint32_t now = micros();
-     uint32_t duration = now - lastTime;
-     lastTime = now;
- 
-     if (duration < NEC_BOUNCE_STOP_FILTER) return;
- 
-     switch (nec_stage) {
-       case headerMark:
-         if (compare(duration, NEC_HEADER_MARK, NEC_THRESHOLD)) {
-           nec_stage = headerSpace;
-           bitCount = 0;
-           dataRead = 0;
-         }
-         break;
- 
-       case headerSpace:
-         if (compare(duration, NEC_HEADER_SPACE, NEC_THRESHOLD)) {
-           nec_stage = bitMark;
-         } else {
-           nec_stage = headerMark;
-         }
-         break;
- 
-       case bitMark:
-         if (compare(duration, NEC_BIT_MARK, NEC_THRESHOLD)) {
-           nec_stage = bitSpace;
-         } else {
-           nec_stage = headerMark;
-         }
-         break;
- 
-       case bitSpace:
-         if (compare(duration, NEC_ONE_SPACE, NEC_THRESHOLD)) {
-           dataRead = (dataRead << 1) | 1;
-           bitCount++;
-         } else if (compare(duration, NEC_ZERO_SPACE, NEC_THRESHOLD)) {
-           dataRead = (dataRead << 1);
-           bitCount++;
-         } else {
-           nec_stage = headerMark;
-         }
- 
-         if (bitCount == NEC_BITS) {
-           bool valid = true;
-           if (validateData) {
-             valid = (((dataRead >> 24) & 0xFF) ^ 0xFF) == ((dataRead >> 16) & 0xFF)
-                   && (((dataRead >> 8) & 0xFF) ^ 0xFF) == (dataRead & 0xFF);
-           }
-           if (valid) {
-             buffer.enqueue(NEC_DATA(dataRead));
-           }
-           nec_stage = headerMark;
-         } else {
-           nec_stage = bitMark;
-         }
-         break;
+     uint32_t timestamp;
+     while (edges.pop(timestamp)) {
+       feedEdge(timestamp);
+     }
+   }
+ 
+   /**
+    * @brief Processes one edge timestamp.
+    *
+    * Converts the timestamp into the pulse duration since the previous edge,
+    * feeds it to the enabled decoders, and enqueues complete (validated) frames.
+    * Tag frames are always CRC-checked; NEC frames only if validation is on.
+    *
+    * @param timestamp Edge time in microseconds (micros() clock).
+    */
+   void feedEdge(uint32_t timestamp) {
+     uint32_t duration = timestamp - lastTime;
+     lastTime = timestamp;
+ 
+     if ((protocols & irProtocolMask(IR_PROTOCOL_NEC)) && nec.feed(duration, validateData)) {
+       if (!buffer.enqueue(NEC_DATA(nec.frame()))) ++dropped;
+     }
+     if ((protocols & irProtocolMask(IR_PROTOCOL_TAG)) && tag.feed(duration, true)) {
+       if (!buffer.enqueue(NEC_DATA(tag.frame()))) ++dropped;
      }
    }
  };
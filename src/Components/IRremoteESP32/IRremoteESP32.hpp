@@ -3,7 +3,8 @@
  * @brief Core definitions and utilities for ESP32-based NEC IR remote control.
  *
  * Provides NEC protocol timing constants, comparison helper, and data structures
- * for packing and unpacking NEC command frames. Includes sender and receiver headers.
+ * for packing and unpacking NEC command frames. Includes the protocol descriptors,
+ * sender and receiver headers.
  */
 
  #ifndef IRREMOTEESP32_HPP
@@ -26,16 +27,47 @@
  /** NEC protocol "0" space duration (microseconds). */
  #define NEC_ZERO_SPACE 562UL
  
- /** Timing tolerance for pulse comparison (microseconds). */
+ /** Timing tolerance for pulse comparison (microseconds); overridable for channel simulations. */
+ #ifndef NEC_THRESHOLD
  #define NEC_THRESHOLD 100UL
- /** Minimum gap between signals to avoid bounce (microseconds). */
+ #endif
+ /** Minimum gap between signals to avoid bounce (microseconds); overridable for channel simulations. */
+ #ifndef NEC_BOUNCE_STOP_FILTER
  #define NEC_BOUNCE_STOP_FILTER (NEC_THRESHOLD * 2UL)
+ #endif
  
  /** Time window (milliseconds) within which repeats are considered valid. */
  #define NEC_VALID_TIME_MS 70
  
  /** Size of the circular buffer for received IR data frames. */
  #define IR_RECEIVER_BUFFER_SIZE 32
+ /** Slots in the per-receiver edge timestamp ring (power of two, ~2 NEC frames). */
+ #define IR_EDGE_BUFFER_SIZE 256
+
+ /** Largest bit count of any supported protocol frame. */
+ #define IR_MAX_BITS 32
+ /** Maximum number of mark/space entries in a precomputed pulse train. */
+ #define IR_MAX_PULSES (2 * IR_MAX_BITS + 4)
+ /** Idle time appended after each frame so queued frames stay separable (microseconds). */
+ #define IR_SENDER_FRAME_GAP 5000UL
+ /** Frame slots in the transmit queue (power of two; one slot stays free). */
+ #define IR_SENDER_QUEUE_SIZE 4
+ /** Hardware timer prescaler giving 1 µs ticks from the 80 MHz APB clock. */
+ #define IR_SENDER_TIMER_DIVIDER 80
+
+ /** Fixed-point unit of the receiver timing scale (Q8, 256 = nominal timing). */
+ #define IR_SCALE_ONE 256
+ /** Smallest timing scale a header mark may imply (Q8, 0.75x). */
+ #define IR_SCALE_MIN 192
+ /** Largest timing scale a header mark may imply (Q8, 1.25x). */
+ #define IR_SCALE_MAX 320
+ /** Running calibration moves 1/2^N of the way towards each good frame. */
+ #define IR_SCALE_SMOOTHING 3
+ /** A header mark may deviate this much from the running calibration (Q8, 0.25x). */
+ #define IR_SCALE_WINDOW 64
+
+ /** Bins of the pulse-width error histogram; each covers 1/N of the tolerance. */
+ #define IR_ERROR_BINS 8
  
  /**
   * @brief Compare a measured duration to an expected value within a tolerance.
@@ -50,7 +82,7 @@
  }
  
  /**
-  * @brief Stages of the NEC receive state machine.
+  * @brief Stages of the IR receive state machine (shared by all protocols).
   */
  enum NEC_STAGE {
    headerMark,  /**< Waiting for the header mark pulse. */
@@ -83,6 +115,85 @@
    bool operator!=(const NEC_DATA &other) const { return data != other.data; }
  };
  
+ /**
+  * @brief Precomputed mark/space timeline of a single IR frame.
+  *
+  * Entries alternate between mark (even index) and space (odd index), starting
+  * with a mark. Built once per code so transmission only walks the array.
+  */
+ struct IRpulseTrain {
+   uint16_t durations[IR_MAX_PULSES]; /**< Pulse durations in microseconds. */
+   uint8_t  length;                   /**< Number of valid entries. */
+
+   /** Default constructor creates an empty train. */
+   IRpulseTrain() : length(0) {}
+
+   /** Removes all entries. */
+   void clear() { length = 0; }
+
+   /**
+    * @brief Appends a pulse to the train.
+    * @param time Duration in microseconds.
+    * @return False if the train is already full.
+    */
+   bool add(uint32_t time) {
+     if (length >= IR_MAX_PULSES) return false;
+     durations[length++] = static_cast<uint16_t>(time);
+     return true;
+   }
+
+   /** @brief True if the entry at index is a mark (carrier on). */
+   static bool isMark(uint8_t index) { return (index & 1) == 0; }
+
+   /** @brief Total airtime of the train in microseconds. */
+   uint32_t totalTime() const {
+     uint32_t total = 0;
+     for (uint8_t i = 0; i < length; ++i) total += durations[i];
+     return total;
+   }
+ };
+
+ /**
+  * @brief Decode-quality counters of one or more receivers.
+  *
+  * Only plain increments are done per edge, so collection can stay enabled.
+  * All fields are 32-bit, so the struct can be sent as a packet payload as is.
+  */
+ struct IRdecodeStats {
+   uint32_t started;                    /**< Headers accepted. */
+   uint32_t completed;                  /**< Frames decoded and accepted. */
+   uint32_t failed[4];                  /**< Rejected pulses by NEC_STAGE (headerMark: non-header pulses while idle). */
+   uint32_t invalid;                    /**< Frames that failed Protocol::validate(). */
+   uint32_t dropped;                    /**< Frames lost because the frame buffer was full. */
+   uint32_t overflows;                  /**< Edges lost because the edge ring was full. */
+   uint32_t errorHistogram[IR_ERROR_BINS]; /**< Matched pulses by |error| / (tolerance / IR_ERROR_BINS). */
+
+   /** Default constructor zeroes all counters. */
+   IRdecodeStats() { clear(); }
+
+   /** Zeroes all counters. */
+   void clear() { memset(this, 0, sizeof(*this)); }
+
+   /** Adds another set of counters to this one. */
+   IRdecodeStats &operator+=(const IRdecodeStats &other) {
+     const uint32_t *src = reinterpret_cast<const uint32_t *>(&other);
+     uint32_t *dst = reinterpret_cast<uint32_t *>(this);
+     for (size_t i = 0; i < sizeof(*this) / sizeof(uint32_t); ++i) dst[i] += src[i];
+     return *this;
+   }
+ };
+
+ /**
+  * @brief Decode counters of all receivers of a target plus its hit fusion counters.
+  */
+ struct IRhitStats {
+   IRdecodeStats decode; /**< Sum over all receivers. */
+   uint32_t duplicates;  /**< Frames merged into an already accepted hit. */
+   uint32_t hitDrops;    /**< Hits lost because the hit queue was full. */
+ };
+
+ #include "IRprotocol.hpp"
+ #include "IRpulseRecorder.hpp"
  #include "IRsender.hpp"
  #include "IRreceiver.hpp"
  
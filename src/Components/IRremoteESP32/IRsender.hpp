@@ -2,18 +2,25 @@
  * @file IRsender.hpp
  * @brief IR transmitter class for sending NEC protocol frames via ESP32 LEDC.
  *
- * Encapsulates pulse generation (mark/space) and provides methods to send
- * NEC commands by bit-banging the carrier on a chosen LEDC channel.
+ * Frames are encoded by IRencoder for the chosen protocol descriptor into
+ * an IRpulseTrain and then played back from a hardware timer interrupt,
+ * so sending never blocks the caller.
+ * An IRpulseRecorder can be attached to capture the timeline instead of
+ * driving the hardware.
  */
 
  #ifndef IRSENDER_HPP
  #define IRSENDER_HPP
- 
+
  #include "IRremoteESP32.hpp"
- 
+ #include "Utilities/RingBuffer.hpp"
+
  /**
   * @class IRsender
-  * @brief Sends NEC IR codes using ESP32 LEDC peripheral.
+  * @brief Sends NEC IR codes using ESP32 LEDC peripheral and a hardware timer.
+  *
+  * Only one IRsender may be active at a time, since the timer ISR dispatches
+  * to a single instance.
   */
  class IRsender {
  public:
@@ -25,7 +32,9 @@
    int freq;
    /** @brief Invert PWM logic if true. */
    bool invert;
- 
+   /** @brief Hardware timer (0-3) used to time the pulses. */
+   uint8_t timerNum;
+
    /**
     * @brief Constructs an IRsender instance.
     *
@@ -33,50 +42,75 @@
     * @param channel     LEDC channel (0-15).
     * @param frequency   PWM frequency in Hz.
     * @param invertSignal True to invert PWM output.
+    * @param timerNumber Hardware timer used for pulse timing.
     */
-   IRsender(int pin, int channel, int frequency, bool invertSignal = false)
-     : ledPin(pin), channel(channel), freq(frequency), invert(invertSignal) {}
- 
+   IRsender(int pin, int channel, int frequency, bool invertSignal = false, uint8_t timerNumber = 0)
+     : ledPin(pin), channel(channel), freq(frequency), invert(invertSignal), timerNum(timerNumber),
+       timer(nullptr), recorder(nullptr), pulseIndex(0), busy(false) {}
+
    /**
-    * @brief Initializes the LEDC peripheral and sets output pin mode.
+    * @brief Initializes the LEDC peripheral, output pin and pulse timer.
     */
    void init() {
      pinMode(ledPin, OUTPUT);
      ledcSetup(channel, freq, 10);    // 10-bit resolution
      ledcAttachPin(ledPin, channel);
-     space(0);                        // Ensure output is idle
+     writeSpace();                    // Ensure output is idle
+
+     activeSender() = this;
+     timer = timerBegin(timerNum, IR_SENDER_TIMER_DIVIDER, true);
+     timerAttachInterrupt(timer, onTimer, true);
    }
- 
+
    /**
-    * @brief Sends an NEC frame (header + 32 bits).
+    * @brief Routes frames into a recorder instead of the hardware.
+    * @param target Recorder to fill, or nullptr to transmit on air again.
+    */
+   void attachRecorder(IRpulseRecorder *target) { recorder = target; }
+
+   /**
+    * @brief Queues a frame and returns immediately.
+    *
+    * @tparam Protocol Descriptor used for encoding (e.g. NECProtocol).
+    * @param data  Frame bits.
+    * @param nbits Number of bits to send.
+    * @return False if the frame was dropped because the queue is full.
+    */
+   template <typename Protocol>
+   bool send(uint32_t data, uint8_t nbits = Protocol::bits) {
+     IRencoder<Protocol>::encode(data, frame, nbits);
+     if (recorder) {
+       recorder->play(frame);
+       return true;
+     }
+
+     portENTER_CRITICAL(&mux);
+     bool queued = queue.push(frame);
+     if (queued && !busy) {
+       queue.pop(active);
+       startFrame();
+     }
+     portEXIT_CRITICAL(&mux);
+     return queued;
+   }
+
+   /**
+    * @brief Queues an NEC frame (header + 32 bits) and returns immediately.
     *
     * @param data Raw 32-bit NEC frame.
     * @param nbits Number of bits to send (default 32).
+    * @return False if the frame was dropped because the queue is full.
     */
-   void sendNEC(uint32_t data, uint8_t nbits = NEC_BITS) {
-     // Header
-     mark(NEC_HEADER_MARK);
-     space(NEC_HEADER_SPACE);
-     // Data bits
-     for (uint32_t mask = 1UL << (nbits - 1); mask; mask >>= 1) {
-       mark(NEC_BIT_MARK);
-       if (data & mask) {
-         space(NEC_ONE_SPACE);
-       } else {
-         space(NEC_ZERO_SPACE);
-       }
-     }
-     // Final bit mark and space
-     mark(NEC_BIT_MARK);
-     space(0);
+   bool sendNEC(uint32_t data, uint8_t nbits = NEC_BITS) {
+     return send<NECProtocol>(data, nbits);
    }
- 
+
    /**
     * @brief Sends an NEC frame from a NEC_DATA struct.
     * @param data NEC_DATA union.
     */
-   void sendNEC(NEC_DATA data) { sendNEC(data.data); }
- 
+   bool sendNEC(NEC_DATA data) { return sendNEC(data.data); }
+
    /**
     * @brief Sends an NEC frame given address and command bytes.
     *
@@ -84,33 +118,97 @@
     * @param address Address byte.
     * @param command Command byte.
     */
-   void sendNEC(uint8_t address, uint8_t command) {
+   bool sendNEC(uint8_t address, uint8_t command) {
      NEC_DATA d(address, command);
-     sendNEC(d);
+     return sendNEC(d);
    }
- 
+
+   /** @brief True while a frame is on air or queued. */
+   bool isBusy() const { return busy; }
+
+   /** @brief Read-only access to the pulse train of the last frame sent. */
+   const IRpulseTrain &pulseTrain() const { return frame; }
+
  protected:
+   hw_timer_t      *timer;      ///< Pulse timer handle.
+   IRpulseRecorder *recorder;   ///< Optional host stand-in for the hardware.
+   IRpulseTrain     frame;      ///< Pulse train of the last frame sent.
+
+   RingBuffer<IRpulseTrain, IR_SENDER_QUEUE_SIZE> queue; ///< Frames waiting for the timer.
+   IRpulseTrain     active;     ///< Frame currently on air.
+   volatile uint8_t pulseIndex; ///< Entry of the active train currently on air.
+   volatile bool    busy;       ///< True while the timer is playing a frame.
+   portMUX_TYPE     mux = portMUX_INITIALIZER_UNLOCKED; ///< Guards busy and the queue between task and ISR.
+
+   /** @brief Instance served by the timer ISR. */
+   static IRsender *&activeSender() {
+     static IRsender *sender = nullptr;
+     return sender;
+   }
+
+   /** @brief Timer ISR trampoline. */
+   static void IRAM_ATTR onTimer() {
+     IRsender *sender = activeSender();
+     if (sender) sender->nextPulse();
+   }
+
+   /**
+    * @brief Outputs the first pulse of the active train and arms the timer.
+    * Caller must hold the mux.
+    */
+   void IRAM_ATTR startFrame() {
+     busy = true;
+     pulseIndex = 0;
+     writeMark();
+     armTimer(active.durations[0]);
+   }
+
+   /**
+    * @brief Advances to the next pulse; called from the timer ISR.
+    */
+   void IRAM_ATTR nextPulse() {
+     portENTER_CRITICAL_ISR(&mux);
+     uint8_t index = pulseIndex + 1;
+     if (index < active.length) {
+       pulseIndex = index;
+       if (IRpulseTrain::isMark(index)) writeMark(); else writeSpace();
+       armTimer(active.durations[index]);
+     } else if (queue.pop(active)) {
+       startFrame();
+     } else {
+       writeSpace();
+       busy = false;
+     }
+     portEXIT_CRITICAL_ISR(&mux);
+   }
+
    /**
-    * @brief Generates a carrier (mark) for the specified time.
-    * @param time Microseconds to enable PWM output.
+    * @brief Schedules the next timer interrupt.
+    * @param time Microseconds until the interrupt fires.
     */
-   void mark(int time) {
+   void IRAM_ATTR armTimer(uint32_t time) {
+     timerWrite(timer, 0);
+     timerAlarmWrite(timer, time, false);
+     timerAlarmEnable(timer);
+   }
+
+   /**
+    * @brief Enables the carrier (mark).
+    */
+   void IRAM_ATTR writeMark() {
      ledcWrite(channel, 512); // 50% duty
-     delayMicroseconds(time);
    }
- 
+
    /**
-    * @brief Generates a space (no carrier) for the specified time.
-    * @param time Microseconds to disable or invert PWM output.
+    * @brief Disables or inverts the carrier (space).
     */
-   void space(int time) {
+   void IRAM_ATTR writeSpace() {
      if (invert) {
        ledcWrite(channel, 1023); // Inverted logic high
      } else {
        ledcWrite(channel, 0);    // PWM off
      }
-     delayMicroseconds(time);
    }
  };
- 
- #endif // IRSENDER_HPP 
\ No newline at end of file
+
+ #endif // IRSENDER_HPP
@@ -106,6 +106,7 @@
      HyperList<NexusAddress> scanResults;
      PacketBuffer<NexusPacket> incomingBuffer(NEXUS_BUFFER_SIZE);
      HyperList<NexusPacket> outgoingPackets;
+     static uint32_t joinedProjects[256 / 32] = {}; // Bit per extra project ID
  
      void setAddress(uint8_t projectID, uint8_t groups, uint8_t deviceID) {
          THIS_ADDRESS = NexusAddress(projectID, groups, deviceID);
@@ -127,6 +128,23 @@
          THIS_ADDRESS.groups &= ~calcGroupMask(groupID);
      }
  
+     void setProjectID(uint8_t projectID) {
+         THIS_ADDRESS.projectID = projectID;
+     }
+
+     void joinProject(uint8_t projectID) {
+         joinedProjects[projectID >> 5] |= 1UL << (projectID & 31);
+     }
+
+     void leaveProject(uint8_t projectID) {
+         joinedProjects[projectID >> 5] &= ~(1UL << (projectID & 31));
+     }
+
+     bool inProject(uint8_t projectID) {
+         return projectID == THIS_ADDRESS.projectID
+             || (joinedProjects[projectID >> 5] >> (projectID & 31)) & 1;
+     }
+
      uint16_t randomSequenceNum() {
          return static_cast<uint16_t>(random(0, 65535));
      }
@@ -162,6 +180,12 @@
          return sendPacket(packet);
      }
  
+     bool queueData(uint16_t command, uint8_t length, uint8_t data[], const NexusAddress &destination) {
+         if (outgoingPackets.size() >= NEXUS_OUTGOING_LIMIT) return false;
+         outgoingPackets.addend(NexusPacket(THIS_ADDRESS, destination, randomSequenceNum(), command, length, data));
+         return true;
+     }
+ 
      bool sendToDevice(uint16_t command, uint8_t length, uint8_t data[], uint8_t deviceID) {
          return sendData(command, length, data, NexusAddress(getProjectID(), 255, deviceID));
      }
@@ -184,8 +208,8 @@
  
      void loop() {
          uint32_t now = millis();
-         // Send queued outbound packets
-         while (outgoingPackets.size() > 0) {
+         // Send queued outbound packets, a few per loop
+         for (int sent = 0; sent < NEXUS_SENDS_PER_LOOP && outgoingPackets.size() > 0; ++sent) {
              auto pkt = outgoingPackets[0];
              sendPacket(pkt);
              outgoingPackets.remove(0);
@@ -208,10 +232,10 @@
                          if (onDeviceConnected) onDeviceConnected(dev);
                      }
                  }
-                 // Handle disconnections
+                 // Handle disconnections (a scan only covers the current project)
                  for (size_t i = 0; i < devices.size(); ++i) {
                      auto dev = devices[i];
-                     if (!scanResults.contains(dev)) {
+                     if (dev.projectID == getProjectID() && !scanResults.contains(dev)) {
                          devices.remove(i);
                          --i;
                          if (onDeviceDisconnected) onDeviceDisconnected(dev);
@@ -234,7 +258,7 @@
      int randomNum = millis() % 5;
      if (packet.version != NEXUS_VERSION) return;
  
-     bool toThis = (packet.destination.projectID == Nexus::THIS_ADDRESS.projectID)
+     bool toThis = Nexus::inProject(packet.destination.projectID)
                  && (packet.destination.groups & Nexus::THIS_ADDRESS.groups)
                  && (packet.destination.deviceID == Nexus::THIS_ADDRESS.deviceID || packet.destination.deviceID == 255);
      if (!toThis) return;
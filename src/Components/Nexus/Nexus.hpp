@@ -22,6 +22,10 @@
  #define NEXUS_SCAN_RESPONSE_REPEAT 2
  /** Capacity of the incoming packet buffer. */
  #define NEXUS_BUFFER_SIZE 64
+ /** Queued packets sent per loop(); spreads a fan-out over several loops. */
+ #define NEXUS_SENDS_PER_LOOP 4
+ /** Maximum number of queued outbound packets. */
+ #define NEXUS_OUTGOING_LIMIT 128
  /** Header length (bytes) for a NexusPacket. */
  #define NEXUS_HEADER_SIZE 12
  /** Maximum payload size (bytes) for a NexusPacket. */
@@ -166,6 +170,14 @@
      void joinGroup(uint8_t groupID);
      /** Leave a group by clearing its bit. */
      void leaveGroup(uint8_t groupID);
+     /** Change the project ID used as source and for scans, keeping groups and device ID. */
+     void setProjectID(uint8_t projectID);
+     /** Also accept packets addressed to another project (e.g. one Manager hosting several arenas). */
+     void joinProject(uint8_t projectID);
+     /** Stop accepting packets of a project joined with joinProject(). */
+     void leaveProject(uint8_t projectID);
+     /** True if packets to @p projectID are accepted: the own project or a joined one. */
+     bool inProject(uint8_t projectID);
      /** Generate a random sequence number for packets. */
      uint16_t randomSequenceNum();
      /**
@@ -186,6 +198,14 @@
       * @brief Helper to build and send a packet with raw data.
       */
      bool sendData(uint16_t command, uint8_t length, uint8_t data[], const NexusAddress &destination);
+     /**
+      * @brief Like sendData(), but queued: loop() sends NEXUS_SENDS_PER_LOOP packets per call, in order.
+      *
+      * For fan-outs to many devices, which would otherwise fill the ESP-NOW
+      * send queue back to back.
+      * @return False if NEXUS_OUTGOING_LIMIT packets are already waiting.
+      */
+     bool queueData(uint16_t command, uint8_t length, uint8_t data[], const NexusAddress &destination);
      /** Send a command to a specific device ID. */
      bool sendToDevice(uint16_t command, uint8_t length, uint8_t data[], uint8_t deviceID);
      /** Send a command to all devices in a group. */
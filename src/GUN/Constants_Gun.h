@@ -6,6 +6,7 @@
  *  - Trigger pushbutton
  *  - IR transmitter (NEC protocol)
  *  - LED strip used for feedback animations
+ *  - Hit marker shown when a shot is confirmed
  */
 
 #ifndef CONSTANTS_GUN_H
@@ -28,6 +29,8 @@ static const uint8_t irPin = 4;
 static const uint8_t irChannel = 5;
 /// Carrier frequency for NEC protocol (in Hz, typically 38 kHz).
 static const uint32_t irFrequency = 38000;
+/// Hardware timer that clocks the IR pulse train out in the background.
+static const uint8_t irTimer = 0;
 
 //------------------------------------------------------------------------------
 // On-Board LED Strip (NeoPixel) for Visual Feedback
@@ -41,4 +44,10 @@ static const uint8_t stripFrameIntervalMS = 30;
 /// Default brightness level for the strip (0–255).
 static const uint8_t stripBrightness = 30;
 
+//------------------------------------------------------------------------------
+// Hit Marker
+//------------------------------------------------------------------------------
+/// How long a confirmed hit stays marked on the HUD and the strip (in ms).
+static const uint16_t hitMarkerMS = 400;
+
 #endif // CONSTANTS_GUN_H
\ No newline at end of file
@@ -91,6 +91,11 @@
   *  - Sends buffer to the OLED.
   */
  inline void loop() {
+     // Remove a timed-out hit marker, redrawing only while the HUD is shown
+     if (::onGame->hitMarkerExpired()
+         && screen2.getCurrentActivityIndex() == GUI_Gun_Activity::ONGAME) {
+         screen2.callRender();
+     }
      if (screen2.shouldRender()) {
          u8g2.clearBuffer();
          screen2.render();
@@ -112,6 +117,17 @@
      screen2.selectActivity(GUI_Gun_Activity::ONGAME);
  }
  
+ /**
+  * @brief Mark a confirmed hit on the gameplay HUD.
+  *
+  * @param damage Damage the hit dealt.
+  * @param kill   Whether the hit killed.
+  */
+ inline void hitMarker(uint16_t damage, bool kill) {
+     ::onGame->showHitMarker(damage, kill); // The Activity, not GUI::onGame()
+     screen2.callRender();
+ }
+
  /**
   * @brief Display a message using the MessageBox activity.
   * 
@@ -1,6 +1,6 @@
 /**
  * @file OnGame.hpp
- * @brief Primary gameplay Activity showing health bar, ammo count, and reload status.
+ * @brief Primary gameplay Activity showing health bar, ammo count, reload status and hit markers.
  *
  * Inherits from LuminaUI::Activity. Reads Player and Gun state pointers each render.
  */
@@ -10,6 +10,7 @@
  
  #include "GUI_Gun.hpp"         ///< Screen & Activity definitions
  #include "Modules/Player.hpp"  ///< Player model for HP
+ #include "GUN/Constants_Gun.h"  ///< hitMarkerMS
  #include <Arduino.h>           ///< String, map(), etc.
  
  /**
@@ -31,6 +32,12 @@
      String str1;       ///< String for ammo count
      String str2;       ///< String for max ammo
      bool isReloading;  ///< Whether a reload is in progress
+
+     // Hit marker of the last confirmed shot
+     uint32_t markerAt = 0;     ///< millis() when the marker was shown
+     uint16_t markerDamage = 0; ///< Damage of the confirmed hit
+     bool markerKill = false;   ///< Whether the hit killed
+     bool markerShown = false;  ///< Whether the marker is on screen
  
      /**
       * @brief Default constructor.
@@ -84,6 +91,20 @@
          u8g2.setCursor(midX + 6, midY);
          u8g2.println(str2.c_str());
  
+         // ----- Draw hit marker -----
+         // Crosshair corners at the left with the damage (or KO) below
+         markerShown = markerShown && millis() - markerAt < hitMarkerMS;
+         if (markerShown) {
+             u8g2.drawLine(4, 22, 10, 28);
+             u8g2.drawLine(24, 22, 18, 28);
+             u8g2.drawLine(4, 42, 10, 36);
+             u8g2.drawLine(24, 42, 18, 36);
+             u8g2.setFont(u8g2_font_fub11_tf);
+             u8g2.setFontPosCenter();
+             u8g2.setCursor(2, 55);
+             u8g2.println(markerKill ? "KO" : ("-" + String(markerDamage)).c_str());
+         }
+
          // ----- Draw reload message -----
          if (isReloading) {
              u8g2.setFont(u8g2_font_fub11_tf);
@@ -108,6 +129,28 @@
          isReloading = (gun->getStatus() == RELOADING);
      }
  
+     /**
+      * @brief Show a hit marker for hitMarkerMS.
+      * @param damage Damage of the confirmed hit
+      * @param kill   Whether the hit killed
+      */
+     void showHitMarker(uint16_t damage, bool kill) {
+         markerAt = millis();
+         markerDamage = damage;
+         markerKill = kill;
+         markerShown = true;
+     }
+
+     /**
+      * @brief Drop a timed-out hit marker.
+      * @return True once, when the marker timed out and the HUD needs a redraw.
+      */
+     bool hitMarkerExpired() {
+         if (!markerShown || millis() - markerAt < hitMarkerMS) return false;
+         markerShown = false;
+         return true;
+     }
+
      /**
       * @brief Provide pointers to the shared Player and Gun objects.
       * @param playerPtr Pointer to Player model
@@ -6,6 +6,9 @@
  *   and networking via Nexus (ESP-NOW).
  * - Integrates Game, Gun, and Player modules to handle shooting, reloading, and receiving
  *   commands from the Manager.
+ * - Flashes the strip and marks the HUD when a Vest or the Manager confirms a hit.
+ * - Keeps the last loadouts in a cache keyed by content hash, so a game start
+ *   only transfers a loadout the gun has not seen yet.
  * - Delegates on-screen updates to the GUI_Gun subsystem.
  */
 
@@ -22,8 +25,10 @@
 #include "Common/LazerTagPacket.hpp"                  ///< COMMS_* command codes
 
 #include "Modules/Game.hpp"                           ///< Shared GameStatus enum
+#include "Modules/GameFlow.hpp"                       ///< Table-driven status transitions
 #include "Modules/Gun.hpp"                            ///< Gun logic & data
 #include "Modules/Player.hpp"                         ///< Player data model
+#include "Modules/Loadout.hpp"                        ///< Content-addressed loadouts
 
 #include "GUI_Gun/GUI_Gun.hpp"                        ///< On-screen display for gun status
 
@@ -45,6 +50,7 @@ void gun_OnReloadFinish_callback(Gun* gun);
 //-----------------------------------------------------------------------------
 
 bool isDemarked = false; ///< Flag to indicate if the gun is demarked instead of marked
+bool isKillMarker = false; ///< Flag to indicate if the last confirmed hit killed
 
 /**
  * @brief Fire animation for the LED strip.
@@ -111,6 +117,28 @@ void markAnimationFunc(Adafruit_NeoPixel* strip,
     }
 }
 
+/**
+ * @brief Hit marker animation for the LED strip.
+ *
+ * A white flash that fades out, red if the hit killed.
+ *
+ * @param strip       Pointer to the NeoPixel strip instance.
+ * @param startIndex  Starting LED index.
+ * @param length      Number of LEDs.
+ * @param factor      Progress of animation.
+ */
+void hitMarkerAnimationFunc(Adafruit_NeoPixel* strip,
+                            uint16_t startIndex,
+                            uint16_t length,
+                            float factor) {
+    uint8_t value = uint8_t(clamp(1.0f - factor, 0.0f, 1.0f) * 255);
+    uint8_t saturation = isKillMarker ? 255 : 0; // Red for a kill, white otherwise
+    strip->fill(
+        Adafruit_NeoPixel::ColorHSV(0, saturation, value),
+        startIndex, length
+    );
+}
+
 //-----------------------------------------------------------------------------
 // Animation objects
 //-----------------------------------------------------------------------------
@@ -134,6 +162,16 @@ Animation markAnimation(
     false
 );
 
+/// Displayed when a hit of this gun is confirmed
+Animation hitMarkerAnimation(
+    hitMarkerAnimationFunc,
+    3,                  ///< above fire and mark
+    0,
+    stripLength,        ///< full strip length
+    hitMarkerMS,        ///< duration (ms)
+    false
+);
+
 //-----------------------------------------------------------------------------
 // Global device objects
 //-----------------------------------------------------------------------------
@@ -153,7 +191,9 @@ Pushbutton trigger(
 IRsender irSender(
     irPin,       ///< data pin
     irChannel,   ///< PWM channel
-    irFrequency  ///< carrier frequency
+    irFrequency, ///< carrier frequency
+    false,       ///< invert output?
+    irTimer      ///< pulse timer
 );
 
 /// LED strip animator
@@ -170,9 +210,27 @@ Gun gun(
     gun_OnReloadFinish_callback///< on reload complete
 );
 
-/// Current IR code to transmit when shooting
+/// Fire code assigned by the Manager; its address byte is this gun's shooter ID
 uint32_t fireSignal = 0x0000000;
 
+/// IR protocol selected by the Manager for this game
+IRprotocolID irProtocol = GAME_DEFAULT_IR_PROTOCOL;
+
+/// Rolling shot counter carried by every fire code
+uint8_t shotCounter = 0;
+
+/// Shots fired during the current game (reported to the Manager at game over)
+uint32_t shotsFired = 0;
+
+/// Loadouts received so far, by hash
+LoadoutCache loadouts;
+
+/// Hash of the loadout asked from the Manager (0 = none missing)
+uint64_t loadoutWanted = 0;
+
+/// Time of the last loadout request (ms)
+uint32_t loadoutRequested = 0;
+
 /// Flag to request GUI update
 bool callRender = false;
 
@@ -195,13 +253,21 @@ void IRAM_ATTR gun_trigger_interrupt() {
 /**
  * @brief Callback invoked by Gun when a shot fires.
  *
- * Sends IR code, plays fire animation, decrements ammo, and flags GUI redraw.
+ * Queues the IR code (non-blocking), plays fire animation, decrements ammo,
+ * and flags GUI redraw. Every frame carries this gun's shooter ID and the
+ * next value of the rolling shot counter, so each shot has its own code.
+ * A frame the full send queue drops is not a shot: no ammo, no count.
  *
  * @param parameter  Burst index (unused here).
  */
 void gun_Shoot_callback(int /*parameter*/) {
     if (gun.getAmmo() > 0) {
-        irSender.sendNEC(fireSignal);
+        uint32_t code = Game::encodeFireCode(irProtocol, NEC_DATA(fireSignal).address, shotCounter);
+        bool sent = irProtocol == IR_PROTOCOL_TAG ? irSender.send<TagProtocol>(code)
+                                                  : irSender.sendNEC(code);
+        if (!sent) return;
+        shotCounter++;
+        shotsFired++;
         visualizer.addAnimation(fireAnimation);
         gun.decreaseAmmo();
         callRender = true;
@@ -219,6 +285,75 @@ void gun_OnReloadFinish_callback(Gun* /*gunPtr*/) {
     GUI::callRender();
 }
 
+//-----------------------------------------------------------------------------
+// Game flow
+//-----------------------------------------------------------------------------
+
+/// On-screen message for each GameStatus (nullptr: the status shows something else)
+const char* gunStatusMessages[GameStatus_size] = {
+    "Waiting...", "Starting...", "3", "2", "1", "GO!", nullptr, "Game Over!", "You Won!", "You Lost!"
+};
+
+/** @brief Entry action: shows the status message. */
+void gun_showStatus(GameStatus status, int) {
+    GUI::message(gunStatusMessages[status]);
+}
+
+/** @brief Entry action of GAME_GO: shows the message and fills the magazine. */
+void gun_go(GameStatus status, int) {
+    gun_showStatus(status, 0);
+    gun.reload();
+}
+
+/** @brief Entry action of GAME_RUNNING: switches to the in-game screen. */
+void gun_running(GameStatus, int) {
+    GUI::onGame();
+}
+
+/** @brief Entry action of GAME_OVER: shows the message and reports shots so the Manager can compute accuracy. */
+void gun_over(GameStatus status, int) {
+    gun_showStatus(status, 0);
+    Nexus::sendData(
+        COMMS_SHOTCOUNT,
+        payloadSizePerCommand[COMMS_SHOTCOUNT],
+        (uint8_t*)&shotsFired,
+        NexusAddress(NEXUS_PROJECT_ID, NEXUS_GROUP_MANAGER, 0xFF));
+}
+
+/** @brief Takes a loadout into use: weapon parameters and name. */
+void gun_applyLoadout(const Loadout &loadout) {
+    gun.setGunData(loadout.gunData);
+    player.setGunData(loadout.gunData);
+    player.setGunName(loadout.name);
+}
+
+/** @brief Asks the Manager for the loadout named in the last COMMS_GUNSTART. */
+void gun_requestLoadout() {
+    loadoutRequested = millis();
+    Nexus::sendData(
+        COMMS_LOADOUT_REQUEST,
+        payloadSizePerCommand[COMMS_LOADOUT_REQUEST],
+        (uint8_t*)&loadoutWanted,
+        NexusAddress(NEXUS_PROJECT_ID, NEXUS_GROUP_MANAGER, 0xFF));
+}
+
+/// Gun actions per GameStatus: screen per status, transitions come from the Manager
+const GameActions gunActions[GameStatus_size] = {
+    /* GAME_WAITING  */ { gun_showStatus, nullptr },
+    /* GAME_STARTING */ { gun_showStatus, nullptr },
+    /* GAME_THREE    */ { gun_showStatus, nullptr },
+    /* GAME_TWO      */ { gun_showStatus, nullptr },
+    /* GAME_ONE      */ { gun_showStatus, nullptr },
+    /* GAME_GO       */ { gun_go,         nullptr },
+    /* GAME_RUNNING  */ { gun_running,    nullptr },
+    /* GAME_OVER     */ { gun_over,       nullptr },
+    /* GAME_WON      */ { gun_showStatus, nullptr },
+    /* GAME_LOST     */ { gun_showStatus, nullptr }
+};
+
+/// Drives gameStatus through gameStates with gunActions
+GameFlow gunFlow(gunActions, gameStatus);
+
 //-----------------------------------------------------------------------------
 // Arduino setup()
 //-----------------------------------------------------------------------------
@@ -261,7 +396,7 @@ void gun_setup() {
  * - Updates gun logic (reload timers).
  * - Updates LED animations.
  * - Updates GUI state.
- * - Handles auto-reload and manual shooting when game is running.
+ * - Handles auto-reload and manual shooting when game is running and its loadout arrived.
  * - Renders GUI if flagged.
  */
 void gun_loop() {
@@ -280,8 +415,8 @@ void gun_loop() {
     // GUI logic
     GUI::loop();
 
-    // If game is active, manage reload and trigger input
-    if (gameStatus == GAME_RUNNING) {
+    // If game is active, manage reload and trigger input; hold fire until the game's loadout arrived
+    if (gameStatus == GAME_RUNNING && !loadoutWanted) {
         // Auto-reload
         if (gun.getAmmo() == 0 && gun.reload()) {
             callRender = true;
@@ -292,11 +427,16 @@ void gun_loop() {
         }
     }
 
+    // Ask again for a missing loadout if the answer got lost
+    if (loadoutWanted && millis() - loadoutRequested >= LOADOUT_RETRY_MS) {
+        gun_requestLoadout();
+    }
+
     // Process incoming Nexus packets
     NexusPacket packet;
     int newHP;
     GunData newParams;
-    GameStatus prevStatus;
+    GameStatus nextStatus;
     while (Nexus::readPacket(packet)) {
         switch (packet.command) {
             case COMMS_PLAYERHP:
@@ -317,50 +457,73 @@ void gun_loop() {
                 memcpy(&fireSignal,
                        packet.payload,
                        payloadSizePerCommand[COMMS_FIRECODE]);
+                // New game: count shots from zero
+                shotCounter = 0;
+                shotsFired = 0;
                 break;
 
+            case COMMS_IRPROTOCOL:
+                memcpy(&irProtocol,
+                       packet.payload,
+                       payloadSizePerCommand[COMMS_IRPROTOCOL]);
+                break;
+
+            case COMMS_GUNSTART: {
+                // HP, IR protocol and fire code of the new game; the loadout by hash
+                GunStart start;
+                memcpy(&start,
+                       packet.payload,
+                       payloadSizePerCommand[COMMS_GUNSTART]);
+                player.setHP(start.hp);
+                irProtocol = IRprotocolID(start.irProtocol);
+                fireSignal = start.fireCode;
+                shotCounter = 0;
+                shotsFired = 0;
+                Loadout loadout;
+                if (loadouts.find(start.loadout, loadout)) {
+                    gun_applyLoadout(loadout);
+                    loadoutWanted = 0;
+                } else {
+                    loadoutWanted = start.loadout;
+                    gun_requestLoadout();
+                }
+                break;
+            }
+
+            case COMMS_LOADOUT: {
+                // Keep only the blob we asked for, checked against its hash;
+                // a late answer to a retry is dropped
+                Loadout loadout;
+                memcpy(&loadout,
+                       packet.payload,
+                       payloadSizePerCommand[COMMS_LOADOUT]);
+                if (loadoutWanted != 0 && loadoutHash(loadout) == loadoutWanted) {
+                    loadouts.store(loadoutWanted, loadout);
+                    gun_applyLoadout(loadout);
+                    loadoutWanted = 0;
+                }
+                break;
+            }
+
             case COMMS_GAMESTATUS:
-                prevStatus = gameStatus;
-                memcpy(&gameStatus,
+                // On status change, run the entry action of the new status
+                memcpy(&nextStatus,
                        packet.payload,
                        payloadSizePerCommand[COMMS_GAMESTATUS]);
-                if (prevStatus != gameStatus) {
-                    // Update on-screen message & trigger actions
-                    switch (gameStatus) {
-                        case GAME_WAITING:
-                            GUI::message("Waiting...");
-                            break;
-                        case GAME_STARTING:
-                            GUI::message("Starting...");
-                            break;
-                        case GAME_THREE:
-                            GUI::message("3");
-                            break;
-                        case GAME_TWO:
-                            GUI::message("2");
-                            break;
-                        case GAME_ONE:
-                            GUI::message("1");
-                            break;
-                        case GAME_GO:
-                            GUI::message("GO!");
-                            gun.reload();
-                            break;
-                        case GAME_RUNNING:
-                            GUI::onGame();
-                            break;
-                        case GAME_OVER:
-                            GUI::message("Game Over!");
-                            break;
-                        case GAME_WON:
-                            GUI::message("You Won!");
-                            break;
-                        case GAME_LOST:
-                            GUI::message("You Lost!");
-                            break;
-                    }
-                }
+                gunFlow.enter(nextStatus);
+                break;
+
+            case COMMS_HITMARKER: {
+                // A shot of this gun hit: flash the strip and mark the HUD
+                HitMarker marker;
+                memcpy(&marker,
+                       packet.payload,
+                       payloadSizePerCommand[COMMS_HITMARKER]);
+                isKillMarker = marker.kill;
+                visualizer.addAnimation(hitMarkerAnimation);
+                GUI::hitMarker(marker.damage, marker.kill);
                 break;
+            }
 
             case COMMS_MARK:
                 // Play mark animation
@@ -3,8 +3,8 @@
  * @brief “Activation” screen Activity for the Manager GUI.
  *
  * This Activity displays the project title, a prompt to start, and author credit.
- * When the user taps the screen, it schedules a transition to the Scanner screen
- * after a short delay and broadcasts the current game status to all devices.
+ * When the user taps the screen, it schedules a transition to the arena list
+ * after a short delay.
  */
 
  #ifndef ACTIVATION_HPP
@@ -13,12 +13,6 @@
  #include "GUI_Manager.hpp"
  #include "Utilities/Countdowner.hpp"
  #include "Utilities/MoreMath.hpp"
- #include "MANAGER/manager_shared.hpp"
- #include "Scanner.hpp"  // For scanner instance
-
- // From Scanner.hpp
- void initScanner(); ///< Forward declaration for scanner initialization
- void triggerScanner(); ///< Forward declaration for scanner trigger function
  
  /**
   * @class Activation
@@ -26,8 +20,8 @@
   *
   * This Activity shows a colored background, the project name ("Project LazerTag"),
   * a “PRESS ANYWHERE TO PLAY” prompt, and an author credit. Touching the screen
-  * starts a countdown event that switches to the Scanner Activity and informs all
-  * networked devices of the current GAME_WAITING status.
+  * starts a countdown event that switches to the ArenaSelect Activity, where
+  * the match to set up or watch is picked.
   */
  class Activation : public Activity {
  public:
@@ -38,7 +32,7 @@
      Text text4;               ///< Displays "Made by Roi Attias"
      Text text5;               ///< Displays version in pormat "vX.Y.Z"
  
-     uint32_t countdownTime = 400;  ///< Delay before transitioning to scanner (ms)
+     uint32_t countdownTime = 400;  ///< Delay before transitioning to the arena list (ms)
  
      /**
       * @brief Construct the Activation Activity.
@@ -91,36 +85,20 @@
      /**
       * @brief Handle touch events on the Activation screen.
       *
-      * On a PRESS event, schedules a transition to the Scanner Activity after
-      * @c countdownTime milliseconds and broadcasts the GAME_WAITING status
-      * to all peers on the Nexus network.
+      * On a PRESS event, schedules a transition to the ArenaSelect Activity after
+      * @c countdownTime milliseconds.
       *
       * @param point The touch location (ignored).
       * @param touchStatus The type of touch event (only PRESS is handled).
       */
      void OnTouch_execute(ivec2 point, TouchStatus touchStatus) override {
          if (touchStatus == TouchStatus_PRESS) {
-             initScanner();  // Initialize the scanner
-             // After delay, switch to Scanner screen
+             // After delay, switch to the arena list
              countdowner->addEvent(
                countdownTime,
                GUI::selectActivity,
-               GUI_Manager_Activity::SCANNER
-             );
-             // Inform all devices that we are still in the waiting state
-             Nexus::sendData(
-               COMMS_GAMESTATUS,
-               payloadSizePerCommand[COMMS_GAMESTATUS],
-               (uint8_t *)&Game::status,
-               NexusAddress(NEXUS_PROJECT_ID, 0xFF, 0xFF)
+               GUI_Manager_Activity::ARENASELECT
              );
-              // Trigger the scanner to start scanning if not the first scan
-              //    and set the flag for the next scans
-             if (notTheFirstScan) {
-              triggerScanner();
-             } else {
-                 notTheFirstScan = true;
-             }
          }
      }
  };
@@ -0,0 +1,141 @@
+/**
+ * @file ArenaSelect.hpp
+ * @brief “Arena” selection Activity for the Manager GUI.
+ *
+ * The Manager hosts GAME_MAX_MATCHES matches at once, one per arena. Each
+ * arena's Guns and Vests use their own Nexus project ID. This screen shows
+ * every arena with the status of its match. Tapping one makes it the match
+ * shown by the GUI and continues where that match stands: setup for an idle
+ * arena, the countdown, or the live dashboard.
+ */
+
+ #ifndef ARENASELECT_HPP
+ #define ARENASELECT_HPP
+
+ #include "GUI_Manager.hpp"
+ #include "MANAGER/manager_shared.hpp"
+ #include "Scanner.hpp"
+ #include "ReadySetGo.hpp"
+
+ /**
+  * @brief Touch handler shared by the arena buttons.
+  * @param point  Touch coordinates, used to find the arena.
+  * @param status TouchStatus of the event (only RELEASE selects).
+  */
+ void onArenaButtonTouch(ivec2 point, TouchStatus status);
+
+ /**
+  * @brief Makes an arena the selected one and opens the screen matching its status.
+  * @param index Match index.
+  */
+ void selectArena(uint8_t index);
+
+ /** @brief Short label of each GameStatus for the arena buttons. */
+ const char *arenaStatusText[GameStatus_size] = {
+     "Idle", "Setup", "3", "2", "1", "GO!", "Running", "Over", "Done", "Done"
+ };
+
+ /**
+  * @class ArenaSelect
+  * @brief Grid of one button per hosted match.
+  */
+ class ArenaSelect : public Activity {
+ public:
+     Background background;                 ///< Full-screen background block
+     Text       titleText;                  ///< Header text “Arenas”
+     Button*    arenaButtons[GAME_MAX_MATCHES]; ///< One button per match
+
+     /**
+      * @brief Construct the ArenaSelect Activity.
+      *
+      * Lays the arena buttons out in a grid of two columns.
+      */
+     ArenaSelect()
+       : Activity(),
+         background(TFT_DARKGREEN),
+         titleText(
+           Element(ivec2(0, 10), LuminaUI_AUTO, ivec2(480, 40)),
+           String("Arenas"), TFT_WHITE, 1, MC_DATUM, 0, &FreeMonoBold24pt7b
+         )
+     {
+         Element* elems[2 + GAME_MAX_MATCHES] = { &background, &titleText };
+         for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+             ivec2 pos(20 + 230 * (i % 2), 70 + 120 * (i / 2));
+             arenaButtons[i] = new Button(
+               Element(pos, LuminaUI_AUTO, ivec2(210, 100)),
+               "", TFT_BLACK, TFT_YELLOW, TFT_BLACK, 20, 1, 0.0f,
+               &FreeMonoBold12pt7b, true, true
+             );
+             arenaButtons[i]->OnTouch_setHandler(onArenaButtonTouch);
+             arenaButtons[i]->OnTouch_setEnable(true);
+             elems[2 + i] = arenaButtons[i];
+         }
+         elements.addFromArray(elems, sizeof(elems) / sizeof(Element*));
+     }
+
+     /**
+      * @brief Refresh every button with the status of its match, then draw.
+      */
+     Viewport render(const Viewport &viewport) override {
+         for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+             GameStatus status = Game::matches[i].status;
+             arenaButtons[i]->text.content = "Arena " + String(i + 1) + " " + arenaStatusText[status];
+             arenaButtons[i]->background.fillColor =
+                 (status == GAME_WAITING || status == GAME_WON) ? TFT_YELLOW : TFT_ORANGE;
+         }
+         return Activity::render(viewport);
+     }
+ };
+
+ /// Global ArenaSelect Activity instance
+ static ArenaSelect *arenaSelect = new ArenaSelect();
+
+ void onArenaButtonTouch(ivec2 point, TouchStatus status) {
+     if (status != TouchStatus_RELEASE) return;
+     for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+         if (arenaSelect->arenaButtons[i]->inRange(point)) {
+             selectArena(i);
+             return;
+         }
+     }
+ }
+
+ void selectArena(uint8_t index) {
+     Game::select(index);
+     Match &match = Game::current();
+     // Scans, marks and device addresses now refer to this arena
+     Nexus::setProjectID(match.projectID);
+
+     switch (match.status) {
+         case GAME_WAITING:
+         case GAME_WON:
+         case GAME_LOST:
+             // Idle or finished: set up a new match
+             initScanner();
+             GUI::selectActivity(GUI_Manager_Activity::SCANNER);
+             broadcastStatus(index);
+             // The scanner scans by itself the first time it is shown
+             if (notTheFirstScan) {
+                 triggerScanner();
+             } else {
+                 notTheFirstScan = true;
+             }
+             break;
+         case GAME_STARTING:
+             resetRSG();
+             GUI::selectActivity(GUI_Manager_Activity::READYSETGO);
+             break;
+         case GAME_THREE:
+         case GAME_TWO:
+         case GAME_ONE:
+         case GAME_GO:
+             drawCountdown(match.status);
+             GUI::selectActivity(GUI_Manager_Activity::READYSETGO);
+             break;
+         default:
+             GUI::selectActivity(GUI_Manager_Activity::GAMEPLAY);
+             break;
+     }
+ }
+
+ #endif // ARENASELECT_HPP
@@ -27,6 +27,7 @@
     PLAYER2GUNSETUP, ///< Configures player 2 gun parameters
     READYSETGO,    ///< Countdown messages (Ready, Set, Go)
     GAMEPLAY,      ///< Live dashboard (HP bars, device status)
+    ARENASELECT,   ///< Chooses which hosted match the screens show
     GUI_Manager_Activity_size
 };
 
@@ -86,6 +87,7 @@
  #include "Message.hpp"              ///< Simple message Activity
  #include "ReadySetGo.hpp"           ///< Countdown Activity
  #include "Gameplay.hpp"             ///< Gameplay dashboard Activity
+ #include "ArenaSelect.hpp"          ///< Arena selection Activity
  
  /// Array of all Activity pointers in presentation order
  extern Activity* GUI_Manager_Activities[/* GUI_Manager_Activity_size */];
@@ -105,7 +107,8 @@
          player1GunSetup,
          player2GunSetup,
          readySetGoMessage,
-         gameplay
+         gameplay,
+         arenaSelect
      };
  
      void init(int startActivity) {
@@ -4,8 +4,12 @@
  *
  * The Gameplay activity displays the real-time state of the game:
  * - Two health bars (one per player)
+ * - A statistics line per player (live during the game, summary at the end)
  * - Dynamic narration text reflecting the current state
  * - A "Play Again!" button to reset the game once it ends
+ *
+ * It shows the match selected with Game::select(); tapping the title returns
+ * to the arena list while the match goes on.
  */
 
 #ifndef GAMEPLAY_HPP
@@ -13,18 +17,27 @@
 
 #include "GUI_Manager.hpp"   ///< LuminaUI screen, touch, and Nexus includes
 #include "Modules/Game.hpp"  ///< Game state and logic
+#include "Modules/Scoreboard.hpp" ///< Narrator text
 #include <Arduino.h>         ///< Arduino core
 
 /**
  * @brief Callback invoked when the "Play Again!" button is pressed/released.
  *
- * If released, returns the UI to the activation screen to start a new match.
+ * If released, returns the UI to the arena list to start a new match.
  *
  * @param point      The touch coordinates.
  * @param touchStatus The type of touch event (PRESS, RELEASE, READY, etc.).
  */
 void againButtonCallback(ivec2 point, TouchStatus touchStatus);
 
+/**
+ * @brief Touch handler for the title: returns to the arena list.
+ *
+ * @param point      The touch coordinates.
+ * @param touchStatus The type of touch event (PRESS, RELEASE, READY, etc.).
+ */
+void showArenas(ivec2 point, TouchStatus touchStatus);
+
 /**
  * @brief Touch handler for Player 1 name label and HP bar.
  *
@@ -45,6 +58,28 @@ void markPlayer1(ivec2 point, TouchStatus touchStatus);
  */
 void markPlayer2(ivec2 point, TouchStatus touchStatus);
 
+/**
+ * @brief Formats one player's statistics for the dashboard.
+ *
+ * While the game runs: hits, damage dealt and damage per second.
+ * Once it is over: accuracy, longest streak and fastest time-to-kill.
+ *
+ * @param index    Player index (0-based)
+ * @param gameOver True to show the end-of-match summary
+ * @return Line of at most ~21 characters
+ */
+String statsLine(uint8_t index, bool gameOver) {
+    PlayerStats &stats = Game::current().stats[index];
+    if (gameOver) {
+        String ttk = "-";
+        if (stats.bestTimeToKill) ttk = String(stats.bestTimeToKill / 1000.0f, 1) + "s";
+        return "Acc " + String(int(stats.accuracy() * 100.0f)) + "% Strk " + String(stats.longestStreak)
+            + " TTK " + ttk;
+    }
+    return "Hit " + String(stats.hits) + " Dmg " + String(stats.damageDealt)
+        + " DPS " + String(int(stats.dps(millis())));
+}
+
 /**
  * @class Gameplay
  * @brief A LuminaUI Activity showing the running game dashboard for the manager.
@@ -54,6 +89,7 @@ void markPlayer2(ivec2 point, TouchStatus touchStatus);
  *  - Static title "Game is running!"
  *  - A dynamic narrator text that changes based on players' health
  *  - Two health bars: one for Player 1 and one for Player 2
+ *  - A statistics line under each health bar
  *  - A "Play Again!" button once the game concludes
  */
 class Gameplay : public Activity {
@@ -68,6 +104,9 @@ public:
     Text  player2Title;   ///< Label for Player 2
     HpBar player2HpBar;   ///< Health bar for Player 2
 
+    Text  player1Stats;   ///< Statistics line for Player 1
+    Text  player2Stats;   ///< Statistics line for Player 2
+
     Button againButton;   ///< Button to restart the game after it ends
 
     // Internal state tracking
@@ -96,7 +135,11 @@ public:
         player2Title(Element(ivec2(240, 130), LuminaUI_AUTO, ivec2(240, 40)),
                      String("Player 2"), TFT_WHITE, 1, MC_DATUM, 0.0f, &FreeMonoBold18pt7b),
         player2HpBar(Element(ivec2(260, 180), LuminaUI_AUTO, ivec2(200, 50))),
-        againButton(Element(ivec2(90, 240), LuminaUI_AUTO, ivec2(300, 70), false),
+        player1Stats(Element(ivec2(0, 232), LuminaUI_AUTO, ivec2(240, 20)),
+                     String(""), TFT_WHITE, 1, MC_DATUM, 0.0f, &FreeMono9pt7b),
+        player2Stats(Element(ivec2(240, 232), LuminaUI_AUTO, ivec2(240, 20)),
+                     String(""), TFT_WHITE, 1, MC_DATUM, 0.0f, &FreeMono9pt7b),
+        againButton(Element(ivec2(90, 256), LuminaUI_AUTO, ivec2(300, 58), false),
                     "Play Again!", TFT_BLACK, TFT_YELLOW, TFT_BLACK, 20, 1, 0.0f, &FreeMono18pt7b, true, true),
         player1Hp(100),
         player2Hp(100),
@@ -108,6 +151,10 @@ public:
         againButton.OnTouch_setHandler(againButtonCallback);
         againButton.OnTouch_setEnable(true);
 
+        // Enable touch for the title to switch arenas
+        titleText.OnTouch_setHandler(showArenas);
+        titleText.OnTouch_setEnable(true);
+
         // Enable touch for player name labels and HP bars, and assign their handlers
         player1Title.OnTouch_setHandler(markPlayer1);
         player1Title.OnTouch_setEnable(true);
@@ -127,6 +174,8 @@ public:
             &player1HpBar,
             &player2Title,
             &player2HpBar,
+            &player1Stats,
+            &player2Stats,
             &againButton
         };
         elements.addFromArray(elems, sizeof(elems) / sizeof(Element*));
@@ -136,8 +185,10 @@ public:
      * @brief Renders and updates the gameplay UI.
      *
      * - Reads current HP from Game module.
-     * - Determines leading player or tie.
-     * - Selects an appropriate narration message.
+     * - Determines leading player or tie; once the match is over, the
+     *   winner as decided by the game mode (which may not be the one with more HP).
+     * - Refreshes both statistics lines.
+     * - Selects an appropriate narration message (Spectator::narrate()).
      * - Shows the "Play Again!" button if the game has ended.
      * - Calls the base class to perform actual drawing.
      *
@@ -146,8 +197,11 @@ public:
      */
     virtual Viewport render(const Viewport &viewport) override {
         // Fetch latest health values from game state
-        player1Hp = Game::player1.getHP();
-        player2Hp = Game::player2.getHP();
+        Match &match = Game::current();
+        player1Hp = match.player1.getHP();
+        player2Hp = match.player2.getHP();
+        // With respawns 0 HP does not end the game; the game mode does
+        bool over = match.status >= GAME_OVER;
 
         // Compute min/max HP and leading player
         minHP = min(player1Hp, player2Hp);
@@ -160,46 +214,23 @@ public:
         player1HpBar.setValue(player1Hp);
         player2HpBar.setValue(player2Hp);
 
-        // Narration for key game events with added dynamic sentences
-        if (maxHP == 100 && leadingPlayer == 0) {
-            narratorText.content =  
-                "Game Started! Let the duel commence. Prepare for an epic showdown on the laser taggin' battlefield!";
-            /** Another options:
-             * "As the two competitors arrives .The arena is charged with anticipation as they prepare for the ultimate showdown!"
-             * "The arena is alive with energy! Both players are at full health, ready to unleash their skills in this electrifying duel!"
-             */
-        } else if (minHP == 0 && leadingPlayer != 0) {
+        // Statistics are kept up to date by Match::processHit(); just format them
+        player1Stats.content = statsLine(0, over);
+        player2Stats.content = statsLine(1, over);
+        if (over) leadingPlayer = match.getWinner();
+
+        // Title for the end of the game; the narration is shared with spectator displays
+        if (over && leadingPlayer != 0) {
             titleText.content =  
                 "Player " + String(leadingPlayer) + " wins!";
-            narratorText.content =  "Game's Over! Player " + String(leadingPlayer)
-                + " wins! What an electrifying duel that kept us on the edge of our seats!";
-        } else if (minHP == 0 && leadingPlayer == 0) {
+        } else if (over) {
             titleText.content =  
                 "It's a tie!";
-            narratorText.content =  
-                "It's a tie! Both players fought valiantly, but the arena has claimed them both!";
-        } else if (maxHP == 100 && leadingPlayer != 0) {
-            narratorText.content =  
-                "Player " + String(leadingPlayer) + " is blazing ahead! With lightning-fast moves, the arena ignites with energy!";
-        } else if (minHP > 60 && minHP < 100 && leadingPlayer != 0) {
-            narratorText.content =  
-                "Player " + String(leadingPlayer) + " is in the lead! The tension is palpable as the duel intensifies!";
-        } else if (minHP <= 60 && minHP > 30) {
-            narratorText.content =  
-                "The duel is heating up!";
-        } else if (minHP <= 30 && minHP > 15) {
-            narratorText.content =  
-                "The stakes are high! One wrong move could turn the tide of battle!";
-        } else if (minHP <= 15 && leadingPlayer != 0) {
-            narratorText.content =  
-                "Player " + String((leadingPlayer % 2) + 1) + " is hanging by a thread! One more hit could change everything!";
-        } else {
-            narratorText.content =  
-                "The duel rages on... Every shot is a heartbeat, and the tension is lighting up the arena!";
         }
+        narratorText.content = Spectator::narrate(match);
 
         // Show or hide the restart button based on game over
-        againButton.visible = (minHP == 0);
+        againButton.visible = over;
 
         // Delegate actual drawing to the base Activity
         return Activity::render(viewport);
@@ -214,7 +245,7 @@ Gameplay* gameplay = new Gameplay();
 
 void againButtonCallback(ivec2 point, TouchStatus status) {
     if (status == TouchStatus_RELEASE) {
-        GUI::selectActivity(GUI_Manager_Activity::ACTIVATION);
+        GUI::selectActivity(GUI_Manager_Activity::ARENASELECT);
     }
     else if (status == TouchStatus_PRESS) {
         // Change the button color when pressed
@@ -232,28 +263,34 @@ void againButtonCallback(ivec2 point, TouchStatus status) {
     }
 }
 
+void showArenas(ivec2, TouchStatus status) {
+    if (status == TouchStatus_RELEASE) {
+        GUI::selectActivity(GUI_Manager_Activity::ARENASELECT);
+    }
+}
+
 void markPlayer1(ivec2, TouchStatus status) {
     if (status == TouchStatus_PRESS) {
-        if (Game::player1.hasGun()) {
+        if (Game::current().player1.hasGun()) {
             Nexus::sendData(COMMS_MARK, 0, nullptr,
-                        Game::player1.getGunAddress());
+                        Game::current().player1.getGunAddress());
         }
-        if (Game::player1.hasVest()) {
+        if (Game::current().player1.hasVest()) {
             Nexus::sendData(COMMS_MARK, 0, nullptr,
-                        Game::player1.getVestAddress());
+                        Game::current().player1.getVestAddress());
         }
     }
 }
 
 void markPlayer2(ivec2, TouchStatus status) {
     if (status == TouchStatus_PRESS) {
-        if (Game::player2.hasGun()) {
+        if (Game::current().player2.hasGun()) {
             Nexus::sendData(COMMS_MARK, 0, nullptr,
-                        Game::player2.getGunAddress());
+                        Game::current().player2.getGunAddress());
         }
-        if (Game::player2.hasVest()) {
+        if (Game::current().player2.hasVest()) {
             Nexus::sendData(COMMS_MARK, 0, nullptr,
-                        Game::player2.getVestAddress());
+                        Game::current().player2.getVestAddress());
         }
     }
 }
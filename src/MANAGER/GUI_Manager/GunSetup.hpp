@@ -38,16 +38,12 @@ static const uint triangle_triangles_count = sizeof(triangle_triangles) / sizeof
 /**
  * @brief Function to start the game and transition to the ReadySetGo activity.
  * - Resets the RSG message to its initial state.
- * - Sets the game status to STARTING.
- * - Sends the game status to all devices.
- * - Calls Game::start() to initialize the game.
+ * - Enters GAME_STARTING for the selected match, which prepares it and sends the status to its arena.
  */
 void moveToRSG() {
     resetRSG();
     GUI::selectActivity(GUI_Manager_Activity::READYSETGO);
-    Game::start();
-    Nexus::sendData(COMMS_GAMESTATUS, payloadSizePerCommand[COMMS_GAMESTATUS],
-        (uint8_t *)&Game::status, NexusAddress(NEXUS_PROJECT_ID, 0xff, 0xff));
+    managerFlows[Game::selected].enter(GAME_STARTING);
     GUI::callRender();
 }
  
@@ -201,7 +197,7 @@ void moveToRSG() {
  
     Viewport render(const Viewport &vp) override {
         if (playerNumber == 1) {
-            if (Game::player1.hasGun() == false)
+            if (Game::current().player1.hasGun() == false)
             {
                 if (forward) {
                     GUI::selectActivity(GUI_Manager_Activity::PLAYER2GUNSETUP);
@@ -212,7 +208,7 @@ void moveToRSG() {
                 return Viewport(ivec2(0, 0), ivec2(0, 0));
             }
         } else if (playerNumber == 2) {
-            if (Game::player2.hasGun() == false)
+            if (Game::current().player2.hasGun() == false)
             {
                 if (forward) {
                     moveToRSG();
@@ -323,7 +319,7 @@ void onPlayer1GunSetupNextButtonTouch(ivec2 point, TouchStatus status) {
                 player1GunSetup->nextButton.callRender();
 
                 // Proceed to the next step
-                Game::player1.setGunData(gunDataArray[player1GunSetup->gunIndex]);
+                Game::current().player1.setGunData(gunDataArray[player1GunSetup->gunIndex]);
                 GUI::selectActivity(GUI_Manager_Activity::PLAYER2GUNSETUP);
                 GUI::callRender();
                 break;
@@ -435,7 +431,7 @@ void onPlayer2GunSetupNextButtonTouch(ivec2 point, TouchStatus status) {
             player2GunSetup->nextButton.callRender();
 
             // Proceed to the next step
-            Game::player2.setGunData(gunDataArray[player2GunSetup->gunIndex]);
+            Game::current().player2.setGunData(gunDataArray[player2GunSetup->gunIndex]);
             moveToRSG();
             GUI::callRender();
             break;
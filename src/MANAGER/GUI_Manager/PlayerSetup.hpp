@@ -6,6 +6,9 @@
  *  - DeviceBox for gun
  *  - DeviceBox for vest
  *  - Switch buttons to swap assignments
+ *
+ * The header shows the game mode of the match; tapping it cycles through
+ * Rules::modes.
  *  
  * Back/Next navigation at bottom.
  * On Next:
@@ -20,6 +23,7 @@
  #include "Common/Constants_Common.h"
  #include "Components/Nexus/Nexus.hpp"
  #include "Common/LazerTagPacket.hpp"
+ #include "Modules/Game.hpp"
  #include "Scanner.hpp"
 
  // Forward declarations
@@ -29,6 +33,7 @@
  void onPlayerSetupNextButtonTouch(ivec2, TouchStatus);
  void onPlayer1TitleTouch(ivec2, TouchStatus);
  void onPlayer2TitleTouch(ivec2, TouchStatus);
+ void onGameModeTouch(ivec2, TouchStatus);
 
  // A function from Scanner.hpp
  void initScanner(); ///< Forward declaration for scanner initialization
@@ -37,7 +42,7 @@
  class PlayerSetup : public Activity {
  public:
      Gradient background;    ///< Gradient fill background
-     Text     titleText;     ///< “Player Setup” header
+     Text     titleText;     ///< Game mode header (tap to change)
  
      // Player 1 widgets
      Text      player1Title;
@@ -112,6 +117,9 @@
          player1Title.OnTouch_setEnable(true);
          player2Title.OnTouch_setHandler(onPlayer2TitleTouch);
          player2Title.OnTouch_setEnable(true);
+
+         titleText.OnTouch_setHandler(onGameModeTouch);
+         titleText.OnTouch_setEnable(true);
  
          // Add all children
          Element* elems[] = {
@@ -129,32 +137,32 @@
       *        then update Next button color.
       */
      void init() {
-         Game::reset();
+         Game::current().reset();
          int g=0, v=0;
          NexusAddress addr;
          
-         Game::player1.clearGun();
-         Game::player1.clearVest();
-            Game::player2.clearGun();
-            Game::player2.clearVest();
+         Game::current().player1.clearGun();
+         Game::current().player1.clearVest();
+            Game::current().player2.clearGun();
+            Game::current().player2.clearVest();
 
          for (int i = 0; i < GUI::gameDevices.size(); i++) {
             addr = GUI::gameDevices[i];
              if (addr.groups == NEXUS_GROUP_GUN) {
                 if (g == 0) {
-                    Game::player1.setGunAddress(addr);
+                    Game::current().player1.setGunAddress(addr);
                     g++;
                 } else {
-                    Game::player2.setGunAddress(addr);
+                    Game::current().player2.setGunAddress(addr);
                     g++;
                 }
              }
              else if (addr.groups == NEXUS_GROUP_VEST) {
                 if (v == 0) {
-                    Game::player1.setVestAddress(addr);
+                    Game::current().player1.setVestAddress(addr);
                     v++;
                 } else {
-                    Game::player2.setVestAddress(addr);
+                    Game::current().player2.setVestAddress(addr);
                     v++;
                 }
              }
@@ -170,21 +178,22 @@
       * @brief Check whether both players have gun+vest assigned.
       */
      bool canNext() {
-         return Game::canStart();
+         return Game::current().canStart();
      }
  
      /**
       * @brief Pull current addresses into DeviceBoxes and show/hide them.
       */
      void update() {
-         gunBox1.updateInformation(Game::player1.getGunAddress().deviceID,
-                                   Game::player1.getGunAddress().groups);
-         gunBox2.updateInformation(Game::player2.getGunAddress().deviceID,
-                                   Game::player2.getGunAddress().groups);
-         vestBox1.updateInformation(Game::player1.getVestAddress().deviceID,
-                                    Game::player1.getVestAddress().groups);
-         vestBox2.updateInformation(Game::player2.getVestAddress().deviceID,
-                                    Game::player2.getVestAddress().groups);
+         titleText.content = Game::current().rules->name;
+         gunBox1.updateInformation(Game::current().player1.getGunAddress().deviceID,
+                                   Game::current().player1.getGunAddress().groups);
+         gunBox2.updateInformation(Game::current().player2.getGunAddress().deviceID,
+                                   Game::current().player2.getGunAddress().groups);
+         vestBox1.updateInformation(Game::current().player1.getVestAddress().deviceID,
+                                    Game::current().player1.getVestAddress().groups);
+         vestBox2.updateInformation(Game::current().player2.getVestAddress().deviceID,
+                                    Game::current().player2.getVestAddress().groups);
          gunBox1.visible  = gunBox1.deviceGroup  != 0;
          gunBox2.visible  = gunBox2.deviceGroup  != 0;
          vestBox1.visible = vestBox1.deviceGroup != 0;
@@ -200,18 +209,18 @@
       * @brief Swap the two players’ guns.
       */
      void switchGuns() {
-         auto t = Game::player1.getGunAddress();
-         Game::player1.setGunAddress(Game::player2.getGunAddress());
-         Game::player2.setGunAddress(t);
+         auto t = Game::current().player1.getGunAddress();
+         Game::current().player1.setGunAddress(Game::current().player2.getGunAddress());
+         Game::current().player2.setGunAddress(t);
      }
  
      /**
       * @brief Swap the two players’ vests.
       */
      void switchVests() {
-         auto t = Game::player1.getVestAddress();
-         Game::player1.setVestAddress(Game::player2.getVestAddress());
-         Game::player2.setVestAddress(t);
+         auto t = Game::current().player1.getVestAddress();
+         Game::current().player1.setVestAddress(Game::current().player2.getVestAddress());
+         Game::current().player2.setVestAddress(t);
      }
  };
  
@@ -313,18 +322,32 @@ void onPlayerSetupNextButtonTouch(ivec2 point, TouchStatus status) {
     }
 }
 
+/**
+ * @brief Touch event handler for the header: selects the next game mode.
+ */
+void onGameModeTouch(ivec2, TouchStatus status) {
+    if (status != TouchStatus_PRESS) return;
+    Match &match = Game::current();
+    uint8_t next = 0;
+    for (uint8_t i = 0; i < Rules::modeCount; i++) {
+        if (Rules::modes[i] == match.rules) next = (i + 1) % Rules::modeCount;
+    }
+    match.setRules(*Rules::modes[next]);
+    playerSetup->titleText.callRender();
+}
+
 /**
  * @brief Touch event handler for the Player 1 title.
  */
 void onPlayer1TitleTouch(ivec2, TouchStatus status) {
     if (status == TouchStatus_PRESS) {
-        if (Game::player1.hasGun()) {
+        if (Game::current().player1.hasGun()) {
             Nexus::sendData(COMMS_MARK, 0, nullptr,
-                        Game::player1.getGunAddress());
+                        Game::current().player1.getGunAddress());
         }
-        if (Game::player1.hasVest()) {
+        if (Game::current().player1.hasVest()) {
             Nexus::sendData(COMMS_MARK, 0, nullptr,
-                        Game::player1.getVestAddress());
+                        Game::current().player1.getVestAddress());
         }
     }
 }
@@ -334,13 +357,13 @@ void onPlayer1TitleTouch(ivec2, TouchStatus status) {
  */
 void onPlayer2TitleTouch(ivec2, TouchStatus status) {
     if (status == TouchStatus_PRESS) {
-        if (Game::player2.hasGun()) {
+        if (Game::current().player2.hasGun()) {
             Nexus::sendData(COMMS_MARK, 0, nullptr,
-                        Game::player2.getGunAddress());
+                        Game::current().player2.getGunAddress());
         }
-        if (Game::player2.hasVest()) {
+        if (Game::current().player2.hasVest()) {
             Nexus::sendData(COMMS_MARK, 0, nullptr,
-                        Game::player2.getVestAddress());
+                        Game::current().player2.getVestAddress());
         }
     }
 }
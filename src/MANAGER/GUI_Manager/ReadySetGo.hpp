@@ -3,8 +3,9 @@
  * @brief “Ready, Set, Go!” countdown activity for the Manager GUI.
  *
  * Presents a modal dialog asking “Are you ready?” with a YES button.
- * On YES press, performs a 3–2–1–GO countdown, updates the game state,
- * broadcasts status to all devices, and then starts the game.
+ * On YES press, enters GAME_THREE for the selected match; the Manager's
+ * GameFlow then steps through 3–2–1–GO once a second, calling showCountdown()
+ * on each step, and starts the game.
  */
 
  #ifndef READYSETGO_HPP
@@ -12,26 +13,28 @@
  
  #include "GUI_Manager.hpp"
  #include "Message.hpp"
- #include "Utilities/Countdowner.hpp"
  #include "MANAGER/manager_shared.hpp"
  
  /**
-  * @brief Handler invoked at each countdown step (0=“3”,1=“2”,2=“1”,3=“GO!”,4=start).
-  * @param parameter Current countdown index.
-  *
-  * - Parameters 0–3 update the displayed message and Game::status.
-  * - Parameter 4 calls startGame() and transitions to GAMEPLAY.
-  * - After updating status, broadcasts new status to all peers.
-  * - Schedules itself for the next second using the Countdowner.
+  * @brief Entry action of GAME_THREE … GAME_GO: broadcasts the step and shows it
+  *        if the match is the selected one.
+  * @param status Countdown status just entered.
+  * @param index  Match index.
+  */
+ void showCountdown(GameStatus status, int index);
+
+ /**
+  * @brief Shows a countdown step in the dialog and hides the button.
+  * @param status Countdown status (GAME_THREE … GAME_GO).
   */
- void countdownHandler(int parameter);
+ void drawCountdown(GameStatus status);
  
  /**
   * @brief Touch event handler for the YES button in the “Are you ready?” dialog.
   * @param point     Touch coordinates (unused).
   * @param status    TouchStatus indicating PRESS, RELEASE, etc.
   *
-  * - On RELEASE: disables the button, starts the countdown at step 0.
+  * - On RELEASE: disables the button, enters GAME_THREE.
   * - On PRESS: visually darkens the button to give feedback.
   * - On READY (i.e. finger released but before next press): restores button colors.
   */
@@ -74,41 +77,24 @@
      "GO!"
  };
  
- void countdownHandler(int parameter) {
-     // If still within 0–3, update the dialog text and hide the button
-     if (parameter < 4) {
-         readySetGoMessage->setMessage(readySetGoText[parameter]);
-         readySetGoMessage->setButtonVisible(false);
-         GUI::callRender();
-         // Schedule next countdown tick in 1 second
-         countdowner->addEvent(1000, countdownHandler, parameter + 1);
-     }
- 
-     // Advance the Game::status based on the countdown index
-     switch (parameter) {
-         case 0: Game::status = GameStatus::GAME_THREE; break;
-         case 1: Game::status = GameStatus::GAME_TWO;   break;
-         case 2: Game::status = GameStatus::GAME_ONE;   break;
-         case 3: Game::status = GameStatus::GAME_GO;    break;
-         case 4:
-             startGame();      // Kick off the game
-             delay(100);       // Brief pause before gameplay
-             break;
-     }
+ void drawCountdown(GameStatus status) {
+     readySetGoMessage->setMessage(readySetGoText[status - GAME_THREE]);
+     readySetGoMessage->setButtonVisible(false);
+     GUI::callRender();
+ }
+
+ void showCountdown(GameStatus status, int index) {
+     // Update the dialog text and hide the button
+     if (index == Game::selected) drawCountdown(status);
  
-     // Broadcast the updated game status to all peers (broadcast MAC)
-     Nexus::sendData(
-         COMMS_GAMESTATUS,
-         payloadSizePerCommand[COMMS_GAMESTATUS],
-         (uint8_t *)&Game::status,
-         NexusAddress(NEXUS_PROJECT_ID, 0xff, 0xff)
-     );
+     // Broadcast the updated game status to the match's arena
+     broadcastStatus(index);
  }
  
  void readySetGoHandler(ivec2 /*point*/, TouchStatus status) {
      if (status == TouchStatus::TouchStatus_RELEASE) {
-         // On button release, start countdown at step 0
-         countdowner->addEvent(100, countdownHandler, 0);
+         // On button release, start the countdown
+         managerFlows[Game::selected].enter(GAME_THREE);
          // Disable further presses
          readySetGoMessage->okButton.OnTouch_setEnable(false);
          status = TouchStatus::TouchStatus_READY;
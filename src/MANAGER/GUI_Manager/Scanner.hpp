@@ -153,14 +153,17 @@
  
      /**
       * @brief Update device list when scan completes.
-      * - Shows a DeviceBox for each discovered peer
+      * - Shows a DeviceBox for each discovered peer of the selected arena
       * - Updates its ID and group flag
       * - Resets selection and button colors
       */
      virtual void updateScannedDevices() {
+         size_t next = 0;
          for (int i = 0; i < 9; i++) {
-             if (i < Nexus::devices.size()) {
-                 NexusAddress d = Nexus::devices[i];
+             while (next < Nexus::devices.size()
+                    && Nexus::devices[next].projectID != Nexus::getProjectID()) next++;
+             if (next < Nexus::devices.size()) {
+                 NexusAddress d = Nexus::devices[next++];
                  deviceBoxes[i]->updateInformation(d.deviceID, d.groups);
                  deviceBoxes[i]->setSelected(false);
                  deviceBoxes[i]->visible = true;
@@ -249,7 +252,7 @@
             for (int i = 0; i < 9; i++) {
                 uint8_t g = scanner->deviceBoxes[i]->deviceGroup;
                 if ((g == NEXUS_GROUP_GUN || g == NEXUS_GROUP_VEST) && scanner->deviceBoxes[i]->selected) {
-                    NexusAddress addr = { NEXUS_PROJECT_ID, g, (uint8_t)scanner->deviceBoxes[i]->deviceId };
+                    NexusAddress addr = { Nexus::getProjectID(), g, (uint8_t)scanner->deviceBoxes[i]->deviceId };
                     GUI::gameDevices.addend(addr);
                 }
             }
@@ -280,7 +283,7 @@
              box->invertSelected();
              uint8_t g = box->deviceGroup;
              if (g == NEXUS_GROUP_GUN || g == NEXUS_GROUP_VEST) {
-                NexusAddress addr{NEXUS_PROJECT_ID, g, (uint8_t)box->deviceId};
+                NexusAddress addr{Nexus::getProjectID(), g, (uint8_t)box->deviceId};
                 if (box->selected) {
                     // Send a mark packet to the selected device
                     Nexus::sendData(COMMS_MARK, 0, nullptr, addr);
@@ -3,10 +3,24 @@
  * @brief Main firmware for the Manager device in the LaserTag system.
  *
  * Responsibilities:
+ * - Host GAME_MAX_MATCHES concurrent matches, one per arena. Each arena's
+ *   devices use their own Nexus project ID (NEXUS_BASE_PROJECT_ID + arena),
+ *   and every packet is routed to its match by that ID.
  * - Initialize Nexus (ESP-NOW) networking and GUI.
  * - Scan for Vest/Gun devices and display them.
  * - Receive fire signals from Vests, process hits, and update HP.
- * - Detect end-of-game and schedule Winner/Loser notifications.
+ * - With local damage, reconcile the signed hit reports of Vests that
+ *   already applied a hit, and correct their HP where the Manager disagrees.
+ * - Detect end-of-game (as decided by each match's game mode) and schedule
+ *   Winner/Loser notifications.
+ * - Push respawns and new rounds of the game modes to the Guns and Vests.
+ * - Confirm accepted hits to the shooter's Gun with a hit marker.
+ * - Collect IR decode counters from the Vests and shot counts from the Guns at end of game.
+ * - Log match events and print the log after the game.
+ * - Broadcast a rate-limited scoreboard of every match to spectator displays.
+ * - Replicate the matches to a hot-standby Manager, or, as the standby,
+ *   follow the primary and take over when it falls silent.
+ * - Checkpoint the matches to NVS and resume them after a reboot.
  */
 
  #ifndef MANAGER_MAIN_HPP
@@ -18,13 +32,267 @@
  #include "Components/Nexus/Nexus.hpp"
  #include "Utilities/Countdowner.hpp"
  #include "Modules/Game.hpp"
+ #include "Modules/MatchLog.hpp"
+ #include "Modules/Scoreboard.hpp"
+ #include "Modules/Replica.hpp"
+ #include "Modules/Checkpoint.hpp"
  #include "GUI_Manager/GUI_Manager.hpp"
  
  /**
-  * @brief Callback invoked by Countdowner to notify Winner and Loser after a delay.
-  * @param parameter The ID of the winning player (1 or 2).
+  * @brief Entry action of GAME_STARTING: prepares the match, broadcasts the status and sends the Guns their start data.
+  * @param status Status just entered.
+  * @param index  Match index.
   */
- void countdowner_WinnerLoser(int parameter);
+ void prepareGame(GameStatus status, int index);
+
+ /**
+  * @brief Entry action of GAME_RUNNING: sends the game parameters and shows the dashboard.
+  * @param status Status just entered.
+  * @param index  Match index.
+  */
+ void runGame(GameStatus status, int index);
+
+ /**
+  * @brief Entry action of GAME_OVER: broadcasts the status and requests IR decode counters.
+  * @param status Status just entered.
+  * @param index  Match index.
+  */
+ void announceGameOver(GameStatus status, int index);
+
+ /**
+  * @brief Entry action of GAME_WON (on the Manager: results announced).
+  *
+  * Runs 3 s after GAME_OVER, once the Guns reported their shots: notifies
+  * Winner and Loser and prints the match log.
+  * @param status Status just entered.
+  * @param index  Match index.
+  */
+ void announceResults(GameStatus status, int index);
+
+ /**
+  * @brief Transition hook of every match flow: logs the new status of the match.
+  * @param status Status just entered.
+  * @param index  Match index.
+  */
+ void onMatchStatus(GameStatus status, int index)
+ {
+     Game::matches[index].setStatus(status);
+ }
+
+ /**
+  * @brief Manager actions per GameStatus; gameStates times the countdown and the results.
+  *
+  * GAME_WON means results announced on the Manager; GAME_LOST is never entered.
+  */
+ const GameActions managerActions[GameStatus_size] = {
+     /* GAME_WAITING  */ { nullptr,          nullptr },
+     /* GAME_STARTING */ { prepareGame,      nullptr },
+     /* GAME_THREE    */ { showCountdown,    nullptr },
+     /* GAME_TWO      */ { showCountdown,    nullptr },
+     /* GAME_ONE      */ { showCountdown,    nullptr },
+     /* GAME_GO       */ { showCountdown,    nullptr },
+     /* GAME_RUNNING  */ { runGame,          nullptr },
+     /* GAME_OVER     */ { announceGameOver, nullptr },
+     /* GAME_WON      */ { announceResults,  nullptr },
+     /* GAME_LOST     */ { nullptr,          nullptr }
+ };
+
+ static_assert(GAME_MAX_MATCHES == 4, "managerFlows lists one flow per match");
+
+ /** One flow per match, each driving the status of its match. */
+ GameFlow managerFlows[GAME_MAX_MATCHES] = {
+     GameFlow(managerActions, Game::matches[0].status, onMatchStatus, 0),
+     GameFlow(managerActions, Game::matches[1].status, onMatchStatus, 1),
+     GameFlow(managerActions, Game::matches[2].status, onMatchStatus, 2),
+     GameFlow(managerActions, Game::matches[3].status, onMatchStatus, 3)
+ };
+
+ /**
+  * @brief Sends WIN/LOSE status and MARK events to all players of a match.
+  * @param match  Finished match.
+  * @param winner Winning team ID (0 on draw: nothing is sent).
+  */
+ void sendResults(Match &match, uint8_t winner);
+
+ /**
+  * @brief Prints the log records of one match to Serial.
+  * @param index Match index.
+  */
+ void printMatchReport(uint8_t index);
+
+ /**
+  * @brief Broadcasts the scoreboard of each match to the spectator displays of its arena.
+  *
+  * Runs every SCOREBOARD_INTERVAL_MS and sends one frame per match whose
+  * scoreboard changed, or whose last frame is SCOREBOARD_HEARTBEAT_MS old
+  * so displays that joined late catch up. Frames go to the whole spectator
+  * group, so the cost does not depend on how many displays listen. With
+  * several matches the frames are queued (see Nexus::queueData()) and
+  * spread over the next loops instead of leaving back to back.
+  */
+ void broadcastScoreboards();
+
+ /**
+  * @brief Sends the replication frames of the matches that changed, or the heartbeat.
+  *
+  * Runs every REPLICA_INTERVAL_MS on the primary; see Replica.hpp. The
+  * frames are queued behind the scoreboards, like every per-match fan-out.
+  */
+ void replicate();
+
+ /**
+  * @brief Handles a replication frame of the other Manager.
+  *
+  * A primary that hears a Manager with a lower deviceID becomes its
+  * standby, so two Managers that booted together settle on one primary.
+  * @param packet Received COMMS_REPLICA packet.
+  */
+ void receiveReplica(const NexusPacket &packet);
+
+ /**
+  * @brief Turns the standby into the primary and continues the replicated matches.
+  *
+  * Running matches resume (see Match::resume()) and their devices get
+  * their HP and new hit tables; a countdown starts over and a finished
+  * game announces its results again. After a reboot the matches come from
+  * the checkpoint, so this is also how a lone Manager resumes.
+  */
+ void takeOver();
+
+ bool     standby = true;        ///< Following a primary Manager; devices are left to it
+ uint32_t lastReplicaHeard = 0;  ///< millis() of the last frame of the primary
+ bool     restoredAtBoot = false; ///< setup() restored a checkpoint
+
+ /**
+  * @brief Logs a device that appeared in a Nexus scan.
+  * @param who Address of the device.
+  */
+ void deviceConnectedCallback(const NexusAddress &who)
+ {
+     MatchLog::append(Game::projectToMatch[who.projectID], MATCH_EVENT_CONNECT,
+                      who.deviceID, MATCH_LOG_NONE, who.groups);
+ }
+
+ /**
+  * @brief Logs a device that vanished from the Nexus scan results.
+  * @param who Address of the device.
+  */
+ void deviceDisconnectedCallback(const NexusAddress &who)
+ {
+     MatchLog::append(Game::projectToMatch[who.projectID], MATCH_EVENT_DISCONNECT,
+                      who.deviceID, MATCH_LOG_NONE, who.groups);
+ }
+ 
+ /**
+  * @brief Sends the restored HP of a respawned player to its Gun and Vest.
+  * @param match Match of the player.
+  * @param who   Player index.
+  */
+ void respawnCallback(Match &match, uint8_t who)
+ {
+     Player &player = match.players[who];
+     Nexus::sendData(
+         COMMS_PLAYERHP,
+         payloadSizePerCommand[COMMS_PLAYERHP],
+         (uint8_t*)&player.hp,
+         player.getGunAddress());
+     Nexus::sendData(
+         COMMS_PLAYERHP,
+         payloadSizePerCommand[COMMS_PLAYERHP],
+         (uint8_t*)&player.hp,
+         player.getVestAddress());
+     if (match.id == Game::selected) GUI::callRender();
+ }
+
+ /**
+  * @brief Sends the full HP of a new round to every Gun and Vest of the arena in one packet.
+  * @param match Match starting a new round.
+  */
+ void newRoundCallback(Match &match)
+ {
+     Nexus::sendData(
+         COMMS_PLAYERHP,
+         payloadSizePerCommand[COMMS_PLAYERHP],
+         (uint8_t*)&match.players[0].hp,
+         NexusAddress(match.projectID, NEXUS_GROUP_GUN | NEXUS_GROUP_VEST, 0xFF));
+     if (match.id == Game::selected) GUI::callRender();
+ }
+
+ /**
+  * @brief Sends a hit marker straight to the Gun of the shooter.
+  *
+  * Skipped with local damage, where the Vest already sent it.
+  * @param match    Match of the hit.
+  * @param victim   Player index of the victim.
+  * @param attacker Player index of the shooter.
+  * @param damage   Damage dealt.
+  */
+ void hitCallback(Match &match, uint8_t victim, uint8_t attacker, uint16_t damage)
+ {
+     Player &shooter = match.players[attacker];
+     if (match.localDamage || !shooter.hasGun()) return;
+     HitMarker marker = { damage, !match.players[victim].isAlive() };
+     Nexus::sendData(
+         COMMS_HITMARKER,
+         payloadSizePerCommand[COMMS_HITMARKER],
+         (uint8_t*)&marker,
+         shooter.getGunAddress());
+ }
+
+ /**
+  * @brief Reconciles a hit a Vest applied locally with the Manager's own result.
+  *
+  * Forged and replayed reports are dropped. Otherwise the fire code goes
+  * through processHit() like a COMMS_FIRECODE: a valid hit sends the new HP
+  * to the victim's Gun, and the Vest only receives its HP when it differs
+  * from what it reported (e.g. the shot was a duplicate or hit a protected
+  * player), so an agreed hit costs a single packet.
+  * @param match    Match of the Vest.
+  * @param deviceID Vest that sent the report.
+  * @param report   Received report.
+  */
+ void reconcileHitReport(Match &match, uint8_t deviceID, const HitReport &report)
+ {
+     if (!match.acceptHitReport(deviceID, report)) return;
+ 
+     Player &victim = match.players[match.vestToPlayer[deviceID]];
+     if (match.processHit(deviceID, NEC_DATA(report.code), report.receivers)) {
+         Nexus::sendData(
+             COMMS_PLAYERHP,
+             payloadSizePerCommand[COMMS_PLAYERHP],
+             (uint8_t*)&victim.hp,
+             victim.getGunAddress());
+         if (match.id == Game::selected) GUI::callRender();
+     }
+     // The Manager has the final say over the Vest's HP
+     if (victim.hp != report.hp) {
+         Nexus::sendData(
+             COMMS_PLAYERHP,
+             payloadSizePerCommand[COMMS_PLAYERHP],
+             (uint8_t*)&victim.hp,
+             victim.getVestAddress());
+     }
+ }
+ 
+ /**
+  * @brief Prints the IR decode counters reported by a Vest to Serial.
+  * @param deviceID Vest that sent the counters.
+  * @param stats    Received counters.
+  */
+ void printIRStats(uint8_t deviceID, const IRhitStats &stats)
+ {
+     const IRdecodeStats &d = stats.decode;
+     Serial.printf("IR stats vest %u: started %u completed %u invalid %u dropped %u overflows %u\n",
+                   deviceID, d.started, d.completed, d.invalid, d.dropped, d.overflows);
+     Serial.printf("  failed hm %u hs %u bm %u bs %u, duplicates %u, hit drops %u\n",
+                   d.failed[headerMark], d.failed[headerSpace], d.failed[bitMark], d.failed[bitSpace],
+                   stats.duplicates, stats.hitDrops);
+     Serial.print("  error histogram:");
+     for (size_t i = 0; i < IR_ERROR_BINS; ++i) {
+         Serial.printf(" %u", d.errorHistogram[i]);
+     }
+     Serial.println();
+ }
  
  /**
   * @brief Called when Nexus device scan completes.
@@ -43,38 +311,85 @@
   * @brief Setup routine for the Manager device.
   *
   * - Starts serial at 115200 bps.
-  * - Initializes Nexus ESP-NOW with this device's address.
+  * - Assigns each match its arena's project ID and starts the match log.
+  * - Initializes Nexus ESP-NOW with this device's address and joins every arena.
   * - Registers the scan-complete callback.
-  * - Initializes the Manager GUI to the ACTIVATION screen.
-  * - Resets the game state to waiting.
+  * - Resets every match to waiting, then restores the last checkpoint, if any,
+  *   and logs how long the NVS read took.
+  * - Initializes the Manager GUI to the GAMEPLAY screen if the restored
+  *   match on screen was under way, else to the ACTIVATION screen.
+  * - Starts as a standby: becomes the primary unless another Manager's
+  *   replication frames arrive within REPLICA_TIMEOUT_MS.
   */
  void manager_setup()
  {
      Serial.begin(115200);
+
+     // One arena per match, on consecutive project IDs
+     Game::begin(NEXUS_BASE_PROJECT_ID);
+     MatchLog::begin();
  
      // Initialize ESP-NOW networking (Nexus)
-     Nexus::begin(NexusAddress(NEXUS_PROJECT_ID, NEXUS_GROUPS, NEXUS_DEVICE_ID));
+     Nexus::begin(NexusAddress(NEXUS_BASE_PROJECT_ID, NEXUS_GROUPS, NEXUS_DEVICE_ID));
+     for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+         Nexus::joinProject(Game::matches[i].projectID);
+     }
  
      // When scan completes, invoke our callback
      Nexus::onScanComplete = scanCompletedCallback;
- 
-     // Initialize GUI to the "Activation" activity (device selection)
-     GUI::init(GUI_Manager_Activity::ACTIVATION);
+     Nexus::onDeviceConnected = deviceConnectedCallback;
+     Nexus::onDeviceDisconnected = deviceDisconnectedCallback;
+
+     // Game modes report respawns and new rounds; hits are confirmed to the shooter
+     Game::onRespawn = respawnCallback;
+     Game::onNewRound = newRoundCallback;
+     Game::onHit = hitCallback;
  
      // Reset game data (HP, fire codes, status)
-     Game::reset();
+     for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+         Game::matches[i].reset();
+     }
+
+     // Bring back the matches and assignments from before a reboot
+     Checkpoint::setStore(Checkpoint::nvsWrite, Checkpoint::nvsRead);
+     uint32_t restoreStart = micros();
+     restoredAtBoot = Checkpoint::restore();
+     if (restoredAtBoot) {
+         Serial.printf("Checkpoint restored in %lu us, %lu ms after power-on\n",
+                       (unsigned long)(micros() - restoreStart), (unsigned long)millis());
+     }
+
+     // Initialize GUI to the dashboard of a resumed match, or the "Activation" activity (device selection)
+     GameStatus shown = Game::current().status;
+     bool live = restoredAtBoot && shown >= GAME_RUNNING && shown <= GAME_OVER;
+     GUI::init(live ? GUI_Manager_Activity::GAMEPLAY : GUI_Manager_Activity::ACTIVATION);
+
+     // Listen for a primary before acting as one
+     standby = true;
+     lastReplicaHeard = millis();
  }
  
  /**
   * @brief Main loop for the Manager device.
   *
   * - Processes Nexus networking events.
-  * - Updates GUI and Countdowner timers.
-  * - Reads incoming NexusPackets:
-  *   • During GAME_RUNNING: handles COMMS_FIRECODE from Vests, processes hits,
-  *     and broadcasts updated HP to all devices.
-  *   • When game-end condition met: ends game, broadcasts GAMESTATUS, and schedules
-  *     delayed Winner/Loser notifications.
+  * - Updates GUI, Countdowner timers and the game flow.
+  * - As the primary, broadcasts the scoreboards for spectators and the
+  *   replication frames for the standby (both rate-limited) and writes
+  *   checkpoints (see Checkpoint::loop()); as the
+  *   standby, takes over once no frame came for REPLICA_TIMEOUT_MS.
+  * - Reads incoming NexusPackets and routes each to the match of its source
+  *   project (one table lookup; packets of unknown projects are dropped):
+  *   • During GAME_RUNNING: handles COMMS_FIRECODE and COMMS_HITBATCH from
+  *     Vests, processes hits, and sends the updated HP (once per batch) to
+  *     the victim's devices; reconciles COMMS_HITREPORT from Vests with local
+  *     damage (see reconcileHitReport()).
+  *   • When game-end condition met: enters GAME_OVER (see gameStates).
+  *   • COMMS_REPLICA from the other Manager is applied (standby) or decides
+  *     which Manager is the primary; the standby ignores all other packets.
+  *   • In any state: prints COMMS_IRSTATS replies from Vests and per-player
+  *     accuracy when a Gun reports COMMS_SHOTCOUNT, and answers
+  *     COMMS_LOADOUT_REQUEST from Guns with their loadout.
   */
  void manager_loop()
  {
@@ -84,14 +399,79 @@
      // Update GUI rendering loop
      GUI::loop();
  
-     // Process scheduled events (e.g., delayed Winner/Loser)
+     // Process scheduled events and timed game transitions
      countdowner->loop();
+     // The standby waits for the primary to fall silent
+     if (standby && millis() - lastReplicaHeard >= REPLICA_TIMEOUT_MS) takeOver();
+     for (uint8_t i = 0; i < GAME_MAX_MATCHES && !standby; i++) {
+         managerFlows[i].loop();
+         // Timed modes can end without a hit
+         if (Game::matches[i].status == GAME_RUNNING && Game::matches[i].shouldEnd()) {
+             managerFlows[i].enter(GAME_OVER);
+         }
+     }
+
+     // Spill new match log records to the sink, if one is set
+     MatchLog::flush();
+
+     // Keep spectator displays, the standby and the checkpoint up to date
+     if (!standby) {
+         broadcastScoreboards();
+         replicate();
+         Checkpoint::loop();
+     }
  
      NexusPacket packet;
      // Consume all available received packets
      while (Nexus::readPacket(packet)) {
+         // Replication frames come from the other Manager
+         if (packet.command == COMMS_REPLICA
+             && packet.source.groups == NEXUS_GROUP_MANAGER)
+         {
+             receiveReplica(packet);
+             continue;
+         }
+         // A standby leaves the devices to the primary
+         if (standby) continue;
+
+         Match *match = Game::matchFor(packet.source.projectID);
+         if (!match) continue;
+
+         // IR decode counters may arrive after the game ended
+         if (packet.command == COMMS_IRSTATS
+             && packet.source.groups == NEXUS_GROUP_VEST)
+         {
+             IRhitStats stats;
+             memcpy(&stats, packet.payload, payloadSizePerCommand[COMMS_IRSTATS]);
+             printIRStats(packet.source.deviceID, stats);
+             continue;
+         }
+ 
+         // Shot counts arrive from the Guns at game over
+         if (packet.command == COMMS_SHOTCOUNT
+             && packet.source.groups == NEXUS_GROUP_GUN)
+         {
+             uint32_t shots;
+             memcpy(&shots, packet.payload, payloadSizePerCommand[COMMS_SHOTCOUNT]);
+             if (match->recordShots(packet.source.deviceID, shots)) {
+                 uint8_t who = match->gunToPlayer[packet.source.deviceID];
+                 Serial.printf("Arena %u accuracy P%u %u/%u (%.0f%%)\n",
+                               match->id + 1, who + 1, match->stats[who].hits, match->stats[who].shotsFired(),
+                               match->getAccuracy(who + 1) * 100.0f);
+             }
+             continue;
+         }
+
+         // A Gun misses the loadout named at game start
+         if (packet.command == COMMS_LOADOUT_REQUEST
+             && packet.source.groups == NEXUS_GROUP_GUN)
+         {
+             sendLoadout(*match, packet.source.deviceID);
+             continue;
+         }
+ 
          // Only process hits during active gameplay
-         if (Game::status == GAME_RUNNING) {
+         if (match->status == GAME_RUNNING) {
  
              // Handle incoming fire signals from Vest devices
              if (packet.command == COMMS_FIRECODE
@@ -102,150 +482,317 @@
                  memcpy(&fireSignal, packet.payload,
                         payloadSizePerCommand[COMMS_FIRECODE]);
  
-                 // If the hit is valid, apply damage and broadcast new HP
-                 if (Game::processHit(packet.source.deviceID, fireSignal))
+                 // If the hit is valid, apply damage and send the victim's new HP
+                 if (match->processHit(packet.source.deviceID, fireSignal))
                  {
-                     // Broadcast updated HP to both players' Gun and Vest
+                     Player &victim = match->players[match->vestToPlayer[packet.source.deviceID]];
                      Nexus::sendData(
                          COMMS_PLAYERHP,
                          payloadSizePerCommand[COMMS_PLAYERHP],
-                         (uint8_t*)&Game::player1.hp,
-                         Game::player1.getGunAddress());
+                         (uint8_t*)&victim.hp,
+                         victim.getGunAddress());
                      Nexus::sendData(
                          COMMS_PLAYERHP,
                          payloadSizePerCommand[COMMS_PLAYERHP],
-                         (uint8_t*)&Game::player1.hp,
-                         Game::player1.getVestAddress());
+                         (uint8_t*)&victim.hp,
+                         victim.getVestAddress());
+ 
+                     // Trigger GUI update if the match is on screen
+                     if (match->id == Game::selected) GUI::callRender();
+                 }
+             }
+
+             // Handle the hits a Vest gathered in one coalescing window
+             if (packet.command == COMMS_HITBATCH
+                 && packet.source.groups == NEXUS_GROUP_VEST)
+             {
+                 HitBatch batch;
+                 memcpy(&batch, packet.payload, payloadSizePerCommand[COMMS_HITBATCH]);
+
+                 // One HP update covers the whole batch
+                 if (match->processBatch(packet.source.deviceID, batch))
+                 {
+                     Player &victim = match->players[match->vestToPlayer[packet.source.deviceID]];
                      Nexus::sendData(
                          COMMS_PLAYERHP,
                          payloadSizePerCommand[COMMS_PLAYERHP],
-                         (uint8_t*)&Game::player2.hp,
-                         Game::player2.getGunAddress());
+                         (uint8_t*)&victim.hp,
+                         victim.getGunAddress());
                      Nexus::sendData(
                          COMMS_PLAYERHP,
                          payloadSizePerCommand[COMMS_PLAYERHP],
-                         (uint8_t*)&Game::player2.hp,
-                         Game::player2.getVestAddress());
- 
-                     // Trigger GUI update
-                     GUI::callRender();
+                         (uint8_t*)&victim.hp,
+                         victim.getVestAddress());
+                     if (match->id == Game::selected) GUI::callRender();
                  }
              }
+
+             // Handle hits a Vest already applied itself
+             if (packet.command == COMMS_HITREPORT
+                 && packet.source.groups == NEXUS_GROUP_VEST)
+             {
+                 HitReport report;
+                 memcpy(&report, packet.payload, payloadSizePerCommand[COMMS_HITREPORT]);
+                 reconcileHitReport(*match, packet.source.deviceID, report);
+             }
  
-             // If either player has 0 HP, end the game
-             if (Game::shouldEnd()) {
-                 delay(10);
-                 // Transition game state to GAME_OVER
-                 Game::end();
-                 delay(10);
-                 // Broadcast GAME_OVER to all participants (Gun & Vest)
-                 Nexus::sendData(
-                     COMMS_GAMESTATUS,
-                     payloadSizePerCommand[COMMS_GAMESTATUS],
-                     (uint8_t*)&Game::status,
-                     NexusAddress(NEXUS_PROJECT_ID, 0xFF, 0xFF));
- 
-                 // Request GUI update
-                 GUI::callRender();
- 
-                 // Schedule delayed Winner/Loser packet sends after 3000 ms
-                 uint8_t winner = Game::getWinner();
-                 countdowner->addEvent(
-                     3000,
-                     countdowner_WinnerLoser,
-                     winner);
+             // If at most one team is left alive, end the game
+             if (match->shouldEnd()) {
+                 managerFlows[match->id].enter(GAME_OVER);
              }
          }
      }
  }
  
- /**
-  * @brief Sends WIN/LOSE status and MARK events to appropriate devices after delay.
-  * @param parameter Winning player ID (1 or 2).
-  */
- void countdowner_WinnerLoser(int parameter)
+ void prepareGame(GameStatus, int index)
  {
-     uint8_t winner = (uint8_t)parameter;
-     GameStatus won = GAME_WON;
-     GameStatus lost = GAME_LOST;
+     Game::matches[index].start();
+     broadcastStatus(index);
+     sendGunStarts(index);
+ }
  
-     // If Player 1 won
-     if (Game::player1.getID() == winner)
-     {
-         // Notify Gun/Vest of Player1: WON
-         Nexus::sendData(
-             COMMS_GAMESTATUS,
-             payloadSizePerCommand[COMMS_GAMESTATUS],
-             (uint8_t*)&won,
-             Game::player1.getGunAddress());
-         Nexus::sendData(
-             COMMS_GAMESTATUS,
-             payloadSizePerCommand[COMMS_GAMESTATUS],
-             (uint8_t*)&won,
-             Game::player1.getVestAddress());
+ void runGame(GameStatus, int index)
+ {
+     Game::matches[index].play();
+     startGame(index);
+     broadcastStatus(index);
+ }
  
-         // Notify Gun/Vest of Player2: LOST
-         Nexus::sendData(
-             COMMS_GAMESTATUS,
-             payloadSizePerCommand[COMMS_GAMESTATUS],
-             (uint8_t*)&lost,
-             Game::player2.getGunAddress());
-         Nexus::sendData(
-             COMMS_GAMESTATUS,
-             payloadSizePerCommand[COMMS_GAMESTATUS],
-             (uint8_t*)&lost,
-             Game::player2.getVestAddress());
+ void announceGameOver(GameStatus, int index)
+ {
+     Match &match = Game::matches[index];
+
+     // Broadcast GAME_OVER to all participants (Gun & Vest)
+     broadcastStatus(index);
  
-         // Flash mark on winner’s endpoints
-         Nexus::sendData(
-             COMMS_MARK,
-             payloadSizePerCommand[COMMS_MARK],
-             nullptr,
-             Game::player1.getGunAddress());
-         Nexus::sendData(
-             COMMS_MARK,
-             payloadSizePerCommand[COMMS_MARK],
+     // Ask all Vests for their IR decode counters
+     for (uint8_t i = 0; i < match.playerCount; i++) {
+         Nexus::queueData(
+             COMMS_IRSTATS_REQUEST,
+             payloadSizePerCommand[COMMS_IRSTATS_REQUEST],
              nullptr,
-             Game::player1.getVestAddress());
+             match.players[i].getVestAddress());
      }
-     // If Player 2 won
-     else if (Game::player2.getID() == winner)
+ 
+     // Request GUI update
+     if (index == Game::selected) GUI::callRender();
+ }
+ 
+ void announceResults(GameStatus, int index)
+ {
+     Match &match = Game::matches[index];
+     sendResults(match, match.getWinner());
+     printMatchReport(index);
+ }
+ 
+ void sendResults(Match &match, uint8_t winner)
+ {
+     GameStatus won = GAME_WON;
+     GameStatus lost = GAME_LOST;
+     if (winner == 0) return;
+ 
+     for (uint8_t i = 0; i < match.playerCount; i++)
      {
-         // Notify Player2 WON, Player1 LOST
-         Nexus::sendData(
-             COMMS_GAMESTATUS,
-             payloadSizePerCommand[COMMS_GAMESTATUS],
-             (uint8_t*)&won,
-             Game::player2.getGunAddress());
-         Nexus::sendData(
-             COMMS_GAMESTATUS,
-             payloadSizePerCommand[COMMS_GAMESTATUS],
-             (uint8_t*)&won,
-             Game::player2.getVestAddress());
+         Player &player = match.players[i];
+         bool isWinner = match.team[i] == winner;
  
-         Nexus::sendData(
+         // Notify Gun/Vest: WON or LOST
+         Nexus::queueData(
              COMMS_GAMESTATUS,
              payloadSizePerCommand[COMMS_GAMESTATUS],
-             (uint8_t*)&lost,
-             Game::player1.getGunAddress());
-         Nexus::sendData(
+             (uint8_t*)(isWinner ? &won : &lost),
+             player.getGunAddress());
+         Nexus::queueData(
              COMMS_GAMESTATUS,
              payloadSizePerCommand[COMMS_GAMESTATUS],
-             (uint8_t*)&lost,
-             Game::player1.getVestAddress());
+             (uint8_t*)(isWinner ? &won : &lost),
+             player.getVestAddress());
  
-         // Flash mark on Player2's endpoints
-         Nexus::sendData(
-             COMMS_MARK,
-             payloadSizePerCommand[COMMS_MARK],
-             nullptr,
-             Game::player2.getGunAddress());
-         Nexus::sendData(
-             COMMS_MARK,
-             payloadSizePerCommand[COMMS_MARK],
-             nullptr,
-             Game::player2.getVestAddress());
+         // Flash mark on winners’ endpoints
+         if (isWinner)
+         {
+             Nexus::queueData(
+                 COMMS_MARK,
+                 payloadSizePerCommand[COMMS_MARK],
+                 nullptr,
+                 player.getGunAddress());
+             Nexus::queueData(
+                 COMMS_MARK,
+                 payloadSizePerCommand[COMMS_MARK],
+                 nullptr,
+                 player.getVestAddress());
+         }
      }
  }
  
- #endif // MANAGER_MAIN_HPP 
\ No newline at end of file
+ /** Match whose records printMatchReport() prints. */
+ static uint8_t reportMatch = 0;
+
+ /**
+  * @brief Prints a log record if it belongs to reportMatch.
+  * @param event Record to check.
+  */
+ void printReportEvent(const MatchEvent &event)
+ {
+     if (event.match == reportMatch) MatchLog::printEvent(event);
+ }
+
+ void printMatchReport(uint8_t index)
+ {
+     Serial.printf("Arena %u match log (%u events in RAM, %u lost)\n",
+                   index + 1, MatchLog::size(), MatchLog::lost());
+     Serial.println("time,match,type,player,other,arg,value");
+     reportMatch = index;
+     MatchLog::replay(printReportEvent);
+ }
+
+ ScoreboardFeed scoreboardFeed; ///< Rate limit of the scoreboard frames
+
+ void broadcastScoreboards()
+ {
+     uint32_t now = millis();
+     if (!scoreboardFeed.pass(now)) return;
+
+     for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+         Match &match = Game::matches[i];
+         Scoreboard board;
+         Spectator::build(match, board);
+         if (!scoreboardFeed.due(i, board, now)) continue;
+
+         Nexus::queueData(
+             COMMS_SCOREBOARD,
+             payloadSizePerCommand[COMMS_SCOREBOARD],
+             (uint8_t*)&board,
+             NexusAddress(match.projectID, NEXUS_GROUP_SPECTATOR, 0xFF));
+     }
+ }
+
+ ReplicaFrame lastReplica[GAME_MAX_MATCHES]; ///< Last full frame sent for each match
+ uint32_t     lastReplicaPass = 0;           ///< millis() of the last replicate() pass
+ uint32_t     lastReplicaSent = 0;           ///< millis() of the last frame sent
+ uint8_t      heartbeatMatch = 0;            ///< Match of the next heartbeat frame
+
+ /**
+  * @brief Sends one replication frame to the other Manager.
+  * @param frame Frame to send.
+  * @param size  Bytes of the frame (see Replica::frameSize()).
+  */
+ void sendReplica(ReplicaFrame &frame, uint8_t size)
+ {
+     Nexus::queueData(
+         COMMS_REPLICA,
+         size,
+         (uint8_t*)&frame,
+         NexusAddress(NEXUS_BASE_PROJECT_ID, NEXUS_GROUP_MANAGER, 0xFF));
+     lastReplicaSent = millis();
+ }
+
+ void replicate()
+ {
+     uint32_t now = millis();
+     if (now - lastReplicaPass < REPLICA_INTERVAL_MS) return;
+     lastReplicaPass = now;
+
+     ReplicaFrame full, out;
+     bool sent = false;
+     for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+         Replica::capture(Game::matches[i], full);
+         uint8_t size = Replica::delta(full, lastReplica[i], out, false);
+         if (size) {
+             sendReplica(out, size);
+             sent = true;
+         }
+     }
+
+     // Nothing changed for a while: one full frame is the heartbeat
+     if (!sent && now - lastReplicaSent >= REPLICA_HEARTBEAT_MS) {
+         Replica::capture(Game::matches[heartbeatMatch], full);
+         sendReplica(out, Replica::delta(full, lastReplica[heartbeatMatch], out, true));
+         heartbeatMatch = (heartbeatMatch + 1) % GAME_MAX_MATCHES;
+     }
+ }
+
+ void receiveReplica(const NexusPacket &packet)
+ {
+     if (!standby) {
+         // The Manager with the lower deviceID stays primary
+         if (packet.source.deviceID >= NEXUS_DEVICE_ID) return;
+         Serial.printf("Manager %u is primary: standing by\n", packet.source.deviceID);
+         standby = true;
+     }
+
+     ReplicaFrame frame;
+     memcpy(&frame, packet.payload, sizeof(frame));
+     if (packet.length < Replica::frameSize(0) || packet.length < Replica::frameSize(frame.count)) return;
+     if (!Replica::apply(frame)) return;
+     lastReplicaHeard = millis();
+     if (frame.match == Game::selected) GUI::callRender();
+ }
+
+ /**
+  * @brief Sends the HP and a new hit table to every device of a resumed match.
+  * @param index Match index.
+  */
+ void resumeDevices(uint8_t index)
+ {
+     Match &match = Game::matches[index];
+     for (uint8_t i = 0; i < match.playerCount; i++) {
+         Player &player = match.players[i];
+         Nexus::queueData(
+             COMMS_PLAYERHP,
+             payloadSizePerCommand[COMMS_PLAYERHP],
+             (uint8_t*)&player.hp,
+             player.getGunAddress());
+         Nexus::queueData(
+             COMMS_PLAYERHP,
+             payloadSizePerCommand[COMMS_PLAYERHP],
+             (uint8_t*)&player.hp,
+             player.getVestAddress());
+         HitTable table;
+         match.buildHitTable(i, table);
+         Nexus::queueData(
+             COMMS_HITTABLE,
+             payloadSizePerCommand[COMMS_HITTABLE],
+             (uint8_t*)&table,
+             player.getVestAddress());
+     }
+     if (index == Game::selected) GUI::callRender();
+ }
+
+ void takeOver()
+ {
+     Serial.println("No primary Manager: taking over");
+     standby = false;
+     if (restoredAtBoot) Serial.printf("Resuming from checkpoint %lu ms after power-on\n", (unsigned long)millis());
+     memset(lastReplica, 0, sizeof(lastReplica));
+
+     for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+         Match &match = Game::matches[i];
+         switch (match.status) {
+             case GAME_THREE:
+             case GAME_TWO:
+             case GAME_ONE:
+             case GAME_GO:
+                 // Count down again; GAME_RUNNING then starts the game as usual
+                 match.resume();
+                 match.status = GAME_STARTING;
+                 managerFlows[i].enter(GAME_THREE);
+                 break;
+             case GAME_RUNNING:
+                 if (!Replica::inSync(i)) Serial.printf("Match %u resumes from a replica that missed a frame\n", i);
+                 match.resume();
+                 resumeDevices(i);
+                 break;
+             case GAME_OVER:
+                 // Wait for the shot counts and announce the results again
+                 match.status = GAME_RUNNING;
+                 managerFlows[i].enter(GAME_OVER);
+                 break;
+             default:
+                 break;
+         }
+     }
+     if (Game::current().status == GAME_RUNNING) GUI::selectActivity(GUI_Manager_Activity::GAMEPLAY);
+ }
+
+ #endif // MANAGER_MAIN_HPP
@@ -2,10 +2,10 @@
  * @file manager_shared.hpp
  * @brief Shared helper logic for Manager activities to start a new game session.
  *
- * Provides a single function to:
- * - Broadcast each player’s starting HP and fire codes.
- * - Send initial GunData parameters.
- * - Transition game state to RUNNING and switch GUI to GAMEPLAY.
+ * Provides functions to:
+ * - Broadcast the status of a match to its arena.
+ * - Broadcast each player’s starting HP, IR protocol and fire codes.
+ * - Send initial GunData parameters and switch GUI to GAMEPLAY.
  */
 
  #ifndef MANAGER_SHARED_HPP
@@ -14,76 +14,112 @@
  #include "Components/Nexus/Nexus.hpp"
  #include "Common/LazerTagPacket.hpp"
  #include "Modules/Game.hpp"
+ #include "Modules/GameFlow.hpp"
 
  bool notTheFirstScan = false; ///< Flag to indicate if this is not the first scan
+
+ /** Drive the status of each match on the Manager; defined with their state table in manager_main.hpp. */
+ extern GameFlow managerFlows[GAME_MAX_MATCHES];
+
+ /**
+  * @brief Broadcasts the status of a match to all Guns and Vests of its arena.
+  *
+  * Queued like the per-player fan-outs below, so the devices get their
+  * start data before the status that uses it.
+  * @param index Match index.
+  */
+ void broadcastStatus(uint8_t index) {
+     Match &match = Game::matches[index];
+     Nexus::queueData(
+         COMMS_GAMESTATUS,
+         payloadSizePerCommand[COMMS_GAMESTATUS],
+         (uint8_t*)&match.status,
+         NexusAddress(match.projectID, 0xFF, 0xFF));
+ }
  
  /**
-  * @brief Broadcasts game start data to both players and switches GUI.
+  * @brief Sends every player's Gun its game start data.
   *
-  * Sends to Player1 & Player2 Gun/Vest:
+  * One COMMS_GUNSTART per Gun: initial HP, IR protocol, fire code
+  * (carrying the player's shooter ID) and the hash of its Loadout. A Gun
+  * that lacks the loadout asks for it (see sendLoadout()) and holds fire
+  * until it arrives. Called on entry to GAME_STARTING, so the countdown
+  * leaves time to fill the Gun's cache before GO.
+  * @param index Match index.
+  */
+ void sendGunStarts(uint8_t index) {
+     Match &match = Game::matches[index];
+     for (uint8_t i = 0; i < match.playerCount; i++) {
+         Player &player = match.players[i];
+         Loadout loadout;
+         playerLoadout(player, loadout);
+         GunStart start = { player.hp, match.irProtocol, match.fireSignals[i].data, loadoutHash(loadout) };
+         Nexus::queueData(
+             COMMS_GUNSTART,
+             payloadSizePerCommand[COMMS_GUNSTART],
+             (uint8_t*)&start,
+             player.getGunAddress());
+     }
+ }
+
+ /**
+  * @brief Sends every player's Vest its game start data and switches GUI.
+  *
+  * Sends to every player's Vest:
   *  1. COMMS_PLAYERHP  – initial HP
-  *  2. COMMS_FIRECODE – unique NEC fire code
-  *  3. COMMS_GUNPARAMS – initial GunData
-  * Then sets Game::status = GAME_RUNNING and selects the GAMEPLAY activity.
+  *  2. COMMS_IRPROTOCOL – IR protocol selected for this game
+  *  3. COMMS_HITTABLE – opponents (the hits the Vest forwards) and the nonce of its signing key
+  * Then selects the GAMEPLAY activity if the match is the one shown.
+  * The Guns got theirs at GAME_STARTING (see sendGunStarts()).
+  * Called on entry to GAME_RUNNING.
+  * @param index Match index.
   */
- void startGame() {
-     // Player 1 initialization
-     Nexus::sendData(
-         COMMS_PLAYERHP,
-         payloadSizePerCommand[COMMS_PLAYERHP],
-         (uint8_t*)&Game::player1.hp,
-         Game::player1.getGunAddress());
-     Nexus::sendData(
-         COMMS_PLAYERHP,
-         payloadSizePerCommand[COMMS_PLAYERHP],
-         (uint8_t*)&Game::player1.hp,
-         Game::player1.getVestAddress());
-     Nexus::sendData(
-         COMMS_FIRECODE,
-         payloadSizePerCommand[COMMS_FIRECODE],
-         (uint8_t*)&Game::fireSignals[0],
-         Game::player1.getGunAddress());
-     Nexus::sendData(
-         COMMS_GUNPARAMS,
-         payloadSizePerCommand[COMMS_GUNPARAMS],
-         (uint8_t*)&Game::player1.gunData,
-         Game::player1.getGunAddress());
-     Nexus::sendData(
-        COMMS_GUNNAME,
-        payloadSizePerCommand[COMMS_GUNNAME],
-        (uint8_t*)Game::player1.gunName,
-        Game::player1.getGunAddress());
+ void startGame(uint8_t index) {
+     Match &match = Game::matches[index];
+     for (uint8_t i = 0; i < match.playerCount; i++) {
+         Player &player = match.players[i];
+         Nexus::queueData(
+             COMMS_PLAYERHP,
+             payloadSizePerCommand[COMMS_PLAYERHP],
+             (uint8_t*)&player.hp,
+             player.getVestAddress());
+         Nexus::queueData(
+             COMMS_IRPROTOCOL,
+             payloadSizePerCommand[COMMS_IRPROTOCOL],
+             (uint8_t*)&match.irProtocol,
+             player.getVestAddress());
+         HitTable table;
+         match.buildHitTable(i, table);
+         Nexus::queueData(
+             COMMS_HITTABLE,
+             payloadSizePerCommand[COMMS_HITTABLE],
+             (uint8_t*)&table,
+             player.getVestAddress());
+     }
  
-     // Player 2 initialization
-     Nexus::sendData(
-         COMMS_PLAYERHP,
-         payloadSizePerCommand[COMMS_PLAYERHP],
-         (uint8_t*)&Game::player2.hp,
-         Game::player2.getGunAddress());
-     Nexus::sendData(
-         COMMS_PLAYERHP,
-         payloadSizePerCommand[COMMS_PLAYERHP],
-         (uint8_t*)&Game::player2.hp,
-         Game::player2.getVestAddress());
-     Nexus::sendData(
-         COMMS_FIRECODE,
-         payloadSizePerCommand[COMMS_FIRECODE],
-         (uint8_t*)&Game::fireSignals[1],
-         Game::player2.getGunAddress());
-     Nexus::sendData(
-         COMMS_GUNPARAMS,
-         payloadSizePerCommand[COMMS_GUNPARAMS],
-         (uint8_t*)&Game::player2.gunData,
-         Game::player2.getGunAddress());
-     Nexus::sendData(
-        COMMS_GUNNAME,
-        payloadSizePerCommand[COMMS_GUNNAME],
-        (uint8_t*)Game::player2.gunName,
-        Game::player2.getGunAddress());
- 
-     // Change game state and GUI
-     Game::run();
-     GUI::selectActivity(GUI_Manager_Activity::GAMEPLAY);
+     // Show the dashboard
+     if (index == Game::selected) GUI::selectActivity(GUI_Manager_Activity::GAMEPLAY);
  }
  
+ /**
+  * @brief Answers a Gun that misses its loadout in its cache.
+  *
+  * Sends the loadout of the Gun's player; the Gun checks it against the
+  * hash it asked for.
+  * @param match    Match of the Gun.
+  * @param deviceID DeviceID of the Gun.
+  */
+ void sendLoadout(Match &match, uint8_t deviceID) {
+     uint8_t who = match.gunToPlayer[deviceID];
+     if (who == GAME_NO_PLAYER) return;
+     Player &player = match.players[who];
+     Loadout loadout;
+     playerLoadout(player, loadout);
+     Nexus::queueData(
+         COMMS_LOADOUT,
+         payloadSizePerCommand[COMMS_LOADOUT],
+         (uint8_t*)&loadout,
+         player.getGunAddress());
+ }
+
  #endif // MANAGER_SHARED_HPP 
\ No newline at end of file
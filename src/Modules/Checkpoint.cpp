@@ -0,0 +1,162 @@
+/**
+ * @file Checkpoint.cpp
+ * @brief Implementation of the double-buffered checkpoints and the NVS store.
+ */
+
+ #include "Checkpoint.hpp"
+ #include "Utilities/SipHash.hpp"
+ #include <Preferences.h>
+
+ namespace Checkpoint {
+
+     static const uint32_t checksumKey[4] = { 0, 0, 0, 0 };
+     // Bytes compared to detect a change: everything after the running clock of the match,
+     // except Game::matchNumber, which every match start changes in all the records
+     static const size_t stateOffset = offsetof(CheckpointRecord, match) + offsetof(CheckpointMatch, state)
+                                     + offsetof(ReplicaFrame, header);
+     static const size_t numberOffset = stateOffset + offsetof(ReplicaHeader, matchNumber);
+
+     static CheckpointWriter writer = nullptr;
+     static CheckpointReader reader = nullptr;
+     static CheckpointRecord written[GAME_MAX_MATCHES]; // Last record written or restored per match
+     static CheckpointRecord pending;                   // Record being built or read
+     static uint8_t          nextSlot[GAME_MAX_MATCHES];
+     static uint32_t         sequence = 0;              // Sequence of the newest record of any match
+     static uint8_t          selected = 0;              // Game::selected of the newest record
+     static uint32_t         lastCheck = 0;
+
+     static uint64_t checksum(const CheckpointRecord &record) {
+         return SipHash::hash(checksumKey, (const uint8_t*)&record, offsetof(CheckpointRecord, checksum));
+     }
+
+     // Same match state apart from the running clock, which differs on every capture
+     static bool sameState(const CheckpointRecord &a, const CheckpointRecord &b) {
+         const uint8_t *pa = (const uint8_t*)&a, *pb = (const uint8_t*)&b;
+         return memcmp(pa + stateOffset, pb + stateOffset, numberOffset - stateOffset) == 0
+             && memcmp(pa + numberOffset + 1, pb + numberOffset + 1,
+                       offsetof(CheckpointRecord, checksum) - numberOffset - 1) == 0;
+     }
+
+     // Writes the captured record of a match to its next slot
+     static void write(uint8_t index) {
+         pending.sequence = sequence + 1;
+         pending.checksum = checksum(pending);
+         if (!writer(index * CHECKPOINT_SLOTS + nextSlot[index], (const uint8_t*)&pending, sizeof(pending))) return;
+         sequence = pending.sequence;
+         selected = pending.selected;
+         written[index] = pending;
+         nextSlot[index] = (nextSlot[index] + 1) % CHECKPOINT_SLOTS;
+     }
+
+     void capture(uint8_t index, CheckpointRecord &record) {
+         const Match &match = Game::matches[index];
+         CheckpointMatch &m = record.match;
+         record.magic = CHECKPOINT_MAGIC;
+         record.selected = Game::selected;
+         Replica::capture(match, m.state);
+         for (uint8_t p = 0; p < GAME_MAX_PLAYERS; p++) {
+             m.gunData[p] = match.players[p].getGunData();
+             memcpy(m.gunName[p], match.players[p].getGunNameRaw(), MAX_GUN_NAME_LENGTH);
+         }
+     }
+
+     bool intact(const CheckpointRecord &record) {
+         return record.magic == CHECKPOINT_MAGIC && record.checksum == checksum(record)
+             && record.match.state.match < GAME_MAX_MATCHES;
+     }
+
+     void setStore(CheckpointWriter newWriter, CheckpointReader newReader) {
+         writer = newWriter;
+         reader = newReader;
+     }
+
+     bool restore() {
+         if (!reader) return false;
+
+         int8_t selectedFrom = -1;
+         for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+             // Newest intact slot of the match; a torn write fails its checksum
+             int8_t best = -1;
+             for (uint8_t slot = 0; slot < CHECKPOINT_SLOTS; slot++) {
+                 if (!reader(i * CHECKPOINT_SLOTS + slot, (uint8_t*)&pending, sizeof(pending))) continue;
+                 if (!intact(pending) || pending.match.state.match != i) continue;
+                 if (best >= 0 && int32_t(pending.sequence - written[i].sequence) <= 0) continue;
+                 written[i] = pending;
+                 best = slot;
+             }
+             if (best < 0) {
+                 // Nothing stored: only a change from the current state is worth a write
+                 capture(i, written[i]);
+                 continue;
+             }
+             nextSlot[i] = (best + 1) % CHECKPOINT_SLOTS;
+
+             const CheckpointMatch &m = written[i].match;
+             Match &match = Game::matches[i];
+             for (uint8_t p = 0; p < GAME_MAX_PLAYERS; p++) {
+                 match.players[p].setGunData(m.gunData[p]);
+                 match.players[p].setGunName(m.gunName[p]);
+             }
+             Replica::apply(m.state);
+
+             // Selection and fire code coset come from the newest record
+             if (selectedFrom < 0 || int32_t(written[i].sequence - sequence) > 0) {
+                 sequence = written[i].sequence;
+                 selectedFrom = i;
+             }
+         }
+         lastCheck = millis();
+         if (selectedFrom < 0) {
+             selected = Game::selected;
+             return false;
+         }
+         // The newest record was written after the last match start
+         Game::matchNumber = written[selectedFrom].match.state.header.matchNumber;
+         selected = written[selectedFrom].selected;
+         if (selected < GAME_MAX_MATCHES) Game::select(selected);
+         return true;
+     }
+
+     void loop() {
+         if (!writer || millis() - lastCheck < CHECKPOINT_INTERVAL_MS) return;
+         lastCheck = millis();
+
+         for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+             capture(i, pending);
+             if (written[i].magic != CHECKPOINT_MAGIC || !sameState(pending, written[i])) write(i);
+         }
+
+         // A new selection alone goes into the record of the match now shown
+         if (selected != Game::selected && Game::selected < GAME_MAX_MATCHES) {
+             capture(Game::selected, pending);
+             write(Game::selected);
+         }
+     }
+
+     // ------------------------------ NVS store ------------------------------
+
+     // NVS key of a store slot: "slot0" .. "slot7"
+     static void slotKey(uint8_t slot, char key[8]) {
+         snprintf(key, 8, "slot%u", slot);
+     }
+
+     bool nvsWrite(uint8_t slot, const uint8_t *data, size_t size) {
+         Preferences prefs;
+         if (!prefs.begin("checkpoint", false)) return false;
+         char key[8];
+         slotKey(slot, key);
+         bool ok = prefs.putBytes(key, data, size) == size;
+         prefs.end();
+         return ok;
+     }
+
+     bool nvsRead(uint8_t slot, uint8_t *data, size_t size) {
+         Preferences prefs;
+         if (!prefs.begin("checkpoint", true)) return false;
+         char key[8];
+         slotKey(slot, key);
+         bool ok = prefs.getBytes(key, data, size) == size;
+         prefs.end();
+         return ok;
+     }
+ }
@@ -0,0 +1,111 @@
+/**
+ * @file Checkpoint.hpp
+ * @brief Periodic checkpoints of the hosted matches, so the Manager resumes after a reboot.
+ *
+ * A checkpoint holds, per match, the full replication frame (status, HP,
+ * scores, shooter IDs and the assigned guns and vests, see Replica.hpp)
+ * and the loadouts, plus the match shown by the GUI. Every
+ * CHECKPOINT_INTERVAL_MS loop() compares the matches with what was last
+ * written and writes the record of each match that changed, through a
+ * pluggable store (NVS on the Manager, a file on a host). An idle match
+ * costs no flash writes, and a busy one a record of about 1 KB.
+ *
+ * Writes are double-buffered: each match alternates between two slots,
+ * and every record carries a sequence number and a SipHash checksum.
+ * Power lost during a write damages only the slot being written;
+ * restore() takes the newest intact slot of each match, so the last
+ * complete checkpoint of every match survives.
+ */
+
+ #ifndef CHECKPOINT_HPP
+ #define CHECKPOINT_HPP
+
+ #include <Arduino.h>
+ #include "Replica.hpp"
+
+ /** Shortest time between two checks for changed matches (ms). */
+ #define CHECKPOINT_INTERVAL_MS 5000
+ /** Slots a store keeps per match; writes of a match alternate between them. */
+ #define CHECKPOINT_SLOTS 2
+ /** Slots a store keeps in total, numbered match * CHECKPOINT_SLOTS + slot. */
+ #define CHECKPOINT_STORE_SLOTS (GAME_MAX_MATCHES * CHECKPOINT_SLOTS)
+ /** First word of every record ("LTCM"). */
+ #define CHECKPOINT_MAGIC 0x4D43544C
+
+ /**
+  * @struct CheckpointMatch
+  * @brief Checkpointed state of one match.
+  */
+ struct __attribute__((packed)) CheckpointMatch {
+     ReplicaFrame state;                                   ///< Full frame (Replica::capture())
+     GunData      gunData[GAME_MAX_PLAYERS];               ///< Loadout of each player
+     char         gunName[GAME_MAX_PLAYERS][MAX_GUN_NAME_LENGTH]; ///< Gun name of each player
+ };
+
+ /**
+  * @struct CheckpointRecord
+  * @brief One match's record as written to a slot.
+  */
+ struct __attribute__((packed)) CheckpointRecord {
+     uint32_t        magic;    ///< CHECKPOINT_MAGIC
+     uint32_t        sequence; ///< Counts writes of all matches; the newest intact slot wins
+     uint8_t         selected; ///< Game::selected when the record was written
+     CheckpointMatch match;    ///< State of the match
+     uint64_t        checksum; ///< SipHash of the fields above under a zero key
+ };
+
+ /** Writes a record to a slot; returns false on failure. */
+ typedef bool (*CheckpointWriter)(uint8_t slot, const uint8_t *data, size_t size);
+ /** Reads a slot into a record; returns false if the slot is empty or unreadable. */
+ typedef bool (*CheckpointReader)(uint8_t slot, uint8_t *data, size_t size);
+
+ /**
+  * @namespace Checkpoint
+  * @brief Double-buffered checkpoints of Game::matches.
+  */
+ namespace Checkpoint {
+     /**
+      * @brief Sets the store; without one, loop() and restore() do nothing.
+      * @param writer Slot writer
+      * @param reader Slot reader
+      */
+     void setStore(CheckpointWriter writer, CheckpointReader reader);
+
+     /**
+      * @brief Restores the newest intact record of every match into Game::matches.
+      *
+      * Call once in setup(), after the matches were reset. Game::selected
+      * comes from the newest record of all. Later writes continue the
+      * sequence, each match in its other slot.
+      * @return True if a record of at least one match was restored
+      */
+     bool restore();
+
+     /**
+      * @brief Writes the record of every match that changed, once per CHECKPOINT_INTERVAL_MS.
+      *
+      * Call from the main loop of the Manager that hosts the matches.
+      */
+     void loop();
+
+     /**
+      * @brief Fills the record of one match from Game::matches (without sequence and checksum).
+      * @param index  Match index
+      * @param record Output record
+      */
+     void capture(uint8_t index, CheckpointRecord &record);
+
+     /**
+      * @brief Checks the magic and checksum of a record read back from a store.
+      * @param record Record as read
+      * @return False if the record is torn, damaged or not a checkpoint
+      */
+     bool intact(const CheckpointRecord &record);
+
+     /** @brief Writer of the built-in store: one NVS blob per slot. */
+     bool nvsWrite(uint8_t slot, const uint8_t *data, size_t size);
+     /** @brief Reader of the built-in store: one NVS blob per slot. */
+     bool nvsRead(uint8_t slot, uint8_t *data, size_t size);
+ }
+
+ #endif // CHECKPOINT_HPP
@@ -0,0 +1,34 @@
+/**
+ * @file DamageModel.cpp
+ * @brief Implementation of the built-in damage models and the receiver mask compiler.
+ */
+
+ #include "DamageModel.hpp"
+
+ namespace Damage {
+
+     const DamageZone receiverZone[DAMAGE_RECEIVERS] = { ZONE_FRONT, ZONE_BACK, ZONE_SHOULDER };
+
+     //                            name          front back shoulder   range ?/1/2/3        buff levels          buff ms
+     const DamageModel standard = { "Standard", { 100, 100, 100 }, { 100, 100, 100, 100 }, { 100, 125, 150, 200 }, 10000 };
+     const DamageModel zones    = { "Zones",    { 100, 150, 70 },  { 100, 70,  85,  100 }, { 100, 125, 150, 200 }, 10000 };
+
+     const DamageModel *const models[] = { &standard, &zones };
+     const uint8_t modelCount = sizeof(models) / sizeof(models[0]);
+
+     void compileMasks(const DamageModel &model, uint8_t maskPercent[DAMAGE_MASKS]) {
+         for (uint8_t mask = 0; mask < DAMAGE_MASKS; mask++) {
+             // Unreported receivers count as a front hit
+             uint8_t zone = mask ? 0 : model.zonePercent[ZONE_FRONT];
+             uint8_t receivers = 0;
+             for (uint8_t r = 0; r < DAMAGE_RECEIVERS; r++) {
+                 if (!((mask >> r) & 1)) continue;
+                 receivers++;
+                 uint8_t percent = model.zonePercent[receiverZone[r]];
+                 if (percent > zone) zone = percent;
+             }
+             uint16_t combined = (zone * model.rangePercent[receivers] + 50) / 100;
+             maskPercent[mask] = combined > 255 ? 255 : combined;
+         }
+     }
+ }
@@ -0,0 +1,86 @@
+/**
+ * @file DamageModel.hpp
+ * @brief Damage models: vest zone multipliers, range falloff and attacker buffs.
+ *
+ * A Match holds a pointer to one DamageModel. Match::start() compiles the
+ * model with every attacker's weapon damage into a lookup table indexed by
+ * attacker, buff level and the mask of vest receivers that decoded the
+ * shot, so Match::processHit() reads the damage of a hit from one table
+ * entry. Models are given in integer percent; all rounding happens at
+ * compile time, in the same way on the Manager and on a Vest that applies
+ * hits locally.
+ */
+
+ #ifndef DAMAGEMODEL_HPP
+ #define DAMAGEMODEL_HPP
+
+ #include <Arduino.h>
+
+ /** Receivers of a vest; a hit carries one bit per receiver that decoded it. */
+ #define DAMAGE_RECEIVERS 3
+ /** Distinct receiver masks. */
+ #define DAMAGE_MASKS (1 << DAMAGE_RECEIVERS)
+ /** Buff levels of an attacker, level 0 = no buff. */
+ #define DAMAGE_BUFF_LEVELS 4
+
+ /**
+  * @enum DamageZone
+  * @brief Body zone covered by a vest receiver.
+  */
+ enum DamageZone : uint8_t {
+     ZONE_FRONT,    ///< Chest
+     ZONE_BACK,     ///< Back
+     ZONE_SHOULDER, ///< Shoulder
+     DamageZone_size
+ };
+
+ /**
+  * @struct DamageModel
+  * @brief Multipliers of one damage model, in percent of the weapon's damage.
+  */
+ struct DamageModel {
+     const char *name;                             ///< Shown in the GUI
+     uint8_t  zonePercent[DamageZone_size];        ///< Per zone hit; several receivers count as the best zone
+     uint8_t  rangePercent[DAMAGE_RECEIVERS + 1];  ///< By receivers that decoded the shot: far (1) .. close (3); 0 = not reported
+     uint16_t buffPercent[DAMAGE_BUFF_LEVELS];     ///< Per buff level of the attacker
+     uint32_t buffDuration;                        ///< How long a buff lasts (ms)
+ };
+
+ /**
+  * @namespace Damage
+  * @brief Built-in damage models and the parts of the table compiler shared with the Vest.
+  */
+ namespace Damage {
+     /** Zone of each vest receiver, in the order of the vest's recvPins. */
+     extern const DamageZone receiverZone[DAMAGE_RECEIVERS];
+
+     /** Every hit deals the weapon's damage (buffs still apply). */
+     extern const DamageModel standard;
+     /** Back hits hurt more, shoulders less, and weak signals (few receivers, i.e. far away) less. */
+     extern const DamageModel zones;
+
+     /** All built-in models. */
+     extern const DamageModel *const models[];
+     /** Number of entries in models. */
+     extern const uint8_t modelCount;
+
+     /**
+      * @brief Combined zone and range percent of every receiver mask.
+      * @param model       Damage model
+      * @param maskPercent Output, indexed by receiver mask
+      */
+     void compileMasks(const DamageModel &model, uint8_t maskPercent[DAMAGE_MASKS]);
+
+     /**
+      * @brief Damage of one hit from its compiled parts.
+      * @param weapon      Weapon damage
+      * @param maskPercent Entry of compileMasks() for the hit's receivers
+      * @param buffPercent Attacker's buff percent (100 = no buff)
+      * @return Damage, rounded to nearest
+      */
+     inline uint16_t scale(uint32_t weapon, uint8_t maskPercent, uint16_t buffPercent) {
+         return (weapon * maskPercent * buffPercent + 5000) / 10000;
+     }
+ }
+
+ #endif // DAMAGEMODEL_HPP
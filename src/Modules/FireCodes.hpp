@@ -0,0 +1,112 @@
+/**
+ * @file FireCodes.hpp
+ * @brief Compile-time table of shooter IDs with a guaranteed minimum Hamming distance.
+ *
+ * Shooter IDs are the 16 codewords of the [8,4,4] extended Hamming code, so
+ * any two differ in at least 4 of their 8 bits: up to 3 bit errors can never
+ * turn one player's ID into another's. Each match XORs the table with a
+ * different coset leader. Cosets are disjoint, so an ID from the previous
+ * match never matches any ID of the current one, and the distance between
+ * the IDs of one match is unchanged.
+ *
+ * The code itself (coset 0) holds 0x00 and 0xFF, which are the addresses
+ * of most consumer NEC remotes, so it is never used: matches rotate
+ * through the other 15 cosets, none of which contains either value.
+ */
+
+ #ifndef FIRECODES_HPP
+ #define FIRECODES_HPP
+
+ #include <Arduino.h>
+
+ /** Number of distinct shooter IDs per match. */
+ #define FIRE_CODE_COUNT 16
+ /** Guaranteed minimum pairwise Hamming distance between shooter IDs. */
+ #define FIRE_CODE_MIN_DISTANCE 4
+ /** Number of cosets matches rotate through; the code itself is excluded. */
+ #define FIRE_CODE_COSETS 15
+
+ namespace FireCodes {
+
+     /**
+      * @brief Extended Hamming (8,4) codeword of a 4-bit value.
+      *
+      * Bit layout (MSB first): p1 p2 d1 p3 d2 d3 d4 p, where p is overall parity.
+      */
+     constexpr uint8_t hamming7(uint8_t n) {
+         return (uint8_t)(
+             ((((n >> 3) ^ (n >> 2) ^ n) & 1) << 6) |        // p1 = d1^d2^d4
+             ((((n >> 3) ^ (n >> 1) ^ n) & 1) << 5) |        // p2 = d1^d3^d4
+             (((n >> 3) & 1) << 4) |                         // d1
+             ((((n >> 2) ^ (n >> 1) ^ n) & 1) << 3) |        // p3 = d2^d3^d4
+             (((n >> 2) & 1) << 2) |                         // d2
+             (((n >> 1) & 1) << 1) |                         // d3
+             (n & 1));                                       // d4
+     }
+
+     /** @brief Number of set bits in a byte. */
+     constexpr uint8_t popcount8(uint8_t v) {
+         return v ? (uint8_t)((v & 1) + popcount8(v >> 1)) : 0;
+     }
+
+     /** @brief Codeword of a 4-bit value (7-bit Hamming code plus parity bit). */
+     constexpr uint8_t codeword(uint8_t n) {
+         return (uint8_t)((hamming7(n) << 1) | (popcount8(hamming7(n)) & 1));
+     }
+
+     /** @brief True if @p v is a codeword (its data bits re-encode to @p v). */
+     constexpr bool isCodeword(uint8_t v) {
+         return codeword((uint8_t)((((v >> 5) & 1) << 3) | (((v >> 3) & 1) << 2)
+                                 | (((v >> 2) & 1) << 1) | ((v >> 1) & 1))) == v;
+     }
+
+     /** Codewords of the code; XORed with a coset leader to get shooter IDs. */
+     constexpr uint8_t table[FIRE_CODE_COUNT] = {
+         codeword(0),  codeword(1),  codeword(2),  codeword(3),
+         codeword(4),  codeword(5),  codeword(6),  codeword(7),
+         codeword(8),  codeword(9),  codeword(10), codeword(11),
+         codeword(12), codeword(13), codeword(14), codeword(15)
+     };
+
+     /** Minimum-weight leaders of the 15 non-zero cosets of the code, one per match in rotation. */
+     constexpr uint8_t cosetLeaders[FIRE_CODE_COSETS] = {
+         0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+         0x03, 0x05, 0x06, 0x09, 0x0A, 0x0C, 0x11
+     };
+
+     /** @brief True if codewords @p i and every later one are at least the minimum distance apart. */
+     constexpr bool distanceFrom(uint8_t i, uint8_t j) {
+         return j >= FIRE_CODE_COUNT
+             || (popcount8(table[i] ^ table[j]) >= FIRE_CODE_MIN_DISTANCE && distanceFrom(i, j + 1));
+     }
+     /** @brief True if every pair of codewords from index @p i on is far enough apart. */
+     constexpr bool allDistances(uint8_t i) {
+         return i >= FIRE_CODE_COUNT || (distanceFrom(i, i + 1) && allDistances(i + 1));
+     }
+     /** @brief True if coset @p i differs from every later coset. */
+     constexpr bool cosetFrom(uint8_t i, uint8_t j) {
+         return j >= FIRE_CODE_COSETS
+             || (!isCodeword(cosetLeaders[i] ^ cosetLeaders[j]) && cosetFrom(i, j + 1));
+     }
+     /** @brief True if all cosets from index @p i on are pairwise distinct and none is the code itself. */
+     constexpr bool allCosets(uint8_t i) {
+         return i >= FIRE_CODE_COSETS
+             || (!isCodeword(cosetLeaders[i]) && cosetFrom(i, i + 1) && allCosets(i + 1));
+     }
+
+     static_assert(allDistances(0), "Fire codes violate the minimum Hamming distance");
+     static_assert(allCosets(0), "Coset leaders must select disjoint cosets other than the code");
+     static_assert(isCodeword(0x00) && isCodeword(0xFF), "0x00 and 0xFF must fall in the excluded coset");
+
+     /**
+      * @brief Shooter ID of a player in a given match.
+      * @param match Match counter (rotates through the cosets)
+      * @param index Player index (0..FIRE_CODE_COUNT-1)
+      * @return Never 0x00 or 0xFF
+      */
+     constexpr uint8_t shooterID(uint8_t match, uint8_t index) {
+         return table[index % FIRE_CODE_COUNT] ^ cosetLeaders[match % FIRE_CODE_COSETS];
+     }
+ }
+
+ #endif // FIRECODES_HPP
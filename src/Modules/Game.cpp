@@ -4,104 +4,396 @@
  */
 
  #include "Game.hpp"
+ #include "Utilities/Countdowner.hpp"
+ #include "Common/Constants_Common.h"
 
- namespace Game {
- 
-     // Initialize two players and default game state
-     Player     player1(1);
-     Player     player2(2);
-     GameStatus status = GAME_WAITING;
-     NEC_DATA   fireSignals[2];
- 
-     GameStatus getStatus() {
-         return status;
-     }
- 
-     bool hasPlayerHit(NEC_DATA fireSignal, uint8_t who) {
-         // A hit for player1 comes from player2’s code, and vice versa
-         if (who == 1) {
-             return fireSignal == fireSignals[1];
-         } else if (who == 2) {
-             return fireSignal == fireSignals[0];
-         }
+ static_assert(GAME_MAX_PLAYERS == 16, "Update the players[] initializer");
+ static_assert(GAME_MAX_PLAYERS < GAME_NO_PLAYER, "Player index collides with GAME_NO_PLAYER");
+ static_assert(GAME_MAX_MATCHES < GAME_NO_MATCH, "Match index collides with GAME_NO_MATCH");
+
+ // Initialize players and default game state
+ Match::Match()
+   : id(0),
+     projectID(0),
+     players{
+         Player(1),  Player(2),  Player(3),  Player(4),
+         Player(5),  Player(6),  Player(7),  Player(8),
+         Player(9),  Player(10), Player(11), Player(12),
+         Player(13), Player(14), Player(15), Player(16)
+     },
+     player1(players[0]),
+     player2(players[1]),
+     playerCount(2),
+     status(GAME_WAITING),
+     irProtocol(GAME_DEFAULT_IR_PROTOCOL),
+     localDamage(GAME_DEFAULT_LOCAL_DAMAGE)
+ {
+     for (uint8_t i = 0; i < GAME_MAX_PLAYERS; i++) {
+         team[i] = i + 1;
+         teamLead[i] = i;
+     }
+     rules = &Rules::lastStanding;
+     damageModel = &Damage::standard;
+     memset(buffLevel, 0, sizeof(buffLevel));
+     memset(buffEnds, 0, sizeof(buffEnds));
+     memset(damageTable, 0, sizeof(damageTable));
+     memset(teamScore, 0, sizeof(teamScore));
+     topScore = 0;
+     protectedMask = 0;
+     timeUp = false;
+     roundBreak = false;
+     epoch = 0;
+     playedAt = 0;
+     memset(vestToPlayer, GAME_NO_PLAYER, sizeof(vestToPlayer));
+     memset(gunToPlayer, GAME_NO_PLAYER, sizeof(gunToPlayer));
+     memset(shooterToPlayer, GAME_NO_PLAYER, sizeof(shooterToPlayer));
+     memset(seenShots, 0, sizeof(seenShots));
+     memset(hitNonce, 0, sizeof(hitNonce));
+     memset(hitKeys, 0, sizeof(hitKeys));
+     memset(reportSeq, 0, sizeof(reportSeq));
+ }
+
+ void Match::setStatus(GameStatus newStatus) {
+     status = newStatus;
+     MatchLog::append(id, MATCH_EVENT_STATUS, MATCH_LOG_NONE, MATCH_LOG_NONE, 0, newStatus);
+ }
+
+ void Match::setPlayerCount(uint8_t count) {
+     playerCount = count > GAME_MAX_PLAYERS ? GAME_MAX_PLAYERS : count;
+ }
+
+ void Match::setTeam(uint8_t who, uint8_t teamID) {
+     if (who >= 1 && who <= GAME_MAX_PLAYERS) {
+         team[who - 1] = teamID;
+     }
+ }
+
+ bool Match::hasPlayerHit(NEC_DATA fireSignal, uint8_t who) const {
+     if (who < 1 || who > playerCount) return false;
+     uint8_t shooter, shot;
+     if (!Game::decodeFireCode(irProtocol, fireSignal.data, shooter, shot)) return false;
+     uint8_t attacker = shooterToPlayer[shooter];
+     return attacker != GAME_NO_PLAYER && team[attacker] != team[who - 1];
+ }
+
+ bool Match::processHit(uint8_t deviceID, NEC_DATA fireSignal, uint8_t receivers) {
+     if (status != GAME_RUNNING) return false;
+
+     // Identify which player’s vest was hit and who fired
+     uint8_t victim = vestToPlayer[deviceID];
+     uint8_t shooter, shot;
+     if (victim == GAME_NO_PLAYER
+         || !Game::decodeFireCode(irProtocol, fireSignal.data, shooter, shot)) {
          return false;
      }
- 
-     bool processHit(uint8_t id, NEC_DATA fireSignal) {
-         if (status != GAME_RUNNING) return false;
- 
-         // Identify which player’s vest was hit
-         uint8_t who = 0;
-         if (id == player1.getVestAddress().deviceID) {
-             who = 1;
-         } else if (id == player2.getVestAddress().deviceID) {
-             who = 2;
-         } else {
-             return false; // Unknown target ID
+     uint8_t attacker = shooterToPlayer[shooter];
+     if (attacker == GAME_NO_PLAYER || team[attacker] == team[victim]
+         || (protectedMask >> victim) & 1 || !players[victim].isAlive()) return false;
+
+     // Count every shot once; forget the shot half a counter cycle ahead
+     uint8_t *seen = seenShots[attacker];
+     if (seen[shot >> 3] & (1 << (shot & 7))) return false;
+     seen[shot >> 3] |= 1 << (shot & 7);
+     uint8_t stale = shot + 128;
+     seen[stale >> 3] &= ~(1 << (stale & 7));
+
+     Player &target = players[victim];
+     int hpBefore = target.getHP();
+     target.damage(damageTable[attacker][buffLevel[attacker]][receivers & (DAMAGE_MASKS - 1)]);
+     uint32_t dealt = hpBefore - target.getHP();
+
+     // Update statistics; takeHit() returns the time-to-kill if the hit was fatal
+     uint32_t now = millis();
+     uint32_t wounded = stats[victim].takeHit(dealt, now);
+     stats[attacker].landHit(shot, dealt, now);
+
+     MatchLog::append(id, MATCH_EVENT_HIT, victim, attacker, shot, dealt);
+     MatchLog::append(id, MATCH_EVENT_HP, victim, MATCH_LOG_NONE, 0, target.getHP());
+
+     // The game mode decides what a kill means (respawn, score, end of round)
+     if (!target.isAlive()) {
+         stats[attacker].landKill(wounded);
+         rules->onKill(*this, victim, attacker);
+     }
+     if (Game::onHit) Game::onHit(*this, victim, attacker, dealt);
+     return true;
+ }
+
+ uint8_t Match::processBatch(uint8_t deviceID, const HitBatch &batch) {
+     // Sort the (few) entries by decode time; equal times keep their order
+     uint8_t count = batch.count < HIT_BATCH_SIZE ? batch.count : HIT_BATCH_SIZE;
+     uint8_t order[HIT_BATCH_SIZE];
+     for (uint8_t i = 0; i < count; i++) {
+         uint8_t j = i;
+         for (; j > 0 && batch.hits[order[j - 1]].offset > batch.hits[i].offset; j--) {
+             order[j] = order[j - 1];
          }
- 
-         // Apply damage if correct fire code received
-         if (hasPlayerHit(fireSignal, who)) {
-             if (who == 1) {
-                 player1.damage(player2.getGunDamage());
-             } else {
-                 player2.damage(player1.getGunDamage());
+         order[j] = i;
+     }
+
+     uint8_t applied = 0;
+     for (uint8_t i = 0; i < count; i++) {
+         const BatchedHit &hit = batch.hits[order[i]];
+         if (processHit(deviceID, NEC_DATA(hit.code), hit.receivers)) applied++;
+     }
+     return applied;
+ }
+
+ void Match::buildHitTable(uint8_t index, HitTable &table) const {
+     table.nonce = hitNonce[index];
+     table.localDamage = localDamage;
+     memcpy(table.maskPercent, maskPercent, sizeof(table.maskPercent));
+     table.count = 0;
+     for (uint8_t i = 0; i < playerCount; i++) {
+         if (team[i] == team[index]) continue;
+         table.shooter[table.count] = fireSignals[i].address;
+         table.gun[table.count] = players[i].hasGun() ? players[i].getGunAddress().deviceID : HIT_NO_GUN;
+         table.damage[table.count] = gunDamage[i];
+         table.count++;
+     }
+ }
+
+ void Match::renewHitKey(uint8_t index) {
+     static const uint32_t secret[4] = HIT_REPORT_SECRET;
+     const Player &p = players[index];
+     hitNonce[index] = esp_random();
+     // Only the nonce goes on air; the key is bound to the vest that signs with it
+     deriveHitKey(secret, projectID, p.hasVest() ? p.getVestAddress().deviceID : 0,
+                  hitNonce[index], hitKeys[index]);
+ }
+
+ bool Match::acceptHitReport(uint8_t deviceID, const HitReport &report) {
+     uint8_t victim = vestToPlayer[deviceID];
+     if (victim == GAME_NO_PLAYER || !verifyHitReport(report, hitKeys[victim])) return false;
+     // Report numbers only grow; a lost report leaves a gap, a replayed one is old
+     if (int16_t(report.seq - reportSeq[victim]) <= 0) return false;
+     reportSeq[victim] = report.seq;
+     return true;
+ }
+
+ bool Match::canStart() const {
+     bool canHit = false;
+     for (uint8_t a = 0; a < playerCount; a++) {
+         for (uint8_t b = a + 1; b < playerCount; b++) {
+             // Ensure that the guns and vests are not shared
+             if (players[a].hasGun() && players[a].getGunAddress() == players[b].getGunAddress()) return false;
+             if (players[a].hasVest() && players[a].getVestAddress() == players[b].getVestAddress()) return false;
+             // A gun must be able to hit a vest of another team
+             if (team[a] != team[b]
+                 && ((players[a].hasGun() && players[b].hasVest())
+                     || (players[b].hasGun() && players[a].hasVest()))) {
+                 canHit = true;
              }
-             return true;
          }
-         return false;
      }
- 
-     bool canStart() {
-         // Both players must have a gun assigned and the other’s vest reachable
-         bool case1Ready = player1.hasGun() && player2.hasVest();
-         bool case2Ready = player2.hasGun() && player1.hasVest();
-         if ( case1Ready || case2Ready) {
-                // Ensure that the guns and vests are not the same
-             return player1.getGunAddress() != player2.getGunAddress() &&
-                    player1.getVestAddress() != player2.getVestAddress();
+     return canHit;
+ }
+
+ bool Match::oneTeamLeft(uint8_t &survivor) const {
+     survivor = 0;
+     for (uint8_t i = 0; i < playerCount; i++) {
+         if (!players[i].isAlive()) continue;
+         if (survivor == 0) {
+             survivor = team[i];
+         } else if (team[i] != survivor) {
+             survivor = 0;
+             return false;
+         }
+     }
+     return true;
+ }
+
+ void Match::reset() {
+     status = GAME_WAITING;
+     epoch++; // Cancel pending timers of the game mode
+     irProtocol = GAME_DEFAULT_IR_PROTOCOL;
+     // Restore default weapon for all players
+     for (uint8_t i = 0; i < GAME_MAX_PLAYERS; i++) {
+         players[i].setGunData(Stinger);
+     }
+ }
+
+ void Match::start() {
+     memset(seenShots, 0, sizeof(seenShots));
+
+     // Shooter IDs are 4 bits apart and change coset every match start; guns count shots from 0
+     uint8_t match = Game::matchNumber;
+     Game::matchNumber = (match + 1) % FIRE_CODE_COSETS;
+     for (uint8_t i = 0; i < playerCount; i++) {
+         Player &p = players[i];
+         p.resetHP();
+
+         fireSignals[i] = NEC_DATA(FireCodes::shooterID(match, i), 0);
+         gunDamage[i] = p.getGunDamage();
+         stats[i].reset(millis());
+
+         // Vests sign their hit reports with a fresh key every match
+         renewHitKey(i);
+         reportSeq[i] = 0;
+         buffLevel[i] = 0;
+     }
+     buildTables();
+
+     memset(teamScore, 0, sizeof(teamScore));
+     topScore = 0;
+     protectedMask = 0;
+     timeUp = false;
+     roundBreak = false;
+     epoch++; // Timers of the last match are ignored from now on
+ }
+
+ void Match::resume() {
+     memset(seenShots, 0, sizeof(seenShots));
+     uint32_t now = millis();
+     for (uint8_t i = 0; i < playerCount; i++) {
+         stats[i].reset(now);
+         renewHitKey(i);
+         reportSeq[i] = 0;
+         buffLevel[i] = 0;
+     }
+     buildTables();
+
+     epoch++; // Timers armed before the takeover are ignored
+     if (status == GAME_RUNNING) Rules::resume(*this);
+ }
+
+ void Match::buildTables() {
+     memset(vestToPlayer, GAME_NO_PLAYER, sizeof(vestToPlayer));
+     memset(gunToPlayer, GAME_NO_PLAYER, sizeof(gunToPlayer));
+     memset(shooterToPlayer, GAME_NO_PLAYER, sizeof(shooterToPlayer));
+     for (uint8_t i = 0; i < playerCount; i++) {
+         Player &p = players[i];
+         shooterToPlayer[fireSignals[i].address] = i;
+         if (p.hasVest()) vestToPlayer[p.getVestAddress().deviceID] = i;
+         if (p.hasGun())  gunToPlayer[p.getGunAddress().deviceID] = i;
+
+         // Scores are kept at the first player of each team
+         teamLead[i] = i;
+         for (uint8_t j = 0; j < i; j++) {
+             if (team[j] == team[i]) { teamLead[i] = j; break; }
+         }
+     }
+
+     // Damage of every attacker, buff level and receiver mask
+     Damage::compileMasks(*damageModel, maskPercent);
+     for (uint8_t i = 0; i < playerCount; i++) {
+         for (uint8_t level = 0; level < DAMAGE_BUFF_LEVELS; level++) {
+             for (uint8_t mask = 0; mask < DAMAGE_MASKS; mask++) {
+                 damageTable[i][level][mask] =
+                     Damage::scale(gunDamage[i], maskPercent[mask], damageModel->buffPercent[level]);
+             }
+         }
+     }
+ }
+
+ // A buff expiry carries one int: epoch << 8 | match << 4 | player
+ static void onBuffEnd(int tag) {
+     Match &match = Game::matches[(tag >> 4) & 0x0F];
+     uint8_t who = tag & 0x0F;
+     // Ignore the timer of a replaced buff or an earlier match
+     if (uint8_t(tag >> 8) != match.epoch || int32_t(millis() - match.buffEnds[who]) < 0) return;
+     match.buffLevel[who] = 0;
+ }
+
+ void Match::buff(uint8_t index, uint8_t level) {
+     if (index >= playerCount || level >= DAMAGE_BUFF_LEVELS) return;
+     buffLevel[index] = level;
+     if (level == 0) return;
+     buffEnds[index] = millis() + damageModel->buffDuration;
+     countdowner->addEvent(damageModel->buffDuration, onBuffEnd, (epoch << 8) | (id << 4) | index);
+ }
+
+ bool Match::recordShots(uint8_t deviceID, uint32_t shots) {
+     uint8_t who = gunToPlayer[deviceID];
+     if (who == GAME_NO_PLAYER) return false;
+     stats[who].reportShots(shots);
+     MatchLog::append(id, MATCH_EVENT_SHOTS, who, MATCH_LOG_NONE, 0, shots);
+     return true;
+ }
+
+ float Match::getAccuracy(uint8_t who) const {
+     if (who < 1 || who > playerCount) return 0.0f;
+     return stats[who - 1].accuracy();
+ }
+
+ uint8_t Match::teamWithMostHP() const {
+     // Sum remaining HP per team, visiting each team at its first player
+     uint8_t winner = 0;
+     int bestHP = 0;
+     for (uint8_t i = 0; i < playerCount; i++) {
+         if (teamLead[i] != i) continue;
+
+         int hp = 0;
+         for (uint8_t j = i; j < playerCount; j++) {
+             if (team[j] == team[i]) hp += players[j].getHP();
+         }
+         if (hp > bestHP) {
+             bestHP = hp;
+             winner = team[i];
+         } else if (hp == bestHP) {
+             winner = 0; // Tie
+         }
+     }
+     return winner;
+ }
+
+ uint8_t Match::teamWithTopScore() const {
+     uint8_t winner = 0;
+     uint16_t best = 0;
+     for (uint8_t i = 0; i < playerCount; i++) {
+         if (teamLead[i] != i) continue;
+         if (teamScore[i] > best) {
+             best = teamScore[i];
+             winner = team[i];
+         } else if (teamScore[i] == best) {
+             winner = 0; // Tie
+         }
+     }
+     return winner;
+ }
+
+ namespace Game {
+
+     Match   matches[GAME_MAX_MATCHES];
+     uint8_t selected = 0;
+     uint8_t matchNumber = 0;
+     uint8_t projectToMatch[256];
+
+     void (* onRespawn)(Match &match, uint8_t who) = nullptr;
+     void (* onNewRound)(Match &match)             = nullptr;
+     void (* onHit)(Match &match, uint8_t victim, uint8_t attacker, uint16_t damage) = nullptr;
+
+     void begin(uint8_t firstProject) {
+         memset(projectToMatch, GAME_NO_MATCH, sizeof(projectToMatch));
+         for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+             matches[i].id = i;
+             matches[i].projectID = firstProject + i;
+             projectToMatch[uint8_t(firstProject + i)] = i;
          }
-        return false;
-     }
- 
-     bool shouldEnd() {
-         // Game ends when either player’s HP reaches zero
-         return player1.getHP() <= 0 || player2.getHP() <= 0;
-     }
- 
-     void reset() {
-         status = GAME_WAITING;
-         // Restore default weapon for both players
-         player1.setGunData(Stinger);
-         player2.setGunData(Stinger);
-     }
- 
-     void start() {
-         if (status != GAME_WAITING) return;
-         status = GAME_STARTING;
-         player1.resetHP();
-         player2.resetHP();
- 
-         // Generate two unique NEC_DATA codes using micros() low byte
-         uint8_t base = micros() & 0xFF;
-         fireSignals[0] = NEC_DATA(base, base + 10);
-         fireSignals[1] = NEC_DATA(base + 20, base + 30);
-     }
- 
-     void run() {
-         status = GAME_RUNNING;
-     }
- 
-     void end() {
-         status = GAME_OVER;
-     }
- 
-     uint8_t getWinner() {
-         int hp1 = player1.getHP();
-         int hp2 = player2.getHP();
-         if (hp1 > hp2) return player1.getID();
-         if (hp2 > hp1) return player2.getID();
-         return 0; // Tie
-     }
- 
- } // namespace Game 
\ No newline at end of file
+     }
+
+     void select(uint8_t index) {
+         if (index < GAME_MAX_MATCHES) selected = index;
+     }
+
+     uint32_t encodeFireCode(IRprotocolID protocol, uint8_t shooter, uint8_t shot) {
+         if (protocol == IR_PROTOCOL_TAG) {
+             return TAG_DATA(shooter, shot).data;
+         }
+         return NEC_DATA(shooter, shot).data;
+     }
+
+     bool decodeFireCode(IRprotocolID protocol, uint32_t code, uint8_t &shooter, uint8_t &shot) {
+         if (protocol == IR_PROTOCOL_TAG) {
+             TAG_DATA tag(code);
+             shooter = tag.shooter();
+             shot = tag.shot();
+             return tag.isValid();
+         }
+         NEC_DATA nec(code);
+         shooter = nec.address;
+         shot = nec.command;
+         return nec.address_inv == uint8_t(~nec.address) && nec.command_inv == uint8_t(~nec.command);
+     }
+
+ } // namespace Game
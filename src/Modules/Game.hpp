@@ -1,15 +1,38 @@
 /**
  * @file Game.hpp
- * @brief Declarations for core game logic, including player management and game state transitions.
+ * @brief Declarations for core game logic, including player management, game state transitions
+ *        and the matches hosted by the Manager.
  */
 
  #ifndef GAME_HPP
  #define GAME_HPP
  
  #include "Utilities/HyperList.hpp"           ///< Dynamic list container
- #include "Components/IRremoteESP32/IRremoteESP32.hpp" ///< NEC_DATA for fire signals
+ #include "Components/IRremoteESP32/IRremoteESP32.hpp" ///< NEC_DATA/TAG_DATA for fire signals
  #include "Player.hpp"                         ///< Player class and GunData
+ #include "FireCodes.hpp"                      ///< Shooter ID table
+ #include "MatchLog.hpp"                       ///< Match event log
+ #include "PlayerStats.hpp"                    ///< Incremental per-player statistics
+ #include "GameRules.hpp"                      ///< Pluggable game modes
+ #include "DamageModel.hpp"                    ///< Zone, range and buff multipliers
+ #include "HitReport.hpp"                      ///< Hit tables and signed hit reports
  
+ /** IR protocol selected for a new game (sent to guns and vests on start). */
+ #define GAME_DEFAULT_IR_PROTOCOL IR_PROTOCOL_NEC
+ /** Whether a new match lets the vests apply damage themselves (see HitReport.hpp). */
+ #define GAME_DEFAULT_LOCAL_DAMAGE false
+ /** Capacity of the player tables. */
+ #define GAME_MAX_PLAYERS 16
+ /** Lookup table entry for a device or shooter ID that belongs to no player. */
+ #define GAME_NO_PLAYER 0xFF
+ /** Matches one Manager hosts concurrently. */
+ #define GAME_MAX_MATCHES 4
+ /** Routing table entry for a project ID that belongs to no match. */
+ #define GAME_NO_MATCH 0xFF
+
+ static_assert(GAME_MAX_PLAYERS <= FIRE_CODE_COUNT, "Not enough fire codes for every player");
+ static_assert(GAME_MAX_PLAYERS <= HIT_TABLE_SIZE, "A hit table must fit every opponent");
+
  /**
   * @enum GameStatus
   * @brief Represents the different phases of the laser-tag game.
@@ -24,66 +47,353 @@
      GAME_RUNNING,  ///< Active play state
      GAME_OVER,     ///< Play ended, waiting for result
      GAME_WON,      ///< Victory state for a player
-     GAME_LOST      ///< Defeat state for a player
+     GAME_LOST,     ///< Defeat state for a player
+     GameStatus_size
  };
  
  /**
-  * @namespace Game
-  * @brief Encapsulates global game variables and functions.
+  * @class Match
+  * @brief State and rules of one match.
+  *
+  * Up to GAME_MAX_PLAYERS players take part, each in a team (free-for-all by
+  * default: team = player ID). Player objects hold the configuration (addresses,
+  * loadout, HP); per-game state is kept in parallel arrays indexed by player
+  * index (player ID - 1). Lookup tables built by start() map vest/gun device
+  * IDs and shooter IDs to player indices, so processHit() is constant-time.
+  *
+  * The Manager hosts GAME_MAX_MATCHES independent matches (see Game::matches);
+  * the devices of each match use the match's own Nexus project ID.
+  *
+  * The game mode is a GameRules object (see GameRules.hpp); scores are kept
+  * per team at the index of the team's first player (teamLead).
+  *
+  * The damage of a hit comes from damageTable, compiled by start() from the
+  * DamageModel (see DamageModel.hpp) and the weapons of the players.
+  *
+  * Each vest gets a hit table listing its opponents, so it forwards only
+  * their hits. With localDamage it applies hits itself; acceptHitReport()
+  * authenticates its reports before they go through processHit().
   */
- namespace Game {
-     extern Player     player1;        ///< Player 1 instance
-     extern Player     player2;        ///< Player 2 instance
-     extern GameStatus status;         ///< Current game status
-     extern NEC_DATA   fireSignals[2]; ///< Unique fire codes for each player
+ class Match {
+ public:
+     uint8_t    id;             ///< Index in Game::matches
+     uint8_t    projectID;      ///< Nexus project of the guns and vests of this match
+     Player     players[GAME_MAX_PLAYERS]; ///< Player instances, index = ID - 1
+     Player&    player1;        ///< Alias of players[0]
+     Player&    player2;        ///< Alias of players[1]
+     uint8_t    playerCount;    ///< Players taking part (default 2)
+     GameStatus status;         ///< Current game status
+     IRprotocolID irProtocol;   ///< IR protocol guns shoot with this game
+     bool       localDamage;    ///< Vests apply hits themselves and report them signed
+
+     // Per-player game state (struct of arrays, index = player index)
+     uint8_t    team[GAME_MAX_PLAYERS];        ///< Team of each player
+     NEC_DATA   fireSignals[GAME_MAX_PLAYERS]; ///< Fire code of each player; the address byte is its shooter ID
+     uint32_t   gunDamage[GAME_MAX_PLAYERS];   ///< Weapon damage per hit, cached from the loadout at start
+     uint8_t    buffLevel[GAME_MAX_PLAYERS];   ///< Active buff level of each player (0 = none)
+     uint32_t   buffEnds[GAME_MAX_PLAYERS];    ///< millis() at which each player's buff runs out
+     PlayerStats stats[GAME_MAX_PLAYERS];      ///< Match statistics of each player
+
+     // Lookup tables (GAME_NO_PLAYER if unassigned), rebuilt by start()
+     uint8_t    vestToPlayer[256];    ///< Vest deviceID -> player index
+     uint8_t    gunToPlayer[256];     ///< Gun deviceID -> player index
+     uint8_t    shooterToPlayer[256]; ///< Shooter ID -> player index
+
+     // Damage lookup, compiled by start()
+     const DamageModel *damageModel;           ///< Active damage model
+     uint8_t    maskPercent[DAMAGE_MASKS];     ///< Zone and range percent per receiver mask
+     uint16_t   damageTable[GAME_MAX_PLAYERS][DAMAGE_BUFF_LEVELS][DAMAGE_MASKS]; ///< Damage by attacker, buff level and receiver mask
+
+     // Game mode state, reset by start()
+     const GameRules *rules;                   ///< Active game mode
+     uint8_t    teamLead[GAME_MAX_PLAYERS];    ///< Index of the first player of each player's team
+     uint16_t   teamScore[GAME_MAX_PLAYERS];   ///< Kills or rounds won, at the team's lead index
+     uint16_t   topScore;                      ///< Highest teamScore
+     uint32_t   protectedMask;                 ///< Bit per player index that cannot be hit (dead or invulnerable)
+     bool       timeUp;                        ///< Set when the mode's clock ran out
+     bool       roundBreak;                    ///< Set between a decided round and the next one
+     uint8_t    epoch;                         ///< Changes on start() and reset(); stale timers compare it
+     uint32_t   playedAt;                      ///< millis() when play() armed the mode's timers
+
+     // Vest-local damage, renewed by start()
+     uint32_t   hitNonce[GAME_MAX_PLAYERS];    ///< Nonce of each player's hit table
+     uint32_t   hitKeys[GAME_MAX_PLAYERS][4];  ///< Key of each player's vest for signing hit reports, derived from the nonce
+     uint16_t   reportSeq[GAME_MAX_PLAYERS];   ///< Last hit report number accepted from each vest
+
+     /** @brief Construct a waiting two-player match. */
+     Match();
+
+     /**
+      * @brief Set how many players take part (clamped to GAME_MAX_PLAYERS).
+      * @param count Number of players
+      */
+     void setPlayerCount(uint8_t count);
  
+     /**
+      * @brief Assign a player to a team.
+      * @param who    Player number (1..playerCount)
+      * @param teamID Team identifier (non-zero)
+      */
+     void setTeam(uint8_t who, uint8_t teamID);
+
      /** @brief Get the current game status. */
-     GameStatus getStatus();
+     GameStatus getStatus() const { return status; }
+
+     /**
+      * @brief Change the game status and log the transition.
+      *
+      * The Manager's GameFlow of this match calls this after every transition.
+      * @param newStatus Status to enter
+      */
+     void setStatus(GameStatus newStatus);
  
      /**
-      * @brief Determine if a received fireSignal matches the opponent’s expected code.
-      * @param fireSignal The NEC_DATA received
-      * @param who        Player number (1 or 2) we are testing against
-      * @return True if signal indicates a hit by the other player
+      * @brief Determine if a received fireSignal carries the shooter ID of an opponent.
+      * @param fireSignal The NEC_DATA received (raw tag frame for IR_PROTOCOL_TAG)
+      * @param who        Player number (1..playerCount) we are testing against
+      * @return True if signal indicates a hit by a player of another team
       */
-     bool hasPlayerHit(NEC_DATA fireSignal, uint8_t who);
+     bool hasPlayerHit(NEC_DATA fireSignal, uint8_t who) const;
  
      /**
       * @brief Process an incoming hit signal and apply damage if valid.
-      * @param id         DeviceID from which the signal originated
+      *
+      * Each shot counts once: a shot counter already seen from that shooter
+      * (for example reported again by another receiver) is ignored.
+      * Valid hits update both players' statistics and are logged with the
+      * victim's new HP. The damage is one damageTable entry. Accepted hits
+      * are passed to Game::onHit.
+      * @param deviceID   DeviceID from which the signal originated
       * @param fireSignal NEC_DATA payload of the signal
+      * @param receivers  Vest receivers that decoded the shot (0 = not reported)
       * @return True if hit was processed and damage applied
       */
-     bool processHit(uint8_t id, NEC_DATA fireSignal);
+     bool processHit(uint8_t deviceID, NEC_DATA fireSignal, uint8_t receivers = 0);
+
+     /**
+      * @brief Process the hits of a vest's batch in the order they were decoded.
+      * @param deviceID DeviceID of the vest
+      * @param batch    Received batch
+      * @return Number of hits that applied damage (see processHit())
+      */
+     uint8_t processBatch(uint8_t deviceID, const HitBatch &batch);
+
+     /**
+      * @brief Fill the hit table sent to a player's vest at game start.
+      *
+      * Lists the shooter ID and damage of every player of another team, the
+      * nonce the vest derives its signing key from and whether the vest
+      * applies hits locally.
+      * @param index Player index
+      * @param table Output table
+      */
+     void buildHitTable(uint8_t index, HitTable &table) const;
+
+     /**
+      * @brief Pick a new hit table nonce for a player and derive its vest's key.
+      * @param index Player index
+      */
+     void renewHitKey(uint8_t index);
+
+     /**
+      * @brief Authenticate a hit report of a vest that applied the hit itself.
+      *
+      * The report must carry the tag of that vest's key and a newer report
+      * number than the last one accepted, so a replayed or forged report is
+      * dropped. An accepted report still has to pass processHit().
+      * @param deviceID DeviceID of the reporting vest
+      * @param report   Received report
+      * @return True if the report is authentic and new
+      */
+     bool acceptHitReport(uint8_t deviceID, const HitReport &report);
  
-     /** @brief Check if both players have valid equipment to start the game. */
-     bool canStart();
+     /**
+      * @brief Check if the players have valid equipment to start the game.
+      *
+      * Some player's gun must be able to hit a vest of another team, and no
+      * gun or vest may be assigned to two players.
+      */
+     bool canStart() const;
  
-     /** @brief Check if the game should end (a player’s HP reached zero). */
-     bool shouldEnd();
+     /** @brief Check if the game should end, as decided by the game mode. */
+     bool shouldEnd() const { return rules->shouldEnd(*this); }
+
+     /**
+      * @brief Select the game mode; takes effect with the next start().
+      * @param newRules Mode to play (must outlive the match)
+      */
+     void setRules(const GameRules &newRules) { rules = &newRules; }
+
+     /**
+      * @brief Select the damage model; takes effect with the next start().
+      * @param model Model to use (must outlive the match)
+      */
+     void setDamageModel(const DamageModel &model) { damageModel = &model; }
+
+     /**
+      * @brief Raise a player's damage for the damage model's buffDuration.
+      *
+      * A new buff replaces the active one and restarts its clock.
+      * @param index Player index
+      * @param level Buff level (1..DAMAGE_BUFF_LEVELS-1, 0 ends the buff)
+      */
+     void buff(uint8_t index, uint8_t level);
+
+     /**
+      * @brief Arm the game mode's timers; entry action of GAME_RUNNING on the Manager.
+      */
+     void play() {
+         playedAt = millis();
+         rules->onPlay(*this);
+     }
+
+     /**
+      * @brief Continue a match whose state was taken over from another Manager.
+      *
+      * Rebuilds the lookup tables, draws new hit report keys (the vests need
+      * new hit tables), restarts the statistics and re-arms the game mode's
+      * timers for the time left since playedAt (see Rules::resume()).
+      */
+     void resume();
+
+     /**
+      * @brief Check if at most one team still has living players.
+      * @param survivor Set to that team's ID, or 0 if nobody lives
+      */
+     bool oneTeamLeft(uint8_t &survivor) const;
+
+     /**
+      * @brief Team with the most remaining HP.
+      * @return Team ID, or 0 on draw
+      */
+     uint8_t teamWithMostHP() const;
+
+     /**
+      * @brief Team with the highest teamScore.
+      * @return Team ID, or 0 on draw
+      */
+     uint8_t teamWithTopScore() const;
  
-     /** @brief Reset game status and reload default weapon loadouts. */
+     /** @brief Reset game status, IR protocol and default weapon loadouts. */
      void reset();
  
      /**
-      * @brief Begin the pre-game sequence:
-      *  - Transition status to GAME_STARTING
-      *  - Reset HP for both players
-      *  - Generate two distinct NEC fireSignals for each player
+      * @brief Prepare a match; entry action of GAME_STARTING on the Manager:
+      *  - Reset HP and statistics of all players
+      *  - Take shooter IDs from the fire code table, rotated per match start,
+      *    and build each player's fire code
+      *  - Rebuild the device and shooter lookup tables
+      *  - Clear scores and protection, and cancel the timers of the last match
+      *  - Draw new hit report keys for the vests
+      *  - Compile the damage model into damageTable and clear buffs
       */
      void start();
+
+     /**
+      * @brief Rebuild everything derived from the players' configuration:
+      *  - the device and shooter lookup tables (from the assigned devices and fireSignals)
+      *  - teamLead
+      *  - damageTable (from gunDamage and the damage model)
+      */
+     void buildTables();
  
-     /** @brief Enter active play state (GAME_RUNNING). */
-     void run();
+     /**
+      * @brief Store and log the number of shots a gun reported at the end of a game.
+      * @param deviceID DeviceID of the gun
+      * @param shots    Shots fired during the game
+      * @return False if the gun belongs to no player
+      */
+     bool recordShots(uint8_t deviceID, uint32_t shots);
  
-     /** @brief End the game and set status to GAME_OVER. */
-     void end();
+     /**
+      * @brief Fraction of a player's shots that hit.
+      *
+      * Until the gun reports its count, shots are inferred from the shot
+      * counters seen in hits.
+      * @param who Player number (1..playerCount)
+      * @return Accuracy in [0, 1], or 0 if no shots are known
+      */
+     float getAccuracy(uint8_t who) const;
+ 
+     /**
+      * @brief Determine the winning team, as decided by the game mode.
+      *
+      * In a free-for-all the team ID is the player ID.
+      *
+      * @return Team ID of the winner, or 0 on draw
+      */
+     uint8_t getWinner() const { return rules->getWinner(*this); }
+
+ private:
+     uint8_t    seenShots[GAME_MAX_PLAYERS][32]; ///< Shots already counted, one bit per shot counter value
+ };
+
+ /**
+  * @namespace Game
+  * @brief Matches hosted by the Manager and the fire code helpers shared by all devices.
+  *
+  * Packets are routed to their match in constant time through projectToMatch,
+  * indexed by the sender's Nexus project ID. The GUI shows one match at a
+  * time (current()).
+  */
+ namespace Game {
+     extern Match   matches[GAME_MAX_MATCHES];  ///< Independent matches
+     extern uint8_t selected;                   ///< Index of the match shown by the GUI
+     extern uint8_t matchNumber;                ///< Next fire code coset (0..FIRE_CODE_COSETS-1), advanced by every match start
+     extern uint8_t projectToMatch[256];        ///< Nexus project ID -> match index (GAME_NO_MATCH if none)
+
+     extern void (* onRespawn)(Match &match, uint8_t who); ///< Called when a player of a running match respawned
+     extern void (* onNewRound)(Match &match);             ///< Called when all players of a running match were restored for a round
+     extern void (* onHit)(Match &match, uint8_t victim, uint8_t attacker, uint16_t damage); ///< Called for every hit processHit() accepted
+
+     /**
+      * @brief Give every match its project ID and build the routing table.
+      * @param firstProject Project ID of match 0; match k uses firstProject + k
+      */
+     void begin(uint8_t firstProject);
+
+     /** @brief Match shown by the GUI. */
+     inline Match& current() { return matches[selected]; }
+
+     /**
+      * @brief Choose the match shown by the GUI.
+      * @param index Match index (0..GAME_MAX_MATCHES-1)
+      */
+     void select(uint8_t index);
+
+     /**
+      * @brief Match whose devices use a Nexus project.
+      * @param projectID Project ID of a packet's source
+      * @return Match, or nullptr if the project belongs to no match
+      */
+     inline Match* matchFor(uint8_t projectID) {
+         uint8_t index = projectToMatch[projectID];
+         return index == GAME_NO_MATCH ? nullptr : &matches[index];
+     }
+
+     /**
+      * @brief Build the fire code of one shot.
+      *
+      * NEC frames carry the shooter ID as address and the shot counter as
+      * command (each followed by its inverse); tag frames carry the same two
+      * bytes plus a CRC-4.
+      *
+      * @param protocol IR protocol the gun shoots with
+      * @param shooter  Shooter ID
+      * @param shot     Rolling shot counter
+      * @return Raw frame bits for that protocol
+      */
+     uint32_t encodeFireCode(IRprotocolID protocol, uint8_t shooter, uint8_t shot);
  
      /**
-      * @brief Determine the winner based on remaining HP.
-      * @return Player ID of the winner, or 0 on draw
+      * @brief Split a received fire code into shooter ID and shot counter.
+      * @param protocol IR protocol the code was received with
+      * @param code     Raw frame bits
+      * @param shooter  Output shooter ID
+      * @param shot     Output shot counter
+      * @return False if the code fails the protocol's integrity check
       */
-     uint8_t getWinner();
+     bool decodeFireCode(IRprotocolID protocol, uint32_t code, uint8_t &shooter, uint8_t &shot);
  }
  
  #endif // GAME_HPP
\ No newline at end of file
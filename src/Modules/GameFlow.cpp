@@ -0,0 +1,19 @@
+/**
+ * @file GameFlow.cpp
+ * @brief The game flow shared by the Manager, the Guns and the Vests.
+ */
+
+ #include "GameFlow.hpp"
+
+ const GameState gameStates[GameStatus_size] = {
+     /* GAME_WAITING  */ { 0,                      GAME_WAITING  },
+     /* GAME_STARTING */ { 0,                      GAME_STARTING },
+     /* GAME_THREE    */ { GAME_COUNTDOWN_STEP_MS, GAME_TWO      },
+     /* GAME_TWO      */ { GAME_COUNTDOWN_STEP_MS, GAME_ONE      },
+     /* GAME_ONE      */ { GAME_COUNTDOWN_STEP_MS, GAME_GO       },
+     /* GAME_GO       */ { GAME_COUNTDOWN_STEP_MS, GAME_RUNNING  },
+     /* GAME_RUNNING  */ { 0,                      GAME_RUNNING  },
+     /* GAME_OVER     */ { GAME_RESULTS_DELAY_MS,  GAME_WON      },
+     /* GAME_WON      */ { 0,                      GAME_WON      },
+     /* GAME_LOST     */ { 0,                      GAME_LOST     }
+ };
@@ -0,0 +1,122 @@
+/**
+ * @file GameFlow.hpp
+ * @brief Table-driven state machine over GameStatus with entry/exit actions and timed transitions.
+ *
+ * One shared table, gameStates, says how long every GameStatus lasts and
+ * which status follows it; every device runs its flow over that table.
+ * A device only binds its own entry/exit actions, one GameActions row per
+ * status. A transition runs the exit action of the old row and the entry
+ * action of the new one; a status with a timeout moves on to its next
+ * status by itself once loop() sees the time elapse, so no device blocks
+ * with delay(). Actions receive the flow's parameter, e.g. the match index
+ * when one table drives several matches.
+ */
+
+ #ifndef GAMEFLOW_HPP
+ #define GAMEFLOW_HPP
+
+ #include <Arduino.h>
+ #include "Game.hpp"
+
+ #define GAME_COUNTDOWN_STEP_MS 1000 ///< Time per countdown step, 3-2-1-GO (ms)
+ #define GAME_RESULTS_DELAY_MS  3000 ///< Time from GAME_OVER to the results, for the Guns to report shots (ms)
+
+ /**
+  * @struct GameState
+  * @brief One row of the gameStates table.
+  */
+ struct GameState {
+     uint32_t   timeout; ///< Time in this status before moving to next (ms, 0 = stay)
+     GameStatus next;    ///< Status entered when the timeout elapses
+ };
+
+ /**
+  * @brief Game flow of every device, indexed by GameStatus.
+  *
+  * The countdown steps once a second and GAME_OVER moves on to GAME_WON
+  * (on the Manager: results announced) after GAME_RESULTS_DELAY_MS.
+  */
+ extern const GameState gameStates[GameStatus_size];
+
+ /**
+  * @struct GameActions
+  * @brief What one device does when it enters or leaves a status.
+  */
+ struct GameActions {
+     void (*onEnter)(GameStatus status, int parameter); ///< Entry action (nullptr = none)
+     void (*onExit)(GameStatus status, int parameter);  ///< Exit action (nullptr = none)
+ };
+
+ /**
+  * @class GameFlow
+  * @brief Drives a GameStatus variable through gameStates.
+  *
+  * The flow works on a status variable owned by the caller, so code that
+  * only reads the status keeps working. If the variable is changed directly
+  * (e.g. by Game::reset()), the pending timeout is dropped. Only the device
+  * that times the match (the Manager) calls loop(); Guns and Vests follow
+  * the status the Manager sends, so a loser never shows GAME_WON on its own.
+  */
+ class GameFlow {
+ public:
+     /**
+      * @brief Construct a flow.
+      * @param actions      Table with GameStatus_size rows, indexed by GameStatus
+      * @param status       Status variable to drive
+      * @param onTransition Called after every transition with the new status (optional)
+      * @param parameter    Passed to every action and to onTransition
+      */
+     GameFlow(const GameActions *actions, GameStatus &status,
+              void (*onTransition)(GameStatus, int) = nullptr, int parameter = 0)
+       : actions(actions), status(status), onTransition(onTransition), parameter(parameter),
+         timedStatus(GameStatus_size), enteredAt(0) {}
+
+     /**
+      * @brief Move to a new status.
+      *
+      * Does nothing if @p next is the current status.
+      * @param next Status to enter
+      * @return True if a transition took place
+      */
+     bool enter(GameStatus next) {
+         if (next == status || next >= GameStatus_size) return false;
+
+         const GameActions &from = actions[status];
+         if (from.onExit) from.onExit(status, parameter);
+
+         status = next;
+         enteredAt = millis();
+         timedStatus = gameStates[next].timeout ? next : GameStatus_size;
+         const GameActions &to = actions[next];
+         if (to.onEnter) to.onEnter(next, parameter);
+         if (onTransition) onTransition(next, parameter);
+         return true;
+     }
+
+     /**
+      * @brief Fires the timed transition of the current status when due; the Manager calls it every loop.
+      */
+     void loop() {
+         if (timedStatus != status) {
+             timedStatus = GameStatus_size; // Changed from outside: forget the timer
+             return;
+         }
+         const GameState &row = gameStates[status];
+         if (millis() - enteredAt >= row.timeout) {
+             enter(row.next);
+         }
+     }
+
+     /** @brief Current status. */
+     GameStatus getStatus() const { return status; }
+
+ private:
+     const GameActions *actions;             ///< Device actions indexed by GameStatus
+     GameStatus      &status;                ///< Driven status variable
+     void           (*onTransition)(GameStatus, int); ///< Transition observer
+     int              parameter;             ///< Passed to actions and the observer
+     GameStatus       timedStatus;           ///< Status whose timeout is armed (GameStatus_size = none)
+     uint32_t         enteredAt;             ///< Time the current status was entered (ms)
+ };
+
+ #endif // GAMEFLOW_HPP
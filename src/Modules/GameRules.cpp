@@ -0,0 +1,168 @@
+/**
+ * @file GameRules.cpp
+ * @brief Implementation of the built-in game modes and their scheduled events.
+ */
+
+ #include "GameRules.hpp"
+ #include "Game.hpp"
+ #include "Utilities/Countdowner.hpp"
+
+ namespace Rules {
+
+     static_assert(GAME_MAX_MATCHES <= 16 && GAME_MAX_PLAYERS <= 16, "Timer tags pack match and player in 4 bits each");
+
+     /** Break between rounds when a mode sets no respawnDelay (ms). */
+     static const uint32_t ROUND_BREAK = 3000;
+
+     // A Countdowner event carries one int: epoch << 8 | match << 4 | player
+     static int timerTag(const Match &match, uint8_t who) {
+         return (match.epoch << 8) | (match.id << 4) | who;
+     }
+
+     // Match of a timer tag, or nullptr if the match restarted or stopped running since
+     static Match *timerMatch(int tag) {
+         Match &match = Game::matches[(tag >> 4) & 0x0F];
+         if (uint8_t(tag >> 8) != match.epoch || match.status != GAME_RUNNING) return nullptr;
+         return &match;
+     }
+
+     // ------------------------------ Timers ------------------------------
+
+     static void onTimeUp(int tag) {
+         Match *match = timerMatch(tag);
+         if (match) match->timeUp = true;
+     }
+
+     static void onProtectionEnd(int tag) {
+         Match *match = timerMatch(tag);
+         if (match) match->protectedMask &= ~(1UL << (tag & 0x0F));
+     }
+
+     static void onAllProtectionEnd(int tag) {
+         Match *match = timerMatch(tag);
+         if (match) match->protectedMask = 0;
+     }
+
+     static void onRespawnDue(int tag) {
+         Match *match = timerMatch(tag);
+         if (!match) return;
+         uint8_t who = tag & 0x0F;
+         match->players[who].resetHP();
+         match->stats[who].heal();
+         MatchLog::append(match->id, MATCH_EVENT_HP, who, MATCH_LOG_NONE, 0, match->players[who].getHP());
+         // Stay protected for the invulnerability window
+         countdowner->addEvent(match->rules->invulnerability, onProtectionEnd, tag);
+         if (Game::onRespawn) Game::onRespawn(*match, who);
+     }
+
+     static void onRoundDue(int tag) {
+         Match *match = timerMatch(tag);
+         if (!match) return;
+         match->roundBreak = false;
+         for (uint8_t i = 0; i < match->playerCount; i++) {
+             match->players[i].resetHP();
+             match->stats[i].heal();
+         }
+         MatchLog::append(match->id, MATCH_EVENT_HP, MATCH_LOG_NONE, MATCH_LOG_NONE, 0, match->players[0].getHP());
+         // Everybody stays protected for the invulnerability window
+         countdowner->addEvent(match->rules->invulnerability, onAllProtectionEnd, tag);
+         if (Game::onNewRound) Game::onNewRound(*match);
+     }
+
+     // --------------------------- Rule actions ---------------------------
+
+     static void noTimers(Match &) {}
+
+     static void startClock(Match &match) {
+         if (match.rules->duration) {
+             countdowner->addEvent(match.rules->duration, onTimeUp, timerTag(match, 0));
+         }
+     }
+
+     static void noKillAction(Match &, uint8_t, uint8_t) {}
+
+     // The killer's team scores; the victim cannot be hit until it respawned and its protection ended
+     static void scoreAndRespawn(Match &match, uint8_t victim, uint8_t killer) {
+         uint16_t score = ++match.teamScore[match.teamLead[killer]];
+         if (score > match.topScore) match.topScore = score;
+         match.protectedMask |= 1UL << victim;
+         countdowner->addEvent(match.rules->respawnDelay, onRespawnDue, timerTag(match, victim));
+     }
+
+     // When one team is left the round goes to it; nobody can be hit until the next round
+     static void scoreRound(Match &match, uint8_t, uint8_t) {
+         uint8_t survivor;
+         if (!match.oneTeamLeft(survivor)) return;
+         if (survivor) {
+             for (uint8_t i = 0; i < match.playerCount; i++) {
+                 if (match.team[i] != survivor) continue;
+                 uint16_t score = ++match.teamScore[match.teamLead[i]];
+                 if (score > match.topScore) match.topScore = score;
+                 break;
+             }
+         }
+         if (match.topScore >= match.rules->scoreLimit) return;
+         match.protectedMask = ~0U;
+         match.roundBreak = true;
+         uint32_t pause = match.rules->respawnDelay ? match.rules->respawnDelay : ROUND_BREAK;
+         countdowner->addEvent(pause, onRoundDue, timerTag(match, 0));
+     }
+
+     static bool oneTeamLeft(const Match &match) {
+         uint8_t survivor;
+         return match.oneTeamLeft(survivor);
+     }
+
+     static bool clockOrLimit(const Match &match) {
+         return match.timeUp || (match.rules->scoreLimit && match.topScore >= match.rules->scoreLimit);
+     }
+
+     static bool limitReached(const Match &match) {
+         return match.topScore >= match.rules->scoreLimit;
+     }
+
+     static uint8_t mostHP(const Match &match) { return match.teamWithMostHP(); }
+
+     static uint8_t topScore(const Match &match) { return match.teamWithTopScore(); }
+
+     // ------------------------------ Takeover ------------------------------
+
+     void resume(Match &match) {
+         const GameRules &rules = *match.rules;
+         if (rules.duration) {
+             uint32_t elapsed = millis() - match.playedAt;
+             if (elapsed >= rules.duration) match.timeUp = true;
+             else countdowner->addEvent(rules.duration - elapsed, onTimeUp, timerTag(match, 0));
+         }
+
+         // A break between rounds protects everybody until the next round starts
+         if (match.roundBreak) {
+             uint32_t pause = rules.respawnDelay ? rules.respawnDelay : ROUND_BREAK;
+             countdowner->addEvent(pause, onRoundDue, timerTag(match, 0));
+             return;
+         }
+         for (uint8_t i = 0; i < match.playerCount; i++) {
+             if (!((match.protectedMask >> i) & 1)) continue;
+             if (match.players[i].isAlive()) {
+                 countdowner->addEvent(rules.invulnerability, onProtectionEnd, timerTag(match, i));
+             } else {
+                 countdowner->addEvent(rules.respawnDelay, onRespawnDue, timerTag(match, i));
+             }
+         }
+     }
+
+     // ------------------------------- Modes -------------------------------
+
+     //                                 name             duration  respawn invuln limit
+     const GameRules lastStanding = { "Last Standing",  0,        0,      0,     0,
+                                      noTimers, noKillAction, oneTeamLeft, mostHP };
+     const GameRules deathmatch   = { "Deathmatch",     300000,   5000,   3000,  0,
+                                      startClock, scoreAndRespawn, clockOrLimit, topScore };
+     const GameRules scoreLimit   = { "Score Limit",    0,        5000,   3000,  10,
+                                      startClock, scoreAndRespawn, clockOrLimit, topScore };
+     const GameRules bestOfThree  = { "Best of 3",      0,        3000,   0,     2,
+                                      noTimers, scoreRound, limitReached, topScore };
+
+     const GameRules *const modes[] = { &lastStanding, &deathmatch, &scoreLimit, &bestOfThree };
+     const uint8_t modeCount = sizeof(modes) / sizeof(modes[0]);
+ }
@@ -0,0 +1,68 @@
+/**
+ * @file GameRules.hpp
+ * @brief Game modes as pluggable rule objects: last team standing, timed deathmatch, score limit, rounds.
+ *
+ * A Match holds a pointer to one GameRules object. Match::processHit() calls
+ * the mode's onKill() only when a hit kills, and Match::shouldEnd() and
+ * getWinner() call through the pointer, so the hit path has no per-mode
+ * branches. Respawns, round breaks, invulnerability and the match clock are
+ * Countdowner events; an event that outlives its match (restart or reset) is
+ * recognised by the match epoch and ignored.
+ */
+
+ #ifndef GAMERULES_HPP
+ #define GAMERULES_HPP
+
+ #include <Arduino.h>
+
+ class Match;
+
+ /**
+  * @struct GameRules
+  * @brief Parameters and behaviour of one game mode.
+  */
+ struct GameRules {
+     const char *name;          ///< Shown in the GUI
+     uint32_t duration;         ///< Match length (ms, 0 = until decided)
+     uint32_t respawnDelay;     ///< Time dead before respawn, or break between rounds (ms)
+     uint32_t invulnerability;  ///< Protection after a respawn or round start (ms)
+     uint16_t scoreLimit;       ///< Kills (or rounds) a team needs to win (0 = no limit)
+
+     void    (*onPlay)(Match &match);                                ///< Arms the mode's timers on GAME_RUNNING
+     void    (*onKill)(Match &match, uint8_t victim, uint8_t killer); ///< A hit reduced the victim to 0 HP
+     bool    (*shouldEnd)(const Match &match);                       ///< True once the match is decided
+     uint8_t (*getWinner)(const Match &match);                       ///< Winning team ID (0 = draw)
+ };
+
+ /**
+  * @namespace Rules
+  * @brief Built-in game modes.
+  */
+ namespace Rules {
+     /** Eliminated players stay out; the last team with a living player wins. */
+     extern const GameRules lastStanding;
+     /** Kills score for the killer's team, the dead respawn; most kills after 5 minutes wins. */
+     extern const GameRules deathmatch;
+     /** Like deathmatch without a clock: the first team to 10 kills wins. */
+     extern const GameRules scoreLimit;
+     /** Last-standing rounds; the first team to win 2 rounds wins. */
+     extern const GameRules bestOfThree;
+
+     /** All built-in modes, in the order the GUI cycles through them. */
+     extern const GameRules *const modes[];
+     /** Number of entries in modes. */
+     extern const uint8_t modeCount;
+
+     /**
+      * @brief Re-arms the timers of a running match taken over from another Manager.
+      *
+      * The clock gets the time left since match.playedAt. Players that are
+      * protected wait out a full respawn delay (dead) or invulnerability
+      * window (alive), or a full round break if match.roundBreak is set,
+      * since the time already spent was lost with the other Manager.
+      * @param match Running match, with a new epoch
+      */
+     void resume(Match &match);
+ }
+
+ #endif // GAMERULES_HPP
@@ -0,0 +1,159 @@
+/**
+ * @file HitReport.hpp
+ * @brief Payloads of the hit table a Vest receives at game start, its hit batches and its signed hit reports.
+ *
+ * At game start the Manager sends each Vest the shooter IDs of its
+ * opponents, their damage and a fresh nonce. The Vest forwards only
+ * fire codes of those shooters, so remote controls, its own gun, teammates
+ * and other arenas cost no airtime. With local damage the Vest also applies
+ * a hit and plays its animation as soon as the fire code is decoded, and
+ * reports the hit to the Manager with a SipHash tag. The Manager verifies
+ * the tag, runs the hit through Match::processHit() as usual and corrects
+ * the Vest's HP when its own result differs, so it keeps the final say.
+ *
+ * ESP-NOW frames are broadcast in the clear, so the signing key never goes
+ * on air: both sides derive it from HIT_REPORT_SECRET, the arena, the
+ * Vest's deviceID and the nonce (see deriveHitKey()). A listener learns
+ * the nonce but cannot sign a report.
+ *
+ * The gun of the shooter learns of every accepted hit from a HitMarker,
+ * sent by the Vest itself with local damage (one hop, using the gun IDs of
+ * the hit table) and by the Manager otherwise.
+ *
+ * Without local damage the Vest gathers the hits of a short window (a
+ * burst, or one shot seen by several receivers) into one HitBatch, so a
+ * burst costs one frame.
+ */
+
+ #ifndef HITREPORT_HPP
+ #define HITREPORT_HPP
+
+ #include <Arduino.h>
+ #include "Utilities/SipHash.hpp"
+ #include "DamageModel.hpp"
+
+ /** Opponents one hit table can list. */
+ #define HIT_TABLE_SIZE 16
+ /** Hit table entry of an opponent without a gun. */
+ #define HIT_NO_GUN 0xFF
+ /** Hits one batch can carry. */
+ #define HIT_BATCH_SIZE 8
+
+ /**
+  * @struct HitTable
+  * @brief Opponents of one Vest's player and the nonce of its hit report key (COMMS_HITTABLE).
+  *
+  * The shooter IDs are the Vest's accept-set: hits of other shooters are dropped.
+  */
+ struct __attribute__((packed)) HitTable {
+     uint32_t nonce;                     ///< Input of deriveHitKey(), new every match
+     uint8_t  localDamage;               ///< Non-zero: apply hits locally and send HitReports
+     uint8_t  count;                     ///< Valid entries in shooter and damage
+     uint8_t  shooter[HIT_TABLE_SIZE];   ///< Shooter IDs of the opponents
+     uint8_t  gun[HIT_TABLE_SIZE];       ///< Gun deviceID of each opponent (HIT_NO_GUN if none)
+     uint16_t damage[HIT_TABLE_SIZE];    ///< Weapon damage of each opponent
+     uint8_t  maskPercent[DAMAGE_MASKS]; ///< Zone and range percent per receiver mask (see Damage::scale())
+ };
+
+ /**
+  * @struct HitAcceptSet
+  * @brief Shooter IDs of a hit table as a 256-bit set, for an O(1) check per decoded frame.
+  */
+ struct HitAcceptSet {
+     uint32_t bits[8]; ///< Bit per shooter ID
+
+     /** @brief Replaces the set with the shooters of @p table. */
+     void load(const HitTable &table) {
+         memset(bits, 0, sizeof(bits));
+         for (uint8_t i = 0; i < table.count && i < HIT_TABLE_SIZE; i++) {
+             bits[table.shooter[i] >> 5] |= 1UL << (table.shooter[i] & 31);
+         }
+     }
+
+     /** @brief True if @p shooter is listed. */
+     bool contains(uint8_t shooter) const { return (bits[shooter >> 5] >> (shooter & 31)) & 1; }
+ };
+
+ /**
+  * @struct BatchedHit
+  * @brief One hit of a HitBatch.
+  */
+ struct __attribute__((packed)) BatchedHit {
+     uint32_t code;      ///< Received fire code
+     uint16_t offset;    ///< Decode time after the first hit of the batch (ms)
+     uint8_t  receivers; ///< Bit i set if receiver i decoded the shot
+ };
+
+ /**
+  * @struct HitBatch
+  * @brief Hits a Vest gathered within its coalescing window (COMMS_HITBATCH).
+  */
+ struct __attribute__((packed)) HitBatch {
+     uint8_t    count;                 ///< Valid entries in hits
+     BatchedHit hits[HIT_BATCH_SIZE];  ///< Hits in the order they were decoded
+ };
+
+ /**
+  * @struct HitReport
+  * @brief A hit the Vest already applied, for the Manager to reconcile (COMMS_HITREPORT).
+  */
+ struct __attribute__((packed)) HitReport {
+     uint32_t code;      ///< Received fire code
+     int32_t  hp;        ///< HP of the Vest after applying the hit
+     uint8_t  receivers; ///< Receivers that decoded the shot
+     uint16_t seq;       ///< Report number, counting from 1 every match
+     uint64_t tag;       ///< SipHash-2-4 of the fields above under the table's key
+ };
+
+ /**
+  * @struct HitMarker
+  * @brief Confirmation to the shooter's gun that one of its shots hit (COMMS_HITMARKER).
+  */
+ struct __attribute__((packed)) HitMarker {
+     uint16_t damage; ///< Damage the hit dealt
+     uint8_t  kill;   ///< Non-zero if the hit left the victim at 0 HP
+ };
+
+ /**
+  * @brief Derives the key a Vest signs its hit reports with.
+  *
+  * Two SipHash-2-4 tags under the pre-shared secret, over the Vest's
+  * address and the nonce of its hit table, give the 128-bit key.
+  * @param secret    HIT_REPORT_SECRET
+  * @param projectID Nexus project (arena) of the Vest
+  * @param deviceID  deviceID of the Vest
+  * @param nonce     Nonce of the Vest's hit table
+  * @param key       Derived key
+  */
+ inline void deriveHitKey(const uint32_t secret[4], uint8_t projectID, uint8_t deviceID,
+                          uint32_t nonce, uint32_t key[4]) {
+     uint8_t message[7] = { projectID, deviceID,
+                            uint8_t(nonce), uint8_t(nonce >> 8), uint8_t(nonce >> 16), uint8_t(nonce >> 24), 0 };
+     for (uint8_t half = 0; half < 2; half++) {
+         message[6] = half;
+         uint64_t tag = SipHash::hash(secret, message, sizeof(message));
+         key[2 * half]     = uint32_t(tag);
+         key[2 * half + 1] = uint32_t(tag >> 32);
+     }
+ }
+
+ /**
+  * @brief Signs a hit report.
+  * @param report Report whose tag is set
+  * @param key    Key derived from the Vest's hit table
+  */
+ inline void signHitReport(HitReport &report, const uint32_t key[4]) {
+     report.tag = SipHash::hash(key, (const uint8_t*)&report, offsetof(HitReport, tag));
+ }
+
+ /**
+  * @brief Checks the tag of a hit report.
+  * @param report Received report
+  * @param key    Key derived for the Vest
+  * @return True if the report was signed with @p key and not altered
+  */
+ inline bool verifyHitReport(const HitReport &report, const uint32_t key[4]) {
+     return report.tag == SipHash::hash(key, (const uint8_t*)&report, offsetof(HitReport, tag));
+ }
+
+ #endif // HITREPORT_HPP
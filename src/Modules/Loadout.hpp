@@ -0,0 +1,130 @@
+/**
+ * @file Loadout.hpp
+ * @brief Content-addressed loadouts, so a Gun receives each loadout only once.
+ *
+ * A Loadout is the blob a Gun needs to play a weapon; it is named by the
+ * SipHash of its bytes. At game start the Manager sends each Gun one
+ * GunStart frame with its HP, IR protocol, fire code and the hash of its
+ * loadout. A Gun that holds the blob in its LoadoutCache applies it at
+ * once; otherwise it asks for the blob with COMMS_LOADOUT_REQUEST and the
+ * Manager answers with COMMS_LOADOUT. The Gun checks the hash of what it
+ * received before it caches it, so a blob is never taken for another one.
+ *
+ * Repeat matches with the same loadouts start with one GunStart per Gun,
+ * however large the loadout grows.
+ */
+
+ #ifndef LOADOUT_HPP
+ #define LOADOUT_HPP
+
+ #include <Arduino.h>
+ #include "Utilities/SipHash.hpp"
+ #include "Player.hpp"
+
+ /** Loadouts a Gun keeps. */
+ #define LOADOUT_CACHE_SIZE 4
+ /** A Gun repeats an unanswered loadout request after this long (ms). */
+ #define LOADOUT_RETRY_MS 250
+
+ /**
+  * @struct Loadout
+  * @brief Everything a Gun needs to play a weapon (COMMS_LOADOUT).
+  */
+ struct __attribute__((packed)) Loadout {
+     GunData gunData;                  ///< Weapon parameters
+     char    name[MAX_GUN_NAME_LENGTH]; ///< Weapon name, zero-padded
+ };
+
+ /**
+  * @struct GunStart
+  * @brief Game start data of one Gun (COMMS_GUNSTART).
+  */
+ struct __attribute__((packed)) GunStart {
+     int32_t  hp;         ///< Initial HP
+     uint8_t  irProtocol; ///< IRprotocolID of the game
+     uint32_t fireCode;   ///< Fire code carrying the player's shooter ID
+     uint64_t loadout;    ///< Hash of the player's Loadout
+ };
+
+ /**
+  * @brief Names a loadout by its content.
+  * @param loadout Loadout with a zero-padded name
+  * @return SipHash-2-4 of its bytes under a zero key
+  */
+ inline uint64_t loadoutHash(const Loadout &loadout) {
+     static const uint32_t key[4] = { 0, 0, 0, 0 };
+     return SipHash::hash(key, (const uint8_t*)&loadout, sizeof(loadout));
+ }
+
+ /**
+  * @brief Builds the loadout of a player.
+  * @param player  Player whose weapon is described
+  * @param loadout Output loadout
+  */
+ inline void playerLoadout(const Player &player, Loadout &loadout) {
+     memset(&loadout, 0, sizeof(loadout));
+     loadout.gunData = player.getGunData();
+     strncpy(loadout.name, player.getGunNameRaw(), MAX_GUN_NAME_LENGTH - 1);
+ }
+
+ /**
+  * @class LoadoutCache
+  * @brief The last LOADOUT_CACHE_SIZE loadouts a Gun used, by hash.
+  *
+  * When full, storing a loadout replaces the one used longest ago.
+  */
+ class LoadoutCache {
+ public:
+     LoadoutCache() : count(0), clock(0) {}
+
+     /**
+      * @brief Looks up a loadout and marks it as used.
+      * @param hash    Hash of the loadout
+      * @param loadout Output, set on a hit
+      * @return True on a hit
+      */
+     bool find(uint64_t hash, Loadout &loadout) {
+         for (uint8_t i = 0; i < count; i++) {
+             if (hashes[i] != hash) continue;
+             used[i] = ++clock;
+             loadout = blobs[i];
+             return true;
+         }
+         return false;
+     }
+
+     /**
+      * @brief Stores a loadout under its hash.
+      *
+      * A hash already cached is updated in place, so a repeated answer
+      * never evicts another entry.
+      * @param hash    Hash of @p loadout (see loadoutHash())
+      * @param loadout Loadout to keep
+      */
+     void store(uint64_t hash, const Loadout &loadout) {
+         uint8_t slot = 0;
+         while (slot < count && hashes[slot] != hash) slot++;
+         if (slot == count) {
+             if (count < LOADOUT_CACHE_SIZE) {
+                 count++;
+             } else {
+                 slot = 0;
+                 for (uint8_t i = 1; i < count; i++) {
+                     if (used[i] < used[slot]) slot = i;
+                 }
+             }
+         }
+         hashes[slot] = hash;
+         blobs[slot]  = loadout;
+         used[slot]   = ++clock;
+     }
+
+ private:
+     uint64_t hashes[LOADOUT_CACHE_SIZE]; ///< Hash of each entry
+     Loadout  blobs[LOADOUT_CACHE_SIZE];  ///< Loadout of each entry
+     uint32_t used[LOADOUT_CACHE_SIZE];   ///< Value of clock when each entry was last used
+     uint8_t  count;                      ///< Valid entries
+     uint32_t clock;                      ///< Counts uses
+ };
+
+ #endif // LOADOUT_HPP
@@ -0,0 +1,116 @@
+/**
+ * @file MatchLog.cpp
+ * @brief Implementation of the match event ring, spill and replay.
+ */
+
+ #include "MatchLog.hpp"
+
+ namespace MatchLog {
+
+     static_assert(MATCH_LOG_SIZE >= 2 && (MATCH_LOG_SIZE & (MATCH_LOG_SIZE - 1)) == 0,
+                   "MATCH_LOG_SIZE must be a power of two");
+     static_assert(sizeof(MatchEvent) == 16, "MatchEvent must stay a 16-byte record");
+
+     static MatchEvent   events[MATCH_LOG_SIZE];
+     static uint32_t     head = 0;      // Records appended since begin()
+     static uint32_t     flushed = 0;   // Records handed to the sink (or lost)
+     static uint32_t     lostCount = 0;
+     static uint32_t     startTime = 0;
+     static MatchLogSink sink = nullptr;
+     static portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+     static const char *typeNames[MATCH_EVENT_size] = {
+         "status", "shots", "hit", "hp", "connect", "disconnect"
+     };
+
+     void begin() {
+         portENTER_CRITICAL(&mux);
+         head = 0;
+         flushed = 0;
+         lostCount = 0;
+         startTime = millis();
+         portEXIT_CRITICAL(&mux);
+     }
+
+     void append(uint8_t match, MatchEventType type, uint8_t player, uint8_t other, uint8_t arg, int32_t value) {
+         uint32_t now = millis();
+         portENTER_CRITICAL(&mux);
+         MatchEvent &e = events[head & (MATCH_LOG_SIZE - 1)];
+         e.time   = now - startTime;
+         e.type   = type;
+         e.match  = match;
+         e.player = player;
+         e.other  = other;
+         e.arg    = arg;
+         e.reserved[0] = e.reserved[1] = e.reserved[2] = 0;
+         e.value  = value;
+         head++;
+         if (head - flushed > MATCH_LOG_SIZE) {
+             flushed = head - MATCH_LOG_SIZE;
+             if (sink) lostCount++;
+         }
+         portEXIT_CRITICAL(&mux);
+     }
+
+     void setSink(MatchLogSink newSink) {
+         portENTER_CRITICAL(&mux);
+         sink = newSink;
+         flushed = head;
+         portEXIT_CRITICAL(&mux);
+     }
+
+     void flush() {
+         if (!sink) return;
+         portENTER_CRITICAL(&mux);
+         uint32_t from = flushed;
+         uint32_t to = head;
+         portEXIT_CRITICAL(&mux);
+
+         // Spill in at most two contiguous runs (before and after the wrap)
+         while (from != to) {
+             size_t index = from & (MATCH_LOG_SIZE - 1);
+             size_t count = to - from;
+             if (count > MATCH_LOG_SIZE - index) count = MATCH_LOG_SIZE - index;
+             sink(&events[index], count);
+             from += count;
+         }
+
+         portENTER_CRITICAL(&mux);
+         if (int32_t(flushed - to) < 0) flushed = to;
+         portEXIT_CRITICAL(&mux);
+     }
+
+     void replay(MatchEventHandler handler) {
+         uint32_t end = head;
+         uint32_t seq = end > MATCH_LOG_SIZE ? end - MATCH_LOG_SIZE : 0;
+         for (; seq != end; seq++) {
+             handler(events[seq & (MATCH_LOG_SIZE - 1)]);
+         }
+     }
+
+     void replay(const MatchEvent *records, size_t count, MatchEventHandler handler) {
+         for (size_t i = 0; i < count; i++) {
+             handler(records[i]);
+         }
+     }
+
+     size_t size() {
+         return head > MATCH_LOG_SIZE ? MATCH_LOG_SIZE : head;
+     }
+
+     uint32_t lost() {
+         return lostCount;
+     }
+
+     void printEvent(const MatchEvent &event) {
+         Serial.printf("%u,%u,%s,%u,%u,%u,%d\n",
+                       event.time, event.match,
+                       event.type < MATCH_EVENT_size ? typeNames[event.type] : "?",
+                       event.player, event.other, event.arg, event.value);
+     }
+
+     void serialSink(const MatchEvent *records, size_t count) {
+         replay(records, count, printEvent);
+     }
+
+ } // namespace MatchLog
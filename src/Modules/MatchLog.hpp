@@ -0,0 +1,113 @@
+/**
+ * @file MatchLog.hpp
+ * @brief Append-only log of match events kept by the Manager for post-game breakdowns.
+ *
+ * Events of all hosted matches are fixed-size records tagged with their
+ * match and written into a preallocated RAM ring, so an append is a single
+ * copy and never allocates. flush() hands records that were not yet spilled
+ * to a pluggable sink (flash, Serial, ...) from the main loop, and replay()
+ * walks the records still in RAM in order.
+ */
+
+ #ifndef MATCHLOG_HPP
+ #define MATCHLOG_HPP
+
+ #include <Arduino.h>
+
+ /** Records kept in RAM; must be a power of two. */
+ #define MATCH_LOG_SIZE 512
+ /** Marks a record field that does not refer to a player. */
+ #define MATCH_LOG_NONE 0xFF
+
+ /**
+  * @enum MatchEventType
+  * @brief Kind of a logged event; selects how the record fields are read.
+  */
+ enum MatchEventType : uint8_t {
+     MATCH_EVENT_STATUS,     ///< value = new GameStatus
+     MATCH_EVENT_SHOTS,      ///< player fired value shots in total (reported by the gun)
+     MATCH_EVENT_HIT,        ///< player was hit by other with shot counter arg for value damage
+     MATCH_EVENT_HP,         ///< player has value HP left
+     MATCH_EVENT_CONNECT,    ///< Device player (deviceID) of groups arg appeared
+     MATCH_EVENT_DISCONNECT, ///< Device player (deviceID) of groups arg vanished
+     MATCH_EVENT_size
+ };
+
+ /**
+  * @struct MatchEvent
+  * @brief One fixed-size log record (16 bytes).
+  */
+ struct __attribute__((packed)) MatchEvent {
+     uint32_t time;        ///< Milliseconds since MatchLog::begin()
+     uint8_t  type;        ///< MatchEventType
+     uint8_t  match;       ///< Match index, MATCH_LOG_NONE if the event belongs to no match
+     uint8_t  player;      ///< Player index (or deviceID), MATCH_LOG_NONE if unused
+     uint8_t  other;       ///< Second player index, MATCH_LOG_NONE if unused
+     uint8_t  arg;         ///< Small type-specific argument
+     uint8_t  reserved[3]; ///< Keeps value aligned; always 0
+     int32_t  value;       ///< Type-specific value
+ };
+
+ /** Receives a contiguous run of records that left the RAM ring. */
+ typedef void (*MatchLogSink)(const MatchEvent *events, size_t count);
+ /** Receives one record during replay. */
+ typedef void (*MatchEventHandler)(const MatchEvent &event);
+
+ /**
+  * @namespace MatchLog
+  * @brief Match event ring with spill sink and replay.
+  */
+ namespace MatchLog {
+
+     /**
+      * @brief Empties the log and restarts its clock; call once in setup().
+      */
+     void begin();
+
+     /**
+      * @brief Appends one record (constant time, safe from any task).
+      *
+      * If the ring is full the oldest record is overwritten; records that
+      * were not spilled yet are counted as lost.
+      */
+     void append(uint8_t match, MatchEventType type, uint8_t player, uint8_t other = MATCH_LOG_NONE,
+                 uint8_t arg = 0, int32_t value = 0);
+
+     /**
+      * @brief Sets the sink that receives records on flush().
+      * @param sink Spill function, or nullptr to keep records in RAM only
+      */
+     void setSink(MatchLogSink sink);
+
+     /**
+      * @brief Hands all records appended since the last flush to the sink.
+      *
+      * Call from the main loop, outside of time-critical code; does nothing
+      * without a sink.
+      */
+     void flush();
+
+     /**
+      * @brief Calls @p handler for every record still in RAM, oldest first.
+      */
+     void replay(MatchEventHandler handler);
+
+     /**
+      * @brief Calls @p handler for every record of an array, e.g. read back from a sink.
+      */
+     void replay(const MatchEvent *events, size_t count, MatchEventHandler handler);
+
+     /** @brief Number of records currently in RAM. */
+     size_t size();
+
+     /** @brief Records overwritten before the sink received them. */
+     uint32_t lost();
+
+     /** @brief Handler that prints a record as one CSV line to Serial. */
+     void printEvent(const MatchEvent &event);
+
+     /** @brief Sink that prints every record as one CSV line to Serial. */
+     void serialSink(const MatchEvent *events, size_t count);
+ }
+
+ #endif // MATCHLOG_HPP
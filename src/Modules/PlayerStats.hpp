@@ -0,0 +1,170 @@
+/**
+ * @file PlayerStats.hpp
+ * @brief Per-player match statistics, updated incrementally as hits and shot counts arrive.
+ *
+ * Every update is constant time and the memory is fixed, so the numbers can
+ * be read at any moment (e.g. every frame by the GUI) without scanning logs.
+ */
+
+ #ifndef PLAYERSTATS_HPP
+ #define PLAYERSTATS_HPP
+
+ #include <Arduino.h>
+
+ /** Number of buckets of the sliding damage window. */
+ #define STATS_DPS_BUCKETS 5
+ /** Length of one bucket of the sliding damage window (ms). */
+ #define STATS_DPS_BUCKET_MS 1000
+
+ /**
+  * @class PlayerStats
+  * @brief Running statistics of one player in the current match.
+  *
+  * Damage per second is averaged over the last STATS_DPS_BUCKETS buckets.
+  * Time-to-kill runs from the first hit on a full-health victim to the hit
+  * that kills it. A streak counts hits landed without being hit in between.
+  */
+ class PlayerStats {
+ public:
+     uint32_t shotsReported;  ///< Shots reported by the gun (0 until it reports)
+     uint32_t shotsImplied;   ///< Shots implied by the shot counters seen in hits
+     uint32_t hits;           ///< Distinct shots that hit
+     uint32_t damageDealt;    ///< Damage dealt to opponents
+     uint32_t damageTaken;    ///< Damage received
+     uint32_t kills;          ///< Opponents eliminated
+     uint32_t lastTimeToKill; ///< Time-to-kill of the last kill (ms, 0 = none)
+     uint32_t bestTimeToKill; ///< Fastest time-to-kill (ms, 0 = none)
+     uint16_t streak;         ///< Current hit streak
+     uint16_t longestStreak;  ///< Longest hit streak
+     uint32_t woundedSince;   ///< Time of the first hit taken at full health
+     bool     wounded;        ///< True once hit since full health
+
+     /** @brief Construct zeroed statistics. */
+     PlayerStats() { reset(0); }
+
+     /**
+      * @brief Zero all counters at the start of a match.
+      * @param now Current time (ms)
+      */
+     void reset(uint32_t now) {
+         shotsReported = 0;
+         shotsImplied = 0;
+         hits = 0;
+         damageDealt = 0;
+         damageTaken = 0;
+         kills = 0;
+         lastTimeToKill = 0;
+         bestTimeToKill = 0;
+         streak = 0;
+         longestStreak = 0;
+         woundedSince = 0;
+         wounded = false;
+         lastShot = 0;
+         memset(bucketDamage, 0, sizeof(bucketDamage));
+         windowDamage = 0;
+         bucket = 0;
+         bucketStart = now;
+     }
+
+     /**
+      * @brief Account a shot of this player that hit.
+      * @param shot   Rolling shot counter of the hit
+      * @param damage Damage dealt
+      * @param now    Current time (ms)
+      */
+     void landHit(uint8_t shot, uint32_t damage, uint32_t now) {
+         // The counter starts at 0, so shot n means at least n + 1 shots
+         uint8_t ahead = shot - lastShot;
+         if (hits == 0) {
+             shotsImplied = shot + 1;
+             lastShot = shot;
+         } else if (ahead < 128) {
+             shotsImplied += ahead;
+             lastShot = shot;
+         }
+         hits++;
+         damageDealt += damage;
+         if (++streak > longestStreak) longestStreak = streak;
+
+         advance(now);
+         bucketDamage[bucket] += damage;
+         windowDamage += damage;
+     }
+
+     /**
+      * @brief Account a kill by this player.
+      * @param timeToKill Time from the victim's first wound to death (ms)
+      */
+     void landKill(uint32_t timeToKill) {
+         kills++;
+         lastTimeToKill = timeToKill;
+         if (bestTimeToKill == 0 || timeToKill < bestTimeToKill) bestTimeToKill = timeToKill;
+     }
+
+     /**
+      * @brief Account a hit taken by this player.
+      * @param damage Damage received
+      * @param now    Current time (ms)
+      * @return Time since the first wound (ms), i.e. the time-to-kill if this hit was fatal
+      */
+     uint32_t takeHit(uint32_t damage, uint32_t now) {
+         damageTaken += damage;
+         streak = 0;
+         if (!wounded) {
+             wounded = true;
+             woundedSince = now;
+         }
+         return now - woundedSince;
+     }
+
+     /** @brief Mark the player as back at full health (e.g. respawned). */
+     void heal() { wounded = false; }
+
+     /**
+      * @brief Store the shot count the gun reported.
+      * @param shots Shots fired during the match
+      */
+     void reportShots(uint32_t shots) { shotsReported = shots; }
+
+     /** @brief Best known number of shots fired. */
+     uint32_t shotsFired() const {
+         return shotsReported > shotsImplied ? shotsReported : shotsImplied;
+     }
+
+     /** @brief Fraction of shots that hit, in [0, 1] (0 if unknown). */
+     float accuracy() const {
+         uint32_t fired = shotsFired();
+         return fired ? float(hits) / float(fired) : 0.0f;
+     }
+
+     /**
+      * @brief Damage per second over the sliding window.
+      * @param now Current time (ms)
+      */
+     float dps(uint32_t now) {
+         advance(now);
+         return float(windowDamage) * 1000.0f / (STATS_DPS_BUCKETS * STATS_DPS_BUCKET_MS);
+     }
+
+ private:
+     uint8_t  lastShot;                          ///< Newest shot counter seen in a hit
+     uint32_t bucketDamage[STATS_DPS_BUCKETS];   ///< Damage dealt per bucket
+     uint32_t windowDamage;                      ///< Sum of bucketDamage
+     uint8_t  bucket;                            ///< Bucket covering bucketStart
+     uint32_t bucketStart;                       ///< Start time of the current bucket (ms)
+
+     /** @brief Rotate the window to the bucket containing @p now (at most STATS_DPS_BUCKETS steps). */
+     void advance(uint32_t now) {
+         uint32_t elapsed = (now - bucketStart) / STATS_DPS_BUCKET_MS;
+         if (elapsed == 0) return;
+         bucketStart += elapsed * STATS_DPS_BUCKET_MS;
+         if (elapsed > STATS_DPS_BUCKETS) elapsed = STATS_DPS_BUCKETS;
+         while (elapsed--) {
+             bucket = (bucket + 1) % STATS_DPS_BUCKETS;
+             windowDamage -= bucketDamage[bucket];
+             bucketDamage[bucket] = 0;
+         }
+     }
+ };
+
+ #endif // PLAYERSTATS_HPP
@@ -0,0 +1,133 @@
+/**
+ * @file Replica.cpp
+ * @brief Implementation of the replication frame builder and applier.
+ */
+
+ #include "Replica.hpp"
+ #include "Common/Constants_Common.h"
+
+ namespace Replica {
+
+     static uint16_t lastSeq[GAME_MAX_MATCHES];  // Number of the last frame applied per match
+     static bool     synced[GAME_MAX_MATCHES];   // No frame lost since the last full frame
+
+     // Index of a pointer in a table of built-in objects (0 if missing)
+     template <typename T>
+     static uint8_t indexOf(const T *const table[], uint8_t count, const T *entry) {
+         for (uint8_t i = 0; i < count; i++) {
+             if (table[i] == entry) return i;
+         }
+         return 0;
+     }
+
+     void capture(const Match &match, ReplicaFrame &frame) {
+         memset(&frame, 0, sizeof(frame));
+         frame.match = match.id;
+         frame.full  = 1;
+         frame.elapsed = match.status == GAME_RUNNING ? millis() - match.playedAt : 0;
+
+         ReplicaHeader &h = frame.header;
+         h.status        = match.status;
+         h.mode          = indexOf(Rules::modes, Rules::modeCount, match.rules);
+         h.damageModel   = indexOf(Damage::models, Damage::modelCount, match.damageModel);
+         h.irProtocol    = match.irProtocol;
+         h.localDamage   = match.localDamage;
+         h.playerCount   = match.playerCount;
+         h.matchNumber   = Game::matchNumber;
+         h.topScore      = match.topScore;
+         h.protectedMask = match.protectedMask;
+         h.timeUp        = match.timeUp;
+         h.roundBreak    = match.roundBreak;
+
+         frame.count = match.playerCount;
+         for (uint8_t i = 0; i < match.playerCount; i++) {
+             const Player &p = match.players[i];
+             ReplicaPlayer &r = frame.players[i];
+             r.index   = i;
+             r.team    = match.team[i];
+             r.hp      = p.getHP();
+             r.shooter = match.fireSignals[i].address;
+             r.gun     = p.hasGun()  ? p.getGunAddress().deviceID  : REPLICA_NO_DEVICE;
+             r.vest    = p.hasVest() ? p.getVestAddress().deviceID : REPLICA_NO_DEVICE;
+             r.damage  = match.gunDamage[i];
+             r.score   = match.teamScore[match.teamLead[i]];
+         }
+     }
+
+     uint8_t delta(const ReplicaFrame &full, ReplicaFrame &last, ReplicaFrame &out, bool all) {
+         bool changed = memcmp(&full.header, &last.header, sizeof(ReplicaHeader)) != 0 || full.count != last.count;
+         for (uint8_t i = 0; i < full.count && !changed; i++) {
+             changed = memcmp(&full.players[i], &last.players[i], sizeof(ReplicaPlayer)) != 0;
+         }
+         if (!all && !changed) return 0;
+
+         out.match   = full.match;
+         out.seq     = last.seq + 1;
+         out.elapsed = full.elapsed;
+         out.header  = full.header;
+         out.count   = 0;
+         // A lost delta must not leave the standby behind for long, however busy the match
+         if (out.seq % REPLICA_FULL_EVERY == 0) all = true;
+         for (uint8_t i = 0; i < full.count; i++) {
+             if (all || i >= last.count
+                 || memcmp(&full.players[i], &last.players[i], sizeof(ReplicaPlayer)) != 0) {
+                 out.players[out.count++] = full.players[i];
+             }
+         }
+         // A frame that happens to list every player (e.g. the first one) resyncs as well
+         out.full    = out.count == full.count;
+         last = full;
+         last.seq = out.seq;
+         return frameSize(out.count);
+     }
+
+     bool apply(const ReplicaFrame &frame) {
+         if (frame.match >= GAME_MAX_MATCHES) return false;
+         Match &match = Game::matches[frame.match];
+
+         // Entries are absolute values, so a delta after a gap still helps; only a full frame resyncs
+         synced[frame.match] = frame.full || (synced[frame.match] && frame.seq == uint16_t(lastSeq[frame.match] + 1));
+         lastSeq[frame.match] = frame.seq;
+         const ReplicaHeader &h = frame.header;
+
+         match.status = GameStatus(h.status);
+         if (h.mode < Rules::modeCount)          match.setRules(*Rules::modes[h.mode]);
+         if (h.damageModel < Damage::modelCount) match.setDamageModel(*Damage::models[h.damageModel]);
+         match.irProtocol    = IRprotocolID(h.irProtocol);
+         match.localDamage   = h.localDamage;
+         match.setPlayerCount(h.playerCount);
+         Game::matchNumber   = h.matchNumber;
+         match.topScore      = h.topScore;
+         match.protectedMask = h.protectedMask;
+         match.timeUp        = h.timeUp;
+         match.roundBreak    = h.roundBreak;
+         match.playedAt      = millis() - frame.elapsed;
+
+         uint8_t count = frame.count < GAME_MAX_PLAYERS ? frame.count : GAME_MAX_PLAYERS;
+         for (uint8_t k = 0; k < count; k++) {
+             const ReplicaPlayer &r = frame.players[k];
+             if (r.index >= GAME_MAX_PLAYERS) continue;
+             Player &p = match.players[r.index];
+             match.team[r.index] = r.team;
+             p.setHP(r.hp);
+             match.fireSignals[r.index] = NEC_DATA(r.shooter, 0);
+             if (r.gun == REPLICA_NO_DEVICE) p.clearGun();
+             else p.setGunAddress(NexusAddress(match.projectID, NEXUS_GROUP_GUN, r.gun));
+             if (r.vest == REPLICA_NO_DEVICE) p.clearVest();
+             else p.setVestAddress(NexusAddress(match.projectID, NEXUS_GROUP_VEST, r.vest));
+             match.gunDamage[r.index] = r.damage;
+         }
+
+         // Scores are kept at the team's lead, which the teams just received decide
+         match.buildTables();
+         for (uint8_t k = 0; k < count; k++) {
+             const ReplicaPlayer &r = frame.players[k];
+             if (r.index < GAME_MAX_PLAYERS) match.teamScore[match.teamLead[r.index]] = r.score;
+         }
+         return true;
+     }
+
+     bool inSync(uint8_t match) {
+         return match < GAME_MAX_MATCHES && synced[match];
+     }
+ }
@@ -0,0 +1,143 @@
+/**
+ * @file Replica.hpp
+ * @brief Replication of the hosted matches from the primary Manager to a hot standby.
+ *
+ * The primary sends a ReplicaFrame for a match whenever its state changed,
+ * at most every REPLICA_INTERVAL_MS. A frame always carries the match's
+ * header (status, mode, scores, protection) but only the players whose
+ * entry changed since the last frame, so a hit costs one frame with one
+ * player entry. When nothing changes the primary sends one full frame,
+ * cycling through the matches, every REPLICA_HEARTBEAT_MS: it is the
+ * heartbeat, and it lets a standby that booted late catch up.
+ *
+ * Frames of a match are numbered. A lost delta shows up as a gap in the
+ * numbers, and the standby treats the match as out of sync until a full
+ * frame arrives. During busy play the heartbeat never fires, so the
+ * primary also sends every REPLICA_FULL_EVERY-th frame of a match in full:
+ * a lost delta is repaired within about a second however busy the match.
+ *
+ * A standby applies the frames to its own Game::matches. Without a frame
+ * for REPLICA_TIMEOUT_MS it takes over: Match::resume() rebuilds the
+ * tables, and the Manager sends the devices their HP and new hit tables.
+ *
+ * Not replicated: statistics, seen shot counters, buffs, the hit report
+ * keys (replaced on takeover) and the loadouts beyond the weapon damage.
+ */
+
+ #ifndef REPLICA_HPP
+ #define REPLICA_HPP
+
+ #include <Arduino.h>
+ #include "Game.hpp"
+
+ /** Shortest time between two frames of one match (ms). */
+ #define REPLICA_INTERVAL_MS 100
+ /** A full frame of one match is sent after this long without any frame (ms). */
+ #define REPLICA_HEARTBEAT_MS 300
+ /** A standby takes over after this long without a frame (ms). */
+ #define REPLICA_TIMEOUT_MS 1000
+ /** Every this many frames of a match, one lists every player even if busy. */
+ #define REPLICA_FULL_EVERY 10
+ /** Player entry of a device that is not assigned. */
+ #define REPLICA_NO_DEVICE 0
+
+ /**
+  * @struct ReplicaHeader
+  * @brief State of a match sent in every frame.
+  */
+ struct __attribute__((packed)) ReplicaHeader {
+     uint8_t  status;        ///< GameStatus
+     uint8_t  mode;          ///< Index in Rules::modes
+     uint8_t  damageModel;   ///< Index in Damage::models
+     uint8_t  irProtocol;    ///< IRprotocolID
+     uint8_t  localDamage;   ///< Match::localDamage
+     uint8_t  playerCount;   ///< Players taking part
+     uint8_t  matchNumber;   ///< Game::matchNumber, so the next start() picks the next shooter IDs
+     uint16_t topScore;      ///< Highest team score
+     uint32_t protectedMask; ///< Players that cannot be hit
+     uint8_t  timeUp;        ///< The mode's clock ran out
+     uint8_t  roundBreak;    ///< Between a decided round and the next one
+ };
+
+ /**
+  * @struct ReplicaPlayer
+  * @brief State of one player.
+  */
+ struct __attribute__((packed)) ReplicaPlayer {
+     uint8_t  index;   ///< Player index
+     uint8_t  team;    ///< Team ID
+     int16_t  hp;      ///< Current HP
+     uint8_t  shooter; ///< Shooter ID of the fire code
+     uint8_t  gun;     ///< Gun deviceID (REPLICA_NO_DEVICE if none)
+     uint8_t  vest;    ///< Vest deviceID (REPLICA_NO_DEVICE if none)
+     uint16_t damage;  ///< Weapon damage
+     uint16_t score;   ///< Score of the player's team
+ };
+
+ /**
+  * @struct ReplicaFrame
+  * @brief One match's header and changed players (COMMS_REPLICA).
+  *
+  * Only the first @c count entries of @c players are sent (see Replica::frameSize()).
+  */
+ struct __attribute__((packed)) ReplicaFrame {
+     uint8_t       match;                     ///< Match index
+     uint16_t      seq;                       ///< Frame number of the match, one more than the last frame sent
+     uint8_t       full;                      ///< Non-zero if every player is listed
+     uint32_t      elapsed;                   ///< Time since play() on the primary (ms, 0 if not running)
+     ReplicaHeader header;                    ///< Match state
+     uint8_t       count;                     ///< Valid entries in players
+     ReplicaPlayer players[GAME_MAX_PLAYERS]; ///< Changed players
+ };
+
+ /**
+  * @namespace Replica
+  * @brief Builds and applies replication frames.
+  */
+ namespace Replica {
+     /**
+      * @brief Bytes of a frame with @p count player entries.
+      */
+     inline uint8_t frameSize(uint8_t count) {
+         return offsetof(ReplicaFrame, players) + count * sizeof(ReplicaPlayer);
+     }
+
+     /**
+      * @brief Takes the full state of a match.
+      * @param match Match to replicate
+      * @param frame Output frame listing every player
+      */
+     void capture(const Match &match, ReplicaFrame &frame);
+
+     /**
+      * @brief Reduces a full frame to what changed since the last one sent.
+      *
+      * Numbers the frame after the last one; every REPLICA_FULL_EVERY-th
+      * frame lists every player even if @p all is false.
+      * @param full Full frame from capture()
+      * @param last Last full frame sent for the match; updated to @p full when a frame is due
+      * @param out  Output frame with the header and the changed players (all players if @p all)
+      * @param all  Send every player, e.g. for the heartbeat
+      * @return Bytes to send (see frameSize()), or 0 if nothing changed and not @p all
+      */
+     uint8_t delta(const ReplicaFrame &full, ReplicaFrame &last, ReplicaFrame &out, bool all);
+
+     /**
+      * @brief Applies a received frame to its match on a standby.
+      *
+      * Tracks the frame numbers: a delta that does not follow the last
+      * frame is still applied (its entries are absolute), but the match
+      * stays out of sync until the next full frame.
+      * @param frame Received frame
+      * @return False if the frame names no match
+      */
+     bool apply(const ReplicaFrame &frame);
+
+     /**
+      * @brief True if every frame of a match since its last full frame arrived.
+      * @param match Match index
+      */
+     bool inSync(uint8_t match);
+ }
+
+ #endif // REPLICA_HPP
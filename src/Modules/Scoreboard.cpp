@@ -0,0 +1,106 @@
+/**
+ * @file Scoreboard.cpp
+ * @brief Implementation of the narrator, the scoreboard frame builder and its rate limit.
+ */
+
+ #include "Scoreboard.hpp"
+ #include "GameRules.hpp"
+
+ namespace Spectator {
+
+     // "Player N" for a team of one, "Team N" otherwise
+     static String teamName(const Match &match, uint8_t team) {
+         uint8_t members = 0, first = 0;
+         for (uint8_t i = 0; i < match.playerCount; i++) {
+             if (match.team[i] != team) continue;
+             if (members++ == 0) first = i;
+         }
+         return members == 1 ? "Player " + String(first + 1) : "Team " + String(team);
+     }
+
+     String narrate(const Match &match) {
+         // Healthiest and weakest living players; a shared top HP has no leader
+         int8_t leader = -1, weakest = -1;
+         int maxHP = 0, minHP = 0;
+         bool tied = false;
+         for (uint8_t i = 0; i < match.playerCount; i++) {
+             int hp = match.players[i].getHP();
+             if (hp <= 0) continue;
+             if (leader < 0 || hp > maxHP) { leader = i; maxHP = hp; tied = false; }
+             else if (hp == maxHP)         tied = true;
+             if (weakest < 0 || hp < minHP) { weakest = i; minHP = hp; }
+         }
+         if (tied) leader = -1;
+
+         // With respawns 0 HP does not end the game; the game mode does
+         if (match.status >= GAME_OVER) {
+             uint8_t winner = match.getWinner();
+             if (winner != 0) {
+                 return "Game's Over! " + teamName(match, winner)
+                     + " wins! What an electrifying duel that kept us on the edge of our seats!";
+             }
+             return "It's a tie! Both players fought valiantly, but the arena has claimed them both!";
+         }
+
+         // Narration for key game events with added dynamic sentences
+         if (weakest >= 0 && minHP == 100) {
+             return "Game Started! Let the duel commence. Prepare for an epic showdown on the laser taggin' battlefield!";
+             /** Another options:
+              * "As the two competitors arrives .The arena is charged with anticipation as they prepare for the ultimate showdown!"
+              * "The arena is alive with energy! Both players are at full health, ready to unleash their skills in this electrifying duel!"
+              */
+         } else if (maxHP == 100 && leader >= 0) {
+             return "Player " + String(leader + 1) + " is blazing ahead! With lightning-fast moves, the arena ignites with energy!";
+         } else if (minHP > 60 && minHP < 100 && leader >= 0) {
+             return "Player " + String(leader + 1) + " is in the lead! The tension is palpable as the duel intensifies!";
+         } else if (minHP <= 60 && minHP > 30) {
+             return "The duel is heating up!";
+         } else if (minHP <= 30 && minHP > 15) {
+             return "The stakes are high! One wrong move could turn the tide of battle!";
+         } else if (weakest >= 0 && minHP <= 15 && weakest != leader) {
+             return "Player " + String(weakest + 1) + " is hanging by a thread! One more hit could change everything!";
+         }
+         return "The duel rages on... Every shot is a heartbeat, and the tension is lighting up the arena!";
+     }
+
+     void build(const Match &match, Scoreboard &board) {
+         memset(&board, 0, sizeof(board));
+         board.match       = match.id;
+         board.status      = match.status;
+         board.playerCount = match.playerCount;
+         board.mode        = SCOREBOARD_NO_MODE;
+         for (uint8_t m = 0; m < Rules::modeCount; m++) {
+             if (Rules::modes[m] == match.rules) board.mode = m;
+         }
+         if (match.status >= GAME_OVER) board.winner = match.getWinner();
+
+         for (uint8_t i = 0; i < match.playerCount; i++) {
+             int hp = match.players[i].getHP();
+             board.team[i]  = match.team[i];
+             board.hp[i]    = hp > 255 ? 255 : hp;
+             board.score[i] = match.teamScore[match.teamLead[i]];
+         }
+
+         // Longer lines are cut; the frame stays NUL-terminated
+         narrate(match).toCharArray(board.narration, SCOREBOARD_NARRATION);
+     }
+ }
+
+ ScoreboardFeed::ScoreboardFeed() : lastPass(0) {
+     memset(last, 0, sizeof(last));
+     memset(lastSent, 0, sizeof(lastSent));
+ }
+
+ bool ScoreboardFeed::pass(uint32_t now) {
+     if (now - lastPass < SCOREBOARD_INTERVAL_MS) return false;
+     lastPass = now;
+     return true;
+ }
+
+ bool ScoreboardFeed::due(uint8_t index, const Scoreboard &board, uint32_t now) {
+     bool changed = memcmp(&board, &last[index], sizeof(board)) != 0;
+     if (!changed && now - lastSent[index] < SCOREBOARD_HEARTBEAT_MS) return false;
+     last[index] = board;
+     lastSent[index] = now;
+     return true;
+ }
@@ -0,0 +1,99 @@
+/**
+ * @file Scoreboard.hpp
+ * @brief Compact scoreboard frame the Manager broadcasts to spectator displays.
+ *
+ * Spectators (a TV-side scoreboard, extra display boards) join the
+ * NEXUS_GROUP_SPECTATOR group of an arena's project and only listen. The
+ * Manager builds one Scoreboard per match and broadcasts it to the whole
+ * group, so its cost is one frame per interval however many spectators
+ * listen, and it never tracks them.
+ */
+
+ #ifndef SCOREBOARD_HPP
+ #define SCOREBOARD_HPP
+
+ #include <Arduino.h>
+ #include "Game.hpp"
+
+ /** Shortest time between two scoreboard frames of one match (ms). */
+ #define SCOREBOARD_INTERVAL_MS 250
+ /** An unchanged scoreboard is sent again after this long, for displays that joined late (ms). */
+ #define SCOREBOARD_HEARTBEAT_MS 2000
+ /** Characters of narration a frame carries, including the terminating NUL. */
+ #define SCOREBOARD_NARRATION 112
+ /** Scoreboard.mode of a game mode missing from Rules::modes. */
+ #define SCOREBOARD_NO_MODE 0xFF
+
+ /**
+  * @struct Scoreboard
+  * @brief Live state of one match for spectators (COMMS_SCOREBOARD).
+  */
+ struct __attribute__((packed)) Scoreboard {
+     uint8_t  match;                        ///< Arena index
+     uint8_t  status;                       ///< GameStatus
+     uint8_t  mode;                         ///< Index in Rules::modes (SCOREBOARD_NO_MODE if none)
+     uint8_t  playerCount;                  ///< Valid entries in the player arrays
+     uint8_t  winner;                       ///< Winning team once the game is over (0 = none or draw)
+     uint8_t  team[GAME_MAX_PLAYERS];       ///< Team of each player
+     uint8_t  hp[GAME_MAX_PLAYERS];         ///< HP of each player, capped at 255
+     uint16_t score[GAME_MAX_PLAYERS];      ///< Score of each player's team
+     char     narration[SCOREBOARD_NARRATION]; ///< Narrator text, NUL-terminated
+ };
+
+ /**
+  * @struct ScoreboardFeed
+  * @brief Rate limit of the scoreboard frames the Manager broadcasts.
+  *
+  * The Manager checks the matches at most every SCOREBOARD_INTERVAL_MS and
+  * sends a match's frame only if it changed, or if the last one is
+  * SCOREBOARD_HEARTBEAT_MS old so displays that joined late catch up.
+  */
+ struct ScoreboardFeed {
+     Scoreboard last[GAME_MAX_MATCHES];     ///< Last frame sent for each match
+     uint32_t   lastSent[GAME_MAX_MATCHES]; ///< millis() of the last frame sent for each match
+     uint32_t   lastPass;                   ///< millis() of the last pass over the matches
+
+     /** @brief Construct a feed that has sent nothing yet. */
+     ScoreboardFeed();
+
+     /**
+      * @brief Starts a pass over the matches if the interval is over.
+      * @param now Current millis()
+      * @return True if the matches are to be checked now
+      */
+     bool pass(uint32_t now);
+
+     /**
+      * @brief Decides whether a match's frame goes out, and records it if so.
+      * @param index Match index
+      * @param board Current frame of the match
+      * @param now   Current millis()
+      * @return True if the frame changed or the heartbeat is due
+      */
+     bool due(uint8_t index, const Scoreboard &board, uint32_t now);
+ };
+
+ /**
+  * @namespace Spectator
+  * @brief Builds what spectators see of a match.
+  */
+ namespace Spectator {
+     /**
+      * @brief Narrator line for the current state of a match.
+      *
+      * Looks at every player of the match: the leader is the one living
+      * player with the most HP, the player in danger the one with the least.
+      * @param match Match to narrate
+      * @return Text shown on the Manager's gameplay screen and on spectator displays
+      */
+     String narrate(const Match &match);
+
+     /**
+      * @brief Fills a scoreboard frame from a match.
+      * @param match Match to show
+      * @param board Output frame; unused player entries and narration bytes are zeroed
+      */
+     void build(const Match &match, Scoreboard &board);
+ }
+
+ #endif // SCOREBOARD_HPP
@@ -0,0 +1,73 @@
+/**
+ * @file spectator_main.hpp
+ * @brief Reference firmware for a passive spectator display.
+ *
+ * Joins the spectator group of its arena (DEVICE_ARENA), never answers
+ * Manager scans, and prints every new scoreboard frame to Serial: one
+ * "#arena,status,mode,winner" line, one "player,team,hp,score" line per
+ * player and the narration. A TV-side scoreboard or a display board reads
+ * these lines, or replaces printScoreboard() with its own renderer. Any
+ * number of spectators can listen; the Manager sends each frame once.
+ */
+
+ #ifndef SPECTATOR_MAIN_HPP
+ #define SPECTATOR_MAIN_HPP
+
+ #include <Arduino.h>
+ #include "Common/Constants_Common.h"
+ #include "Common/LazerTagPacket.hpp"      ///< COMMS_SCOREBOARD and Scoreboard
+ #include "Components/Nexus/Nexus.hpp"     ///< ESP-NOW networking
+
+ Scoreboard scoreboard = {};   ///< Last frame shown
+
+ /**
+  * @brief Keeps spectators out of the Manager's scan results.
+  * @return Always false: never answer a scan.
+  */
+ bool spectatorScanned(const NexusAddress &) { return false; }
+
+ /**
+  * @brief Prints a scoreboard frame to Serial.
+  * @param board Frame to print.
+  */
+ void printScoreboard(const Scoreboard &board)
+ {
+     Serial.printf("#%u,%u,%u,%u\n", board.match + 1, board.status, board.mode, board.winner);
+     for (uint8_t i = 0; i < board.playerCount && i < GAME_MAX_PLAYERS; i++) {
+         Serial.printf("%u,%u,%u,%u\n", i + 1, board.team[i], board.hp[i], board.score[i]);
+     }
+     Serial.println(board.narration);
+ }
+
+ /**
+  * @brief Initializes Serial and joins the spectator group of the arena.
+  */
+ void spectator_setup()
+ {
+     Serial.begin(115200);
+     Nexus::onThisScanned = spectatorScanned;
+     Nexus::begin(NexusAddress(NEXUS_PROJECT_ID, NEXUS_GROUPS, NEXUS_DEVICE_ID));
+ }
+
+ /**
+  * @brief Shows each scoreboard frame that differs from the last one.
+  *
+  * Heartbeat frames repeat the last state and are skipped.
+  */
+ void spectator_loop()
+ {
+     Nexus::loop();
+
+     NexusPacket packet;
+     while (Nexus::readPacket(packet)) {
+         if (packet.command != COMMS_SCOREBOARD || packet.length != sizeof(Scoreboard)) continue;
+         Scoreboard board;
+         memcpy(&board, packet.payload, sizeof(board));
+         board.narration[SCOREBOARD_NARRATION - 1] = '\0';
+         if (memcmp(&board, &scoreboard, sizeof(board)) == 0) continue;
+         scoreboard = board;
+         printScoreboard(scoreboard);
+     }
+ }
+
+ #endif // SPECTATOR_MAIN_HPP
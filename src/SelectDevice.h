@@ -7,6 +7,7 @@
  *   - DEVICE_MANAGER (1)
  *   - DEVICE_GUN     (2)
  *   - DEVICE_VEST    (3)
+ *   - DEVICE_SPECTATOR (4)
  *
  * Also documents the mapping of IDs for managers, guns, and vests.
  */
@@ -21,6 +22,7 @@
   *   1 - DEVICE_MANAGER
   *   2 - DEVICE_GUN
   *   3 - DEVICE_VEST
+  *   4 - DEVICE_SPECTATOR
   */
  
  /**
@@ -31,6 +33,7 @@
   *   4 - Gun 2
   *   5 - Vest 2
   *   6 - Manager 2
+  *   Spectators only listen and may share any ID
   */
  
  /// @brief Specify which device this firmware is built for
@@ -38,5 +41,8 @@
  
  /// @brief Unique identifier for this device instance
  #define DEVICE_ID   6
+
+ /// @brief Arena this Gun or Vest plays in (0 .. GAME_MAX_MATCHES-1); ignored by the Manager, which hosts all arenas
+ #define DEVICE_ARENA 0
  
  #endif // SELECT_DEVICE_H
\ No newline at end of file
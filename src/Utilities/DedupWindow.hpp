@@ -0,0 +1,123 @@
+/**
+ * @file DedupWindow.hpp
+ * @brief Defines the DedupWindow template, a fixed-size hashed set of recently seen keys.
+ *
+ * Each key is remembered for a fixed time window. Storage is a static array,
+ * lookups and inserts probe a bounded number of slots, and expired entries
+ * are reclaimed lazily, so every operation is O(1) and never allocates.
+ */
+
+ #ifndef DEDUPWINDOW_HPP
+ #define DEDUPWINDOW_HPP
+
+ #include <Arduino.h>
+
+ /**
+  * @brief Hashed dedup window keyed on 32-bit values.
+  *
+  * Open addressing with linear probing limited to @p PROBES slots. A slot is
+  * free when it was never used or its entry has expired. If every probed slot
+  * is live, the entry closest to expiry is evicted.
+  *
+  * @tparam V      Per-entry payload stored alongside the key.
+  * @tparam N      Number of slots; must be a power of two.
+  * @tparam PROBES Maximum slots examined per operation.
+  */
+ template <typename V, size_t N, size_t PROBES = 8>
+ class DedupWindow {
+     static_assert(N >= 2 && (N & (N - 1)) == 0, "DedupWindow size must be a power of two");
+     static_assert(PROBES >= 1 && PROBES <= N, "DedupWindow probe count out of range");
+
+ public:
+     /**
+      * @brief Constructs an empty window.
+      * @param windowTime How long a key stays live after insert (same unit as @c now).
+      */
+     explicit DedupWindow(uint32_t windowTime) : window(windowTime) { clear(); }
+
+     /**
+      * @brief Looks up a live entry.
+      *
+      * @param key Key to search for.
+      * @param now Current time.
+      * @return Pointer to the entry's payload, or nullptr if absent or expired.
+      */
+     V* find(uint32_t key, uint32_t now) {
+         size_t index = hash(key);
+         for (size_t i = 0; i < PROBES; ++i, index = (index + 1) & MASK) {
+             Slot& slot = slots[index];
+             if (slot.used && slot.key == key && isLive(slot, now)) {
+                 return &slot.value;
+             }
+         }
+         return nullptr;
+     }
+
+     /**
+      * @brief Stores a key that is not live yet.
+      *
+      * The caller is expected to have checked find() first. The returned
+      * payload is default-initialised and stays valid until the entry expires.
+      *
+      * @param key Key to store.
+      * @param now Current time; the entry expires at @c now + window.
+      * @return Pointer to the new entry's payload.
+      */
+     V* insert(uint32_t key, uint32_t now) {
+         size_t index = hash(key);
+         size_t target = index;
+         uint32_t soonest = UINT32_MAX;
+         for (size_t i = 0; i < PROBES; ++i, index = (index + 1) & MASK) {
+             Slot& slot = slots[index];
+             if (!slot.used || !isLive(slot, now)) {
+                 target = index;
+                 break;
+             }
+             uint32_t left = slot.expires - now;
+             if (left < soonest) {
+                 soonest = left;
+                 target = index;
+             }
+         }
+
+         Slot& slot = slots[target];
+         slot.used = true;
+         slot.key = key;
+         slot.expires = now + window;
+         slot.value = V();
+         return &slot.value;
+     }
+
+     /** @brief Forgets every entry. */
+     void clear() {
+         for (size_t i = 0; i < N; ++i) slots[i].used = false;
+     }
+
+     /** @brief Number of slots. */
+     static size_t capacity() { return N; }
+
+ private:
+     /** @brief One table slot. */
+     struct Slot {
+         uint32_t key;     ///< Stored key.
+         uint32_t expires; ///< Time at which the entry stops being live.
+         bool     used;    ///< False if the slot was never filled.
+         V        value;   ///< Caller payload.
+     };
+
+     static const size_t MASK = N - 1; ///< Index wrap mask.
+     Slot     slots[N];                ///< Slot storage.
+     uint32_t window;                  ///< Entry lifetime.
+
+     /** @brief Multiplicative (Fibonacci) hash folded to a slot index. */
+     static size_t hash(uint32_t key) {
+         return ((key * 2654435761UL) >> 16) & MASK;
+     }
+
+     /** @brief Wrap-safe expiry check. */
+     static bool isLive(const Slot& slot, uint32_t now) {
+         return static_cast<int32_t>(slot.expires - now) > 0;
+     }
+ };
+
+ #endif // DEDUPWINDOW_HPP
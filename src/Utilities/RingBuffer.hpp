@@ -0,0 +1,89 @@
+/**
+ * @file RingBuffer.hpp
+ * @brief Defines the RingBuffer template, a fixed-size lock-free single-producer/single-consumer queue.
+ *
+ * Storage is a static array, so push/pop never allocate and are safe to call
+ * from an ISR (producer) while the main loop drains it (consumer).
+ */
+
+ #ifndef RINGBUFFER_HPP
+ #define RINGBUFFER_HPP
+
+ #include <Arduino.h>
+
+ /**
+  * @brief Lock-free SPSC ring buffer.
+  *
+  * Exactly one context may push and exactly one context may pop. The producer
+  * only writes @c head and the consumer only writes @c tail, so no locking is
+  * needed. One slot is kept free to distinguish full from empty.
+  *
+  * @tparam T Element type (should be trivially copyable).
+  * @tparam N Capacity in slots; must be a power of two.
+  */
+ template <typename T, size_t N>
+ class RingBuffer {
+     static_assert(N >= 2 && (N & (N - 1)) == 0, "RingBuffer size must be a power of two");
+
+ public:
+     /** @brief Constructs an empty ring. */
+     RingBuffer() : head(0), tail(0) {}
+
+     /**
+      * @brief Appends an element (producer side).
+      *
+      * @param value Element to store.
+      * @return False if the ring is full and the element was dropped.
+      */
+     bool IRAM_ATTR push(const T& value) {
+         size_t h = head;
+         size_t next = (h + 1) & MASK;
+         if (next == tail) {
+             return false;
+         }
+         items[h] = value;
+         head = next;  // publish after the slot is written
+         return true;
+     }
+
+     /**
+      * @brief Removes the oldest element (consumer side).
+      *
+      * @param value Output reference for the element.
+      * @return False if the ring was empty.
+      */
+     bool IRAM_ATTR pop(T& value) {
+         size_t t = tail;
+         if (t == head) {
+             return false;
+         }
+         value = items[t];
+         tail = (t + 1) & MASK;
+         return true;
+     }
+
+     /** @brief True if no elements are waiting. */
+     bool isEmpty() const { return head == tail; }
+
+     /** @brief True if the next push would fail. */
+     bool isFull() const { return ((head + 1) & MASK) == tail; }
+
+     /** @brief Number of elements waiting. */
+     size_t size() const { return (head - tail) & MASK; }
+
+     /** @brief Usable capacity (one slot stays free). */
+     static size_t capacity() { return N - 1; }
+
+     /**
+      * @brief Drops all waiting elements (consumer side).
+      */
+     void clear() { tail = head; }
+
+ private:
+     static const size_t MASK = N - 1; ///< Index wrap mask.
+     T items[N];                       ///< Element storage.
+     volatile size_t head;             ///< Next slot to write (producer).
+     volatile size_t tail;             ///< Next slot to read (consumer).
+ };
+
+ #endif // RINGBUFFER_HPP
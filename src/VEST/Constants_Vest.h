@@ -13,8 +13,10 @@
  //------------------------------------------------------------------------------
  /// GPIO pins for the three IR receivers
  static const uint8_t recvPins[] = {27, 26, 25};
- /// If true, receiver will validate inverted address/command bytes
- static const bool recvValid = false;
+ /// If true, receiver will validate inverted address/command bytes (fire codes rely on it)
+ static const bool recvValid = true;
+ /// Milliseconds hits are gathered before they go to the Manager in one frame (0 = every loop)
+ static const uint8_t hitBatchWindowMS = 5;
  
  //------------------------------------------------------------------------------
  // NeoPixel Ring Configuration
@@ -2,9 +2,12 @@
  * @file Target.hpp
  * @brief IR hit detection subsystem for the Vest device.
  *
- * Uses three IRreceiver instances (one per pin/ISR) to decode NEC protocol signals.
- * Implements debouncing logic to avoid duplicate hits within a short time window.
- * Exposes API to initialize, poll, and consume unique hit codes.
+ * Uses three IRreceiver instances (one per pin/ISR) to decode NEC or tag protocol signals.
+ * The ISRs only timestamp edges; decoding happens in Target::loop().
+ * Every shot carries its own code (shooter ID + shot counter), so copies of a code
+ * seen by several receivers within NEC_VALID_TIME_MS are exactly one shot and are
+ * fused into a single hit through a fixed-size hashed dedup window.
+ * Exposes API to initialize, poll, and consume unique hits.
  */
 
  #ifndef TARGET_HPP
@@ -13,7 +16,7 @@
  #include <Arduino.h>
  #include "VEST/Constants_Vest.h"                     ///< recvPins[], recvValid
  #include "Components/IRremoteESP32/IRremoteESP32.hpp" ///< NEC_DATA, IRreceiver
- #include "Utilities/HyperList.hpp"                   ///< dynamic list of hits
+ #include "Utilities/DedupWindow.hpp"                 ///< recently accepted codes
  
  // Forward declarations of the interrupt handlers
  void IRAM_ATTR recvISR_0();
@@ -25,25 +28,23 @@
      recvISR_0, recvISR_1, recvISR_2
  };
  
+ /** Capacity of the fused hit queue (power of two). */
+ #define TARGET_HIT_QUEUE_SIZE 16
+ /** Slots of the dedup window (power of two). */
+ #define TARGET_DEDUP_SLOTS 32
+
  /**
-  * @struct ReceivedFireSignal
-  * @brief Wraps a received NEC_DATA code with a timestamp.
-  *
-  * Allows filtering out repeated signals that arrive within NEC_VALID_TIME_MS.
+  * @struct TargetHit
+  * @brief A unique hit fused from all receivers that decoded the same code.
   */
- struct ReceivedFireSignal {
-     NEC_DATA data;     ///< The NEC 32-bit code
-     uint32_t lastTime; ///< millis() when this code was last accepted
- 
-     /**
-      * @brief Check whether enough time has passed to accept the same signal again.
-      * @return True if (millis() - lastTime) > NEC_VALID_TIME_MS
-      */
-     bool shouldStore() const {
-         return (millis() - lastTime) > NEC_VALID_TIME_MS;
-     }
+ struct TargetHit {
+     NEC_DATA code;     ///< The received fire code
+     uint8_t receivers; ///< Bit i set if receiver i decoded this shot
+     uint32_t time;     ///< millis() when the first receiver decoded it
  };
- 
+
+ static_assert((TARGET_HIT_QUEUE_SIZE & (TARGET_HIT_QUEUE_SIZE - 1)) == 0, "TARGET_HIT_QUEUE_SIZE must be a power of two");
+
  namespace Target {
      /// IR receiver instances (one per pin/ISR)
      static IRreceiver irReceivers[] = {
@@ -53,10 +54,14 @@
      };
      static const size_t irReceiversCount = 3;
  
-     /// Queue of unique hit codes waiting to be processed
-     static HyperList<NEC_DATA> hits;
-     /// Records recent signals to debounce duplicates
-     static HyperList<ReceivedFireSignal> receivedFireSignals;
+     /// Fused hits waiting to be processed, indexed by sequence number
+     static TargetHit hits[TARGET_HIT_QUEUE_SIZE];
+     static uint32_t hitHead = 0; ///< Sequence number of the next hit to store
+     static uint32_t hitTail = 0; ///< Sequence number of the next hit to read
+     /// Codes accepted within NEC_VALID_TIME_MS, mapped to their hit sequence number
+     static DedupWindow<uint32_t, TARGET_DEDUP_SLOTS> recentHits(NEC_VALID_TIME_MS);
+     static uint32_t duplicates = 0; ///< Frames merged into an accepted hit
+     static uint32_t hitDrops = 0;   ///< Hits lost because the queue was full
  
      /**
       * @brief Initialize all IR receivers and attach their ISRs.
@@ -68,86 +73,115 @@
      }
  
      /**
-      * @brief Poll each receiver, decode new NEC codes, and store unique hits.
-      *
-      * - Skips codes already in `hits`.
-      * - Uses `receivedFireSignals` to debounce repeats within NEC_VALID_TIME_MS.
+      * @brief Select the IR protocol decoded by all receivers.
+      * @param protocol Protocol chosen by the Manager for this game.
       */
-     void loop() {
-        bool skip = false, receivedContains = false;
-        for (int i = 0; i < irReceiversCount; i++) {
-            if (irReceivers[i].available()) {
-                NEC_DATA receivedData = irReceivers[i].read();
-
-                if (!hits.contains(receivedData)) {
-
-                    for (int j = 0; j < receivedFireSignals.size(); j++) {
-                        if (receivedFireSignals[j].data == receivedData) {
-                            receivedContains = true;
-
-                            if (receivedFireSignals[j].shouldStore()) {
-                                ReceivedFireSignal temp = receivedFireSignals[j];
-                                temp.lastTime = millis();
-                                receivedFireSignals.remove(j);
-                                receivedFireSignals.insert(j, temp);
-                                skip = false;
-                            } else {
-                                skip = true;
-                            }
+     void setProtocol(IRprotocolID protocol) {
+         for (size_t i = 0; i < irReceiversCount; ++i) {
+             irReceivers[i].setProtocols(irProtocolMask(protocol));
+         }
+     }
 
-                        }
-                        else {
-                            skip = false;
-                            receivedContains = false;
-                        }
-                    }
+     /**
+      * @brief Record one decoded frame, fusing it with a recent hit of the same code.
+      * @param code     Decoded fire code.
+      * @param receiver Index of the receiver that decoded it.
+      */
+     void fuse(NEC_DATA code, uint8_t receiver) {
+         uint32_t now = millis();
+         uint32_t* seq = recentHits.find(code.data, now);
+         if (seq) {
+             ++duplicates;
+             // Duplicate: mark the receiver if the hit has not been read yet
+             if (*seq - hitTail < hitHead - hitTail) {
+                 hits[*seq & (TARGET_HIT_QUEUE_SIZE - 1)].receivers |= 1 << receiver;
+             }
+             return;
+         }
+         if (hitHead - hitTail >= TARGET_HIT_QUEUE_SIZE) { // Queue full, drop
+             ++hitDrops;
+             return;
+         }
 
+         TargetHit& hit = hits[hitHead & (TARGET_HIT_QUEUE_SIZE - 1)];
+         hit.code = code;
+         hit.receivers = 1 << receiver;
+         hit.time = now;
+         *recentHits.insert(code.data, now) = hitHead++;
+     }
 
-                    if (skip) {
-                        continue;
-                    }
-                    else {
-                        hits.addend(receivedData);
-                        if (!receivedContains) {
-                            ReceivedFireSignal fireSignal = {receivedData, millis()};
-                            receivedFireSignals.addend(fireSignal);
-                        }
-                    }
-                }
-            }
-        }
-    }
+     /**
+      * @brief Poll each receiver, decode new codes, and store unique hits.
+      *
+      * - Decodes the edges each receiver captured since the last call.
+      * - Fuses copies of the same code into one hit within NEC_VALID_TIME_MS.
+      */
+     void loop() {
+         for (size_t i = 0; i < irReceiversCount; i++) {
+             irReceivers[i].decodeNEC();
+             while (irReceivers[i].available()) {
+                 fuse(irReceivers[i].read(), i);
+             }
+         }
+     }
  
      /**
       * @brief Number of pending hits.
       * @return Integer count.
       */
      int hasHit() {
-         return hits.size();
+         return hitHead - hitTail;
      }
  
      /**
-      * @brief Retrieve and remove the oldest hit code.
-      * @return The NEC_DATA of the hit.
+      * @brief Retrieve and remove the oldest hit.
+      * @return The fused hit (code, receivers that saw it and decode time).
       */
-     NEC_DATA readHit() {
-         NEC_DATA code = hits[0];
-         hits.remove(0);
-         return code;
+     TargetHit readHit() {
+         return hits[hitTail++ & (TARGET_HIT_QUEUE_SIZE - 1)];
      }
  
+     /**
+      * @brief Decode-quality counters summed over all receivers, plus fusion counters.
+      * @return Snapshot of the counters.
+      */
+     IRhitStats getStats() {
+         IRhitStats stats;
+         for (size_t i = 0; i < irReceiversCount; ++i) {
+             stats.decode += irReceivers[i].getStats();
+         }
+         stats.duplicates = duplicates;
+         stats.hitDrops = hitDrops;
+         return stats;
+     }
+
+     /**
+      * @brief Zero the counters of all receivers and the fusion counters.
+      */
+     void clearStats() {
+         for (size_t i = 0; i < irReceiversCount; ++i) {
+             irReceivers[i].clearStats();
+         }
+         duplicates = 0;
+         hitDrops = 0;
+     }
+
      /**
       * @brief Clear all pending hits and debounce history.
       */
      void clear() {
-         hits.clear();
-         receivedFireSignals.clear();
+         for (size_t i = 0; i < irReceiversCount; ++i) {
+             irReceivers[i].decodeNEC();
+             while (irReceivers[i].available()) irReceivers[i].read();
+         }
+         hitTail = hitHead;
+         recentHits.clear();
      }
  }
  
- // ISR implementations simply invoke the decoder on the corresponding receiver
- void IRAM_ATTR recvISR_0() { Target::irReceivers[0].decodeNEC(); }
- void IRAM_ATTR recvISR_1() { Target::irReceivers[1].decodeNEC(); }
- void IRAM_ATTR recvISR_2() { Target::irReceivers[2].decodeNEC(); }
+ // ISR implementations only timestamp the edge on the corresponding receiver
+ void IRAM_ATTR recvISR_0() { Target::irReceivers[0].captureEdge(); }
+ void IRAM_ATTR recvISR_1() { Target::irReceivers[1].captureEdge(); }
+ void IRAM_ATTR recvISR_2() { Target::irReceivers[2].captureEdge(); }
  
  #endif // TARGET_HPP 
\ No newline at end of file
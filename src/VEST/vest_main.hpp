@@ -5,16 +5,155 @@
  * Initializes subsystems (Ring, Target), connects to the Nexus network,
  * and in the main loop processes IR hits, game state updates, and
  * triggers the appropriate LED animations on the NeoPixel ring.
+ *
+ * The hit table the Manager sends at game start lists the opponents; fire
+ * codes of any other source are dropped on the vest. With local damage,
+ * hits are applied and animated as soon as they are decoded, and reported
+ * to the Manager as signed HitReports; otherwise the fire codes of each
+ * hitBatchWindowMS window are forwarded in one HitBatch and the Manager's
+ * HP update triggers the animation.
  */
 
  #include "Target/Target.hpp"              ///< Target subsystem for hit detection
  #include "Ring/Ring.hpp"                  ///< Ring subsystem for LED animations
  #include "Modules/Game.hpp"               ///< Game logic (status, hit processing)
+ #include "Modules/GameFlow.hpp"           ///< Table-driven status transitions
  #include "Common/LazerTagPacket.hpp"      ///< Communication packet definitions
  #include "Components/Nexus/Nexus.hpp"     ///< ESP-NOW networking
  
  int hp = 100;                             ///< Local copy of current health
  GameStatus game_status = GAME_WAITING;    ///< Local copy of current game status
+ IRprotocolID ir_protocol = GAME_DEFAULT_IR_PROTOCOL; ///< IR protocol selected for the game
+ bool hit_filter = false;                  ///< A hit table arrived for this game: forward opponents only
+ bool local_damage = false;                ///< The hit table asks to apply hits locally
+ HitAcceptSet hit_accept;                  ///< Accept-set: shooter IDs of the opponents
+ uint16_t hit_damage[256];                 ///< Weapon damage per shooter ID of an opponent
+ uint8_t hit_percent[DAMAGE_MASKS];        ///< Zone and range percent per receiver mask
+ uint8_t hit_gun[256];                     ///< Gun deviceID per shooter ID of an opponent (HIT_NO_GUN if none)
+ uint32_t hit_key[4];                      ///< Key for signing hit reports, derived from the hit table's nonce
+ uint16_t hit_seq = 0;                     ///< Number of the last hit report sent
+ HitBatch hit_batch = {};                  ///< Hits gathered in the current coalescing window
+ uint32_t hit_batch_start = 0;             ///< Decode time of the first hit in hit_batch
+
+ /** @brief Entry action of the countdown: shows the seconds left (0 on GO). */
+ void vest_countdown(GameStatus status, int) { Ring::countdown(GAME_GO - status); }
+ /** @brief Entry action of GAME_GO: countdown end, forget hits and counters from before the game. */
+ void vest_go(GameStatus status, int) {
+   vest_countdown(status, 0);
+   Target::clear();
+   Target::clearStats();
+ }
+ void vest_waiting(GameStatus, int) { Ring::load1(); }           ///< Entry action of GAME_WAITING
+ /** @brief Entry action of GAME_STARTING: the hit table of the last game no longer applies. */
+ void vest_starting(GameStatus, int) {
+   Ring::load2();
+   hit_filter = false;
+   local_damage = false;
+ }
+ void vest_running(GameStatus, int) { Ring::onGameStart(hp); }   ///< Entry action of GAME_RUNNING
+ void vest_over(GameStatus, int)    { Ring::over(); }            ///< Entry action of GAME_OVER
+ void vest_won(GameStatus, int)     { Ring::win(); }             ///< Entry action of GAME_WON
+ void vest_lost(GameStatus, int)    { Ring::lose(); }            ///< Entry action of GAME_LOST
+
+ /** @brief Vest actions per GameStatus: Ring animation per status, transitions come from the Manager. */
+ const GameActions vestActions[GameStatus_size] = {
+   /* GAME_WAITING  */ { vest_waiting,   nullptr },
+   /* GAME_STARTING */ { vest_starting,  nullptr },
+   /* GAME_THREE    */ { vest_countdown, nullptr },
+   /* GAME_TWO      */ { vest_countdown, nullptr },
+   /* GAME_ONE      */ { vest_countdown, nullptr },
+   /* GAME_GO       */ { vest_go,        nullptr },
+   /* GAME_RUNNING  */ { vest_running,   nullptr },
+   /* GAME_OVER     */ { vest_over,      nullptr },
+   /* GAME_WON      */ { vest_won,       nullptr },
+   /* GAME_LOST     */ { vest_lost,      nullptr }
+ };
+
+ GameFlow vestFlow(vestActions, game_status); ///< Drives game_status through gameStates with vestActions
+
+ /**
+  * @brief Checks a fire code against the accept-set of the hit table.
+  * @param firecode Raw fire code as received
+  * @param shooter  Output shooter ID
+  * @return True if the code is intact and comes from an opponent (always true without a table)
+  */
+ bool vest_accepts(uint32_t firecode, uint8_t &shooter) {
+   uint8_t shot;
+   if (!hit_filter) return true;
+   return Game::decodeFireCode(ir_protocol, firecode, shooter, shot)
+       && hit_accept.contains(shooter);
+ }
+
+ /**
+  * @brief Applies a hit from the hit table at once, confirms it to the shooter's gun and reports it to the Manager.
+  *
+  * The code must have passed vest_accepts(); hits on a dead player are
+  * dropped. The damage is computed like the Manager's damage table for an
+  * attacker without buff. The Manager answers with the HP only if it
+  * rejects the hit or computes a different result (e.g. a buffed attacker).
+  * @param firecode  Raw fire code as received
+  * @param shooter   Shooter ID decoded from it
+  * @param receivers Receivers that decoded the shot
+  */
+ void vest_localHit(uint32_t firecode, uint8_t shooter, uint8_t receivers) {
+   if (hp <= 0) return;
+
+   receivers &= DAMAGE_MASKS - 1;
+   uint16_t damage = min(hp, (int)Damage::scale(hit_damage[shooter], hit_percent[receivers], 100));
+   hp -= damage;
+   Ring::hit(hp);
+
+   // Hit marker straight to the shooter, one hop
+   if (hit_gun[shooter] != HIT_NO_GUN) {
+     HitMarker marker = { damage, hp == 0 };
+     Nexus::sendData(
+       COMMS_HITMARKER,
+       payloadSizePerCommand[COMMS_HITMARKER],
+       (uint8_t*)&marker,
+       NexusAddress(NEXUS_PROJECT_ID, NEXUS_GROUP_GUN, hit_gun[shooter])
+     );
+   }
+
+   HitReport report;
+   report.code = firecode;
+   report.hp = hp;
+   report.receivers = receivers;
+   report.seq = ++hit_seq;
+   signHitReport(report, hit_key);
+   Nexus::sendData(
+     COMMS_HITREPORT,
+     payloadSizePerCommand[COMMS_HITREPORT],
+     (uint8_t*)&report,
+     NexusAddress(NEXUS_PROJECT_ID, NEXUS_GROUP_MANAGER, 0xFF)
+   );
+ }
+
+ /**
+  * @brief Sends the gathered hits to the Manager in one frame and starts a new batch.
+  */
+ void vest_sendBatch() {
+   if (hit_batch.count == 0) return;
+   Nexus::sendData(
+     COMMS_HITBATCH,
+     payloadSizePerCommand[COMMS_HITBATCH],
+     (uint8_t*)&hit_batch,
+     NexusAddress(NEXUS_PROJECT_ID, NEXUS_GROUP_MANAGER, 0xFF)
+   );
+   hit_batch.count = 0;
+ }
+
+ /**
+  * @brief Adds a hit to the current batch; a full batch is sent at once.
+  * @param hit Fused hit from the Target subsystem
+  */
+ void vest_batchHit(const TargetHit &hit) {
+   if (hit_batch.count == 0) hit_batch_start = hit.time;
+   BatchedHit &entry = hit_batch.hits[hit_batch.count++];
+   entry.code = hit.code.data;
+   entry.offset = hit.time - hit_batch_start;
+   entry.receivers = hit.receivers;
+   if (hit_batch.count == HIT_BATCH_SIZE) vest_sendBatch();
+ }
  
  /**
   * @brief Called once at startup.
@@ -40,7 +179,7 @@
   * - Polls the Target subsystem for new IR hits.
   * - Updates Ring animations.
   * - Processes incoming Nexus packets to update health and game state.
-  * - Sends hit events to the Manager when appropriate.
+  * - Sends hit events to the Manager when appropriate, gathered per coalescing window.
   */
  void vest_loop() {
    // Update subsystems
@@ -48,25 +187,27 @@
    Ring::loop();
    Nexus::loop();
  
-   // If the vest has registered a hit, forward it to the manager
-   if (Target::hasHit() > 0) {
-     uint32_t firecode = Target::readHit().data;
-     if (game_status == GAME_RUNNING) {
-       // Send the firecode to all managers (broadcast to manager group)
-       Nexus::sendData(
-         COMMS_FIRECODE,
-         payloadSizePerCommand[COMMS_FIRECODE],
-         (uint8_t*)&firecode,
-         NexusAddress(NEXUS_PROJECT_ID, NEXUS_GROUP_MANAGER, 0xFF)
-       );
+   // For every hit by an opponent: apply it locally, or batch it for the manager
+   while (Target::hasHit() > 0) {
+     TargetHit hit = Target::readHit();
+     uint8_t shooter;
+     if (game_status != GAME_RUNNING || !vest_accepts(hit.code.data, shooter)) {
+       // Not playing, or noise, own team or another arena: drop
+     } else if (local_damage) {
+       vest_localHit(hit.code.data, shooter, hit.receivers);
+     } else {
+       vest_batchHit(hit);
      }
    }
+   // Send the batch once its window closed (broadcast to manager group)
+   if (hit_batch.count > 0 && millis() - hit_batch_start >= hitBatchWindowMS) {
+     vest_sendBatch();
+   }
  
    // Process all pending Nexus packets
    NexusPacket packet;
    while (Nexus::readPacket(packet)) {
      int lastHP = hp;
-     GameStatus prevStatus = game_status;
  
      switch (packet.command) {
        case COMMS_PLAYERHP:
@@ -75,30 +216,57 @@
          if (lastHP > hp) {
            // Health decreased → play hit animation
            Ring::hit(hp);
+         } else if (lastHP < hp) {
+           // Respawned or new round → show the HP bar again
+           Ring::onGameStart(hp);
          }
          break;
  
-       case COMMS_GAMESTATUS:
-         // Update game status from payload
-         memcpy(&game_status, packet.payload, payloadSizePerCommand[COMMS_GAMESTATUS]);
-         if (prevStatus != game_status) {
-           // On status change, trigger the corresponding Ring animation
-           switch (game_status) {
-             case GAME_WAITING:  Ring::load1();                       break;
-             case GAME_STARTING: Ring::load2();                       break;
-             case GAME_THREE:    Ring::countdown(3);                  break;
-             case GAME_TWO:      Ring::countdown(2);                  break;
-             case GAME_ONE:      Ring::countdown(1);                  break;
-             case GAME_GO:       Ring::countdown(0); Target::clear(); break;
-             case GAME_RUNNING:  Ring::onGameStart(hp);               break;
-             case GAME_OVER:     Ring::over();                        break;
-             case GAME_WON:      Ring::win();                         break;
-             case GAME_LOST:     Ring::lose();                        break;
-             default:                                           break;
-           }
-         }
+       case COMMS_GAMESTATUS: {
+         // On status change, run the entry action of the new status (Ring animation)
+         GameStatus next;
+         memcpy(&next, packet.payload, payloadSizePerCommand[COMMS_GAMESTATUS]);
+         vestFlow.enter(next);
          break;
+       }
  
+       case COMMS_IRPROTOCOL:
+         // Decode only the protocol selected for this game
+         memcpy(&ir_protocol, packet.payload, payloadSizePerCommand[COMMS_IRPROTOCOL]);
+         Target::setProtocol(ir_protocol);
+         break;
+
+       case COMMS_HITTABLE: {
+         // Opponents of this game: from now on only their hits count
+         HitTable table;
+         memcpy(&table, packet.payload, payloadSizePerCommand[COMMS_HITTABLE]);
+         hit_accept.load(table);
+         for (uint8_t i = 0; i < table.count && i < HIT_TABLE_SIZE; i++) {
+           uint8_t shooter = table.shooter[i];
+           hit_damage[shooter] = table.damage[i];
+           hit_gun[shooter] = table.gun[i];
+         }
+         memcpy(hit_percent, table.maskPercent, sizeof(hit_percent));
+         static const uint32_t secret[4] = HIT_REPORT_SECRET;
+         deriveHitKey(secret, NEXUS_PROJECT_ID, NEXUS_DEVICE_ID, table.nonce, hit_key);
+         hit_seq = 0;
+         hit_filter = true;
+         local_damage = table.localDamage;
+         break;
+       }
+
+       case COMMS_IRSTATS_REQUEST: {
+         // Reply with the decode counters of all receivers
+         IRhitStats stats = Target::getStats();
+         Nexus::sendData(
+           COMMS_IRSTATS,
+           payloadSizePerCommand[COMMS_IRSTATS],
+           (uint8_t*)&stats,
+           packet.source
+         );
+         break;
+       }
+
        case COMMS_MARK:
          // Play a brief "mark" animation (e.g. yellow flash)
          Ring::mark();
@@ -1,9 +1,9 @@
 /**
  * @file main.cpp
- * @brief Unified entry point that dispatches to the manager, gun, or vest application.
+ * @brief Unified entry point that dispatches to the manager, gun, vest, or spectator application.
  *
  * Depending on the DEVICE_TYPE macro, includes the appropriate main header
- * (manager_main.hpp, gun_main.hpp, or vest_main.hpp) and calls their
+ * (manager_main.hpp, gun_main.hpp, vest_main.hpp, or spectator_main.hpp) and calls their
  * setup() and loop() functions in the Arduino framework.
  */
 
@@ -20,6 +20,8 @@
  #include "GUN/gun_main.hpp"
  #elif DEVICE_TYPE == DEVICE_VEST
  #include "VEST/vest_main.hpp"
+ #elif DEVICE_TYPE == DEVICE_SPECTATOR
+ #include "SPECTATOR/spectator_main.hpp"
  #elif DEVICE_TYPE == 0
  #warning "DEVICE_TYPE is set to 0: no application code will be compiled."
  #else
@@ -31,7 +33,7 @@
  /**
   * @brief Arduino setup function.
   *
-  * Calls manager_setup(), gun_setup(), or vest_setup() based on DEVICE_TYPE.
+  * Calls manager_setup(), gun_setup(), vest_setup(), or spectator_setup() based on DEVICE_TYPE.
   */
  void setup() {
  #if DEVICE_TYPE == DEVICE_MANAGER
@@ -40,13 +42,15 @@
      gun_setup();
  #elif DEVICE_TYPE == DEVICE_VEST
      vest_setup();
+ #elif DEVICE_TYPE == DEVICE_SPECTATOR
+     spectator_setup();
  #endif
  }
  
  /**
   * @brief Arduino loop function.
   *
-  * Continuously calls manager_loop(), gun_loop(), or vest_loop()
+  * Continuously calls manager_loop(), gun_loop(), vest_loop(), or spectator_loop()
   * based on DEVICE_TYPE.
   */
  void loop() {
@@ -56,5 +60,7 @@
      gun_loop();
  #elif DEVICE_TYPE == DEVICE_VEST
      vest_loop();
+ #elif DEVICE_TYPE == DEVICE_SPECTATOR
+     spectator_loop();
  #endif
  } 
\ No newline at end of file
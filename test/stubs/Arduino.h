@@ -0,0 +1,164 @@
+/**
+ * @file Arduino.h
+ * @brief Minimal host stand-in for the Arduino core, used by the native test environment.
+ *
+ * Only what the modules under test touch is provided. Everything is header-only
+ * so no extra translation unit has to be linked into each suite. Time is
+ * simulated: tests move it with setMillis() / advanceMillis() / advanceMicros().
+ */
+
+ #ifndef NATIVE_ARDUINO_H
+ #define NATIVE_ARDUINO_H
+
+ #include <stdint.h>
+ #include <stddef.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <math.h>
+ #include <climits>
+ #include <string>
+ #include <algorithm>
+
+ typedef uint8_t byte;
+
+ #define IRAM_ATTR
+ #define INPUT 0x01
+ #define OUTPUT 0x03
+ #define INPUT_PULLUP 0x05
+ #define CHANGE 0x03
+ #define LOW 0x0
+ #define HIGH 0x1
+ #define HEX 16
+ #ifndef PI
+ #define PI 3.1415926535897932384626433832795
+ #endif
+
+ using std::min;
+ using std::max;
+
+ /** @brief Simulated millisecond clock shared by every translation unit. */
+ inline uint32_t &nativeMillis() { static uint32_t now = 0; return now; }
+ /** @brief Microseconds of the simulated clock past the current millisecond. */
+ inline uint32_t &nativeMicros() { static uint32_t part = 0; return part; }
+ /** @brief Sets the simulated clock. */
+ inline void setMillis(uint32_t now) { nativeMillis() = now; nativeMicros() = 0; }
+ /** @brief Moves the simulated clock forward. */
+ inline void advanceMillis(uint32_t ms) { nativeMillis() += ms; }
+ /** @brief Moves the simulated clock forward by microseconds (e.g. between IR edges). */
+ inline void advanceMicros(uint32_t us) {
+     uint32_t total = nativeMicros() + us;
+     nativeMillis() += total / 1000;
+     nativeMicros() = total % 1000;
+ }
+
+ inline uint32_t millis() { return nativeMillis(); }
+ inline uint32_t micros() { return nativeMillis() * 1000UL + nativeMicros(); }
+ inline void delay(uint32_t ms) { advanceMillis(ms); }
+ inline void delayMicroseconds(uint32_t) {}
+
+ inline void pinMode(uint8_t, uint8_t) {}
+ inline int digitalRead(uint8_t) { return LOW; }
+ inline void digitalWrite(uint8_t, uint8_t) {}
+ inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+ inline void attachInterrupt(uint8_t, void (*)(), int) {}
+ inline void detachInterrupt(uint8_t) {}
+ inline void noInterrupts() {}
+ inline void interrupts() {}
+
+ inline void ledcSetup(uint8_t, uint32_t, uint8_t) {}
+ inline void ledcAttachPin(uint8_t, uint8_t) {}
+ inline void ledcWrite(uint8_t, uint32_t) {}
+
+ inline long random(long howbig) { return howbig ? rand() % howbig : 0; }
+ inline long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+ inline uint32_t esp_random() { return (static_cast<uint32_t>(rand()) << 16) ^ static_cast<uint32_t>(rand()); }
+ inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+   return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+ }
+ template <class T, class L, class H>
+ inline T constrain(T x, L low, H high) { return x < low ? low : (x > high ? high : x); }
+
+ struct hw_timer_t;
+ inline hw_timer_t *timerBegin(uint8_t, uint16_t, bool) { return nullptr; }
+ inline void timerAttachInterrupt(hw_timer_t *, void (*)(), bool) {}
+ inline void timerAlarmWrite(hw_timer_t *, uint64_t, bool) {}
+ inline void timerAlarmEnable(hw_timer_t *) {}
+ inline void timerAlarmDisable(hw_timer_t *) {}
+ inline void timerWrite(hw_timer_t *, uint64_t) {}
+ inline void timerEnd(hw_timer_t *) {}
+
+ typedef struct { int owner; } portMUX_TYPE;
+ #define portMUX_INITIALIZER_UNLOCKED { 0 }
+ #define portENTER_CRITICAL(mux) (void)(mux)
+ #define portEXIT_CRITICAL(mux) (void)(mux)
+ #define portENTER_CRITICAL_ISR(mux) (void)(mux)
+ #define portEXIT_CRITICAL_ISR(mux) (void)(mux)
+
+ /** @brief std::string backed subset of the Arduino String class. */
+ class String {
+ public:
+   String() {}
+   String(const char *text) : str(text ? text : "") {}
+   String(const std::string &text) : str(text) {}
+   String(char c) : str(1, c) {}
+   String(int value, int base = 10) : str(format(value, base)) {}
+   String(unsigned int value, int base = 10) : str(format(value, base)) {}
+   String(long value, int base = 10) : str(format(value, base)) {}
+   String(unsigned long value, int base = 10) : str(format(value, base)) {}
+   String(float value) : str(std::to_string(value)) {}
+   String(double value) : str(std::to_string(value)) {}
+
+   String &operator+=(const String &other) { str += other.str; return *this; }
+   String operator+(const String &other) const { return String(str + other.str); }
+   bool operator==(const String &other) const { return str == other.str; }
+   bool operator!=(const String &other) const { return str != other.str; }
+
+   const char *c_str() const { return str.c_str(); }
+   unsigned int length() const { return str.size(); }
+   bool isEmpty() const { return str.empty(); }
+   char charAt(unsigned int index) const { return index < str.size() ? str[index] : 0; }
+   char operator[](unsigned int index) const { return charAt(index); }
+   int indexOf(const String &what, unsigned int from = 0) const {
+     size_t at = str.find(what.str, from);
+     return at == std::string::npos ? -1 : static_cast<int>(at);
+   }
+   String substring(unsigned int from) const { return from < str.size() ? String(str.substr(from)) : String(); }
+   String substring(unsigned int from, unsigned int to) const {
+     return from < str.size() && from < to ? String(str.substr(from, to - from)) : String();
+   }
+   bool startsWith(const String &prefix) const { return str.compare(0, prefix.str.size(), prefix.str) == 0; }
+   long toInt() const { return atol(str.c_str()); }
+   void toCharArray(char *buffer, unsigned int size) const {
+     if (!size) return;
+     size_t count = std::min<size_t>(size - 1, str.size());
+     memcpy(buffer, str.data(), count);
+     buffer[count] = 0;
+   }
+
+ private:
+   std::string str;
+
+   static std::string format(long long value, int base) {
+     if (base == 10) return std::to_string(value);
+     char buffer[24];
+     snprintf(buffer, sizeof(buffer), base == 16 ? "%llx" : "%llo", static_cast<unsigned long long>(value));
+     return buffer;
+   }
+ };
+
+ inline String operator+(const char *left, const String &right) { return String(left) + right; }
+
+ /** @brief Serial port that discards everything. */
+ struct NativeSerial {
+   void begin(unsigned long) {}
+   template <class T> size_t print(const T &) { return 0; }
+   template <class T> size_t print(const T &, int) { return 0; }
+   template <class T> size_t println(const T &) { return 0; }
+   template <class T> size_t println(const T &, int) { return 0; }
+   size_t println() { return 0; }
+   size_t printf(const char *, ...) { return 0; }
+ };
+ static NativeSerial Serial;
+
+ #endif // NATIVE_ARDUINO_H
@@ -0,0 +1,6 @@
+/**
+ * @file PushButton.hpp
+ * @brief Case-correct forward to Pushbutton.hpp for case-sensitive host file systems.
+ */
+
+ #include "../../../../src/Components/Pushbutton/Pushbutton.hpp"
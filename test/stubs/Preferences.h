@@ -0,0 +1,57 @@
+/**
+ * @file Preferences.h
+ * @brief Host stand-in for the ESP32 Preferences (NVS) library, used by the native test environment.
+ *
+ * Keeps every namespace in memory for the lifetime of the test process, so a
+ * suite can write, "reboot" and read back. Tests may reach into storage()
+ * to corrupt or erase entries.
+ */
+
+ #ifndef NATIVE_PREFERENCES_H
+ #define NATIVE_PREFERENCES_H
+
+ #include <Arduino.h>
+ #include <map>
+ #include <vector>
+
+ /** @brief In-memory key/value store with the Preferences byte API. */
+ class Preferences {
+ public:
+   /** @brief Every stored entry, keyed by "namespace/key". */
+   static std::map<std::string, std::vector<uint8_t>> &storage() {
+     static std::map<std::string, std::vector<uint8_t>> entries;
+     return entries;
+   }
+
+   bool begin(const char *name, bool readOnly = false) {
+     space = name;
+     readonly = readOnly;
+     return true;
+   }
+   void end() { space.clear(); }
+
+   size_t putBytes(const char *key, const void *value, size_t len) {
+     if (readonly || space.empty()) return 0;
+     const uint8_t *bytes = static_cast<const uint8_t *>(value);
+     storage()[space + "/" + key].assign(bytes, bytes + len);
+     return len;
+   }
+
+   size_t getBytes(const char *key, void *buf, size_t maxLen) {
+     std::map<std::string, std::vector<uint8_t>>::const_iterator entry = storage().find(space + "/" + key);
+     if (entry == storage().end() || entry->second.size() > maxLen) return 0;
+     memcpy(buf, entry->second.data(), entry->second.size());
+     return entry->second.size();
+   }
+
+   size_t getBytesLength(const char *key) {
+     std::map<std::string, std::vector<uint8_t>>::const_iterator entry = storage().find(space + "/" + key);
+     return entry == storage().end() ? 0 : entry->second.size();
+   }
+
+ private:
+   std::string space;
+   bool readonly = false;
+ };
+
+ #endif // NATIVE_PREFERENCES_H
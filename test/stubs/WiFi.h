@@ -0,0 +1,20 @@
+/**
+ * @file WiFi.h
+ * @brief Host stand-in for the ESP32 WiFi class, used by the native test environment.
+ */
+
+ #ifndef NATIVE_WIFI_H
+ #define NATIVE_WIFI_H
+
+ #include <Arduino.h>
+
+ #define WIFI_STA 1
+
+ /** @brief WiFi driver that accepts every call. */
+ struct NativeWiFi {
+   bool mode(int) { return true; }
+   String macAddress() { return "00:00:00:00:00:00"; }
+ };
+ static NativeWiFi WiFi;
+
+ #endif // NATIVE_WIFI_H
@@ -0,0 +1,33 @@
+/**
+ * @file esp_now.h
+ * @brief Host stand-in for the ESP-NOW driver, used by the native test environment.
+ *
+ * Nothing is sent; esp_now_send() only counts the frames handed to it.
+ */
+
+ #ifndef NATIVE_ESP_NOW_H
+ #define NATIVE_ESP_NOW_H
+
+ #include <stdint.h>
+ #include <stddef.h>
+
+ #define ESP_NOW_MAX_DATA_LEN 250
+ #define ESP_OK 0
+
+ typedef int esp_err_t;
+
+ typedef struct {
+   uint8_t peer_addr[6];
+   uint8_t channel;
+   bool encrypt;
+ } esp_now_peer_info_t;
+
+ inline esp_err_t esp_now_init() { return ESP_OK; }
+ inline esp_err_t esp_now_deinit() { return ESP_OK; }
+ inline esp_err_t esp_now_register_recv_cb(void (*)(const uint8_t *, const uint8_t *, int)) { return ESP_OK; }
+ inline esp_err_t esp_now_add_peer(const esp_now_peer_info_t *) { return ESP_OK; }
+ /** @brief Frames passed to esp_now_send() so far; tests may reset it. */
+ inline unsigned &espNowFramesSent() { static unsigned count = 0; return count; }
+ inline esp_err_t esp_now_send(const uint8_t *, const uint8_t *, size_t) { espNowFramesSent()++; return ESP_OK; }
+
+ #endif // NATIVE_ESP_NOW_H
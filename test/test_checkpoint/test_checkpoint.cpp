@@ -0,0 +1,200 @@
+/**
+ * @file test_checkpoint.cpp
+ * @brief Host tests for the match checkpoints: record round trip, write policy and restore after a reboot.
+ *
+ * The NVS store runs on the in-memory Preferences of test/stubs.
+ */
+
+ #include <unity.h>
+ #include <chrono>
+ #include <Preferences.h>
+ #include "Modules/Checkpoint.hpp"
+ #include "Common/Constants_Common.h"
+
+ static int writes;        ///< Slot writes since setUp()
+ static uint8_t lastSlot;  ///< Slot of the last write
+
+ static bool countingWrite(uint8_t slot, const uint8_t *data, size_t size) {
+     writes++;
+     lastSlot = slot;
+     return Checkpoint::nvsWrite(slot, data, size);
+ }
+
+ /** @brief Puts the matches into the state of a freshly booted Manager. */
+ static void boot() {
+     Game::begin(10);
+     Game::select(0);
+     for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+         Match &match = Game::matches[i];
+         match.reset();
+         match.setPlayerCount(2);
+         for (uint8_t p = 0; p < GAME_MAX_PLAYERS; p++) {
+             match.players[p].resetHP();
+             match.players[p].clearGun();
+             match.players[p].clearVest();
+         }
+     }
+ }
+
+ /** @brief Starts match 1 with two equipped players and lets the clock reach its next check. */
+ static void startMatch() {
+     Match &match = Game::matches[1];
+     for (uint8_t p = 0; p < 2; p++) {
+         match.players[p].setGunAddress(NexusAddress(11, NEXUS_GROUP_GUN, 30 + p));
+         match.players[p].setVestAddress(NexusAddress(11, NEXUS_GROUP_VEST, 40 + p));
+     }
+     match.players[1].setGunData(Hammerfall);
+     match.players[1].setGunName("Hammerfall");
+     match.start();
+     match.setStatus(GAME_RUNNING);
+ }
+
+ /** @brief Raw slot contents of the NVS store. */
+ static std::vector<uint8_t> &slot(uint8_t index) {
+     char key[24];
+     snprintf(key, sizeof(key), "checkpoint/slot%u", index);
+     return Preferences::storage()[key];
+ }
+
+ void setUp() {
+     Preferences::storage().clear();
+     setMillis(100000);
+     boot();
+     Checkpoint::setStore(countingWrite, Checkpoint::nvsRead);
+     Checkpoint::restore(); // empty store: takes the current state as written
+     writes = 0;
+ }
+
+ void tearDown() {}
+
+ void test_record_round_trip() {
+     startMatch();
+     advanceMillis(CHECKPOINT_INTERVAL_MS);
+     Checkpoint::loop();
+     TEST_ASSERT_EQUAL(1, writes);
+
+     CheckpointRecord record;
+     TEST_ASSERT_TRUE(Checkpoint::nvsRead(lastSlot, (uint8_t*)&record, sizeof(record)));
+     TEST_ASSERT_TRUE(Checkpoint::intact(record));
+     TEST_ASSERT_EQUAL_UINT32(CHECKPOINT_MAGIC, record.magic);
+     TEST_ASSERT_EQUAL_UINT8(1, record.match.state.match);
+     TEST_ASSERT_EQUAL_UINT8(GAME_RUNNING, record.match.state.header.status);
+     TEST_ASSERT_EQUAL_UINT8(41, record.match.state.players[1].vest);
+     TEST_ASSERT_EQUAL_UINT32(Hammerfall.damage, record.match.gunData[1].damage);
+     TEST_ASSERT_EQUAL_STRING("Hammerfall", record.match.gunName[1]);
+
+     // Any damaged byte fails the checksum
+     CheckpointRecord damaged = record;
+     ((uint8_t*)&damaged)[sizeof(damaged) / 2] ^= 0x10;
+     TEST_ASSERT_FALSE(Checkpoint::intact(damaged));
+     damaged = record;
+     damaged.magic = 0;
+     TEST_ASSERT_FALSE(Checkpoint::intact(damaged));
+
+     // The stored record matches a fresh capture apart from sequence and checksum
+     CheckpointRecord captured;
+     Checkpoint::capture(1, captured);
+     TEST_ASSERT_EQUAL_MEMORY(&record.match, &captured.match, sizeof(captured.match));
+ }
+
+ void test_only_changed_matches_are_written_per_interval() {
+     advanceMillis(CHECKPOINT_INTERVAL_MS);
+     Checkpoint::loop();
+     TEST_ASSERT_EQUAL(0, writes); // idle matches cost no flash
+
+     startMatch();
+     advanceMillis(CHECKPOINT_INTERVAL_MS - 1);
+     Checkpoint::loop();
+     TEST_ASSERT_EQUAL(0, writes); // not checked yet
+
+     advanceMillis(1);
+     Checkpoint::loop();
+     TEST_ASSERT_EQUAL(1, writes);
+     uint8_t first = lastSlot;
+     TEST_ASSERT_EQUAL_UINT8(1, first / CHECKPOINT_SLOTS);
+
+     // Many hits within one interval cost one write, in the other slot of the match
+     for (int hp = 90; hp > 40; hp -= 10) {
+         Game::matches[1].players[0].setHP(hp);
+         advanceMillis(100);
+         Checkpoint::loop();
+     }
+     TEST_ASSERT_EQUAL(1, writes);
+     advanceMillis(CHECKPOINT_INTERVAL_MS);
+     Checkpoint::loop();
+     TEST_ASSERT_EQUAL(2, writes);
+     TEST_ASSERT_EQUAL_UINT8(1, lastSlot / CHECKPOINT_SLOTS);
+     TEST_ASSERT_NOT_EQUAL(first, lastSlot);
+
+     // The running clock alone is no change
+     advanceMillis(CHECKPOINT_INTERVAL_MS);
+     Checkpoint::loop();
+     TEST_ASSERT_EQUAL(2, writes);
+ }
+
+ void test_restore_after_reboot() {
+     startMatch();
+     Game::matches[1].players[0].setHP(35);
+     Game::select(1);
+     advanceMillis(CHECKPOINT_INTERVAL_MS);
+     Checkpoint::loop();
+     uint8_t matchNumber = Game::matchNumber;
+
+     boot();
+     Game::matchNumber = 0;
+     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+     TEST_ASSERT_TRUE(Checkpoint::restore());
+     char line[64];
+     snprintf(line, sizeof(line), "restore took %.1f us on the host",
+              std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+     TEST_MESSAGE(line);
+
+     Match &match = Game::matches[1];
+     TEST_ASSERT_EQUAL(GAME_RUNNING, match.status);
+     TEST_ASSERT_EQUAL_INT(35, match.players[0].getHP());
+     TEST_ASSERT_TRUE(match.players[1].getVestAddress() == NexusAddress(11, NEXUS_GROUP_VEST, 41));
+     TEST_ASSERT_EQUAL_UINT32(Hammerfall.damage, match.players[1].getGunData().damage);
+     TEST_ASSERT_EQUAL_UINT8(1, Game::selected);
+     TEST_ASSERT_EQUAL_UINT8(matchNumber, Game::matchNumber);
+     TEST_ASSERT_EQUAL_UINT8(1, match.vestToPlayer[41]);
+
+     // Nothing changed since the restore: no write
+     advanceMillis(CHECKPOINT_INTERVAL_MS);
+     Checkpoint::loop();
+     TEST_ASSERT_EQUAL(1, writes);
+ }
+
+ void test_torn_write_falls_back_to_older_slot() {
+     startMatch();
+     Game::matches[1].players[0].setHP(80);
+     advanceMillis(CHECKPOINT_INTERVAL_MS);
+     Checkpoint::loop();
+     Game::matches[1].players[0].setHP(20);
+     advanceMillis(CHECKPOINT_INTERVAL_MS);
+     Checkpoint::loop();
+     TEST_ASSERT_EQUAL(2, writes);
+
+     // Power lost halfway through the second write
+     std::vector<uint8_t> &newest = slot(lastSlot);
+     memset(newest.data() + newest.size() / 2, 0xFF, newest.size() / 2);
+
+     boot();
+     TEST_ASSERT_TRUE(Checkpoint::restore());
+     TEST_ASSERT_EQUAL_INT(80, Game::matches[1].players[0].getHP());
+
+     // The next write goes to the damaged slot, keeping the intact one
+     Game::matches[1].players[0].setHP(10);
+     advanceMillis(CHECKPOINT_INTERVAL_MS);
+     uint8_t torn = lastSlot;
+     Checkpoint::loop();
+     TEST_ASSERT_EQUAL_UINT8(torn, lastSlot);
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_record_round_trip);
+     RUN_TEST(test_only_changed_matches_are_written_per_interval);
+     RUN_TEST(test_restore_after_reboot);
+     RUN_TEST(test_torn_write_falls_back_to_older_slot);
+     return UNITY_END();
+ }
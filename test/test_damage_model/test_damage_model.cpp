@@ -0,0 +1,79 @@
+/**
+ * @file test_damage_model.cpp
+ * @brief Host tests for the damage model compiler and the per-match damage tables.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+
+ void setUp() {}
+ void tearDown() {}
+
+ void test_standard_model_is_flat() {
+     uint8_t percent[DAMAGE_MASKS];
+     Damage::compileMasks(Damage::standard, percent);
+     for (uint8_t mask = 0; mask < DAMAGE_MASKS; mask++) {
+         TEST_ASSERT_EQUAL_UINT8(100, percent[mask]);
+     }
+ }
+
+ void test_zones_model_takes_best_zone_and_range() {
+     uint8_t percent[DAMAGE_MASKS];
+     Damage::compileMasks(Damage::zones, percent);
+     TEST_ASSERT_EQUAL_UINT8(100, percent[0]); // not reported: front, full range
+     TEST_ASSERT_EQUAL_UINT8(70, percent[1]);  // front, far
+     TEST_ASSERT_EQUAL_UINT8(105, percent[2]); // back, far
+     TEST_ASSERT_EQUAL_UINT8(49, percent[4]);  // shoulder, far
+     TEST_ASSERT_EQUAL_UINT8(128, percent[3]); // front + back: back, 2 receivers (127.5 rounded)
+     TEST_ASSERT_EQUAL_UINT8(85, percent[5]);  // front + shoulder: front, 2 receivers
+     TEST_ASSERT_EQUAL_UINT8(150, percent[7]); // all three: back, close
+ }
+
+ void test_mask_percent_saturates() {
+     const DamageModel brutal = { "Brutal", { 200, 200, 200 }, { 200, 200, 200, 200 }, { 100, 100, 100, 100 }, 0 };
+     uint8_t percent[DAMAGE_MASKS];
+     Damage::compileMasks(brutal, percent);
+     for (uint8_t mask = 0; mask < DAMAGE_MASKS; mask++) {
+         TEST_ASSERT_EQUAL_UINT8(255, percent[mask]);
+     }
+ }
+
+ void test_scale_rounds_to_nearest() {
+     TEST_ASSERT_EQUAL_UINT16(25, Damage::scale(25, 100, 100));
+     TEST_ASSERT_EQUAL_UINT16(18, Damage::scale(25, 70, 100));  // 17.5
+     TEST_ASSERT_EQUAL_UINT16(41, Damage::scale(33, 100, 125)); // 41.25
+     TEST_ASSERT_EQUAL_UINT16(0, Damage::scale(0, 150, 200));
+     TEST_ASSERT_EQUAL_UINT16(100, Damage::scale(25, 200, 200));
+ }
+
+ void test_match_compiles_table_from_weapons_and_model() {
+     Match *match = new Match();
+     match->damageModel = &Damage::zones;
+     match->players[0].setGunData(Stinger);
+     match->players[1].setGunData(Hammerfall);
+     match->start();
+
+     for (uint8_t attacker = 0; attacker < 2; attacker++) {
+         TEST_ASSERT_EQUAL_UINT32(match->players[attacker].getGunDamage(), match->gunDamage[attacker]);
+         for (uint8_t level = 0; level < DAMAGE_BUFF_LEVELS; level++) {
+             for (uint8_t mask = 0; mask < DAMAGE_MASKS; mask++) {
+                 TEST_ASSERT_EQUAL_UINT16(
+                     Damage::scale(match->gunDamage[attacker], match->maskPercent[mask], Damage::zones.buffPercent[level]),
+                     match->damageTable[attacker][level][mask]);
+             }
+         }
+     }
+     // Back hit at close range with a double-damage buff: 1.5 * 2 = 3x
+     TEST_ASSERT_EQUAL_UINT16((match->gunDamage[1] * 300 + 50) / 100, match->damageTable[1][3][7]);
+     delete match;
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_standard_model_is_flat);
+     RUN_TEST(test_zones_model_takes_best_zone_and_range);
+     RUN_TEST(test_mask_percent_saturates);
+     RUN_TEST(test_scale_rounds_to_nearest);
+     RUN_TEST(test_match_compiles_table_from_weapons_and_model);
+     return UNITY_END();
+ }
@@ -0,0 +1,86 @@
+/**
+ * @file test_dedup_window.cpp
+ * @brief Host tests for DedupWindow, the hashed set that fuses duplicate receiver hits.
+ */
+
+ #include <unity.h>
+ #include "Utilities/DedupWindow.hpp"
+
+ /** Window used by every test: 16 slots, 4 probes, entries live for 100 ticks. */
+ typedef DedupWindow<uint8_t, 16, 4> Window;
+
+ void setUp() {}
+ void tearDown() {}
+
+ void test_insert_then_find() {
+     Window window(100);
+     TEST_ASSERT_NULL(window.find(0x1234, 0));
+
+     uint8_t *value = window.insert(0x1234, 0);
+     TEST_ASSERT_NOT_NULL(value);
+     TEST_ASSERT_EQUAL_UINT8(0, *value);
+     *value = 7;
+
+     uint8_t *found = window.find(0x1234, 50);
+     TEST_ASSERT_EQUAL_PTR(value, found);
+     TEST_ASSERT_EQUAL_UINT8(7, *found);
+     TEST_ASSERT_NULL(window.find(0x4321, 50));
+ }
+
+ void test_entry_expires_after_window() {
+     Window window(100);
+     window.insert(42, 1000);
+     TEST_ASSERT_NOT_NULL(window.find(42, 1099));
+     TEST_ASSERT_NULL(window.find(42, 1100));
+ }
+
+ void test_expiry_survives_clock_wrap() {
+     Window window(100);
+     uint32_t start = UINT32_MAX - 10;
+     window.insert(42, start);
+     TEST_ASSERT_NOT_NULL(window.find(42, start + 50)); // wrapped past zero
+     TEST_ASSERT_NULL(window.find(42, start + 100));
+ }
+
+ void test_reinsert_after_expiry_resets_payload() {
+     Window window(100);
+     *window.insert(42, 0) = 3;
+     uint8_t *value = window.insert(42, 200);
+     TEST_ASSERT_EQUAL_UINT8(0, *value);
+     TEST_ASSERT_NOT_NULL(window.find(42, 250));
+ }
+
+ void test_full_window_evicts_soonest_to_expire() {
+     Window window(100);
+     // Fill far more keys than slots; the oldest must give way, the newest stay.
+     for (uint32_t key = 0; key < 64; ++key) {
+         window.insert(key, key);
+     }
+     TEST_ASSERT_NOT_NULL(window.find(63, 63));
+     size_t live = 0;
+     for (uint32_t key = 0; key < 64; ++key) {
+         if (window.find(key, 63)) ++live;
+     }
+     TEST_ASSERT_LESS_OR_EQUAL(Window::capacity(), live);
+     TEST_ASSERT_NULL(window.find(0, 63));
+ }
+
+ void test_clear_forgets_everything() {
+     Window window(100);
+     window.insert(1, 0);
+     window.insert(2, 0);
+     window.clear();
+     TEST_ASSERT_NULL(window.find(1, 1));
+     TEST_ASSERT_NULL(window.find(2, 1));
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_insert_then_find);
+     RUN_TEST(test_entry_expires_after_window);
+     RUN_TEST(test_expiry_survives_clock_wrap);
+     RUN_TEST(test_reinsert_after_expiry_resets_payload);
+     RUN_TEST(test_full_window_evicts_soonest_to_expire);
+     RUN_TEST(test_clear_forgets_everything);
+     return UNITY_END();
+ }
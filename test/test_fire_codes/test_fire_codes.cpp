@@ -0,0 +1,82 @@
+/**
+ * @file test_fire_codes.cpp
+ * @brief Host tests for the shooter ID table: distance, coset rotation and reserved values.
+ */
+
+ #include <unity.h>
+ #include "Modules/FireCodes.hpp"
+
+ void setUp() {}
+ void tearDown() {}
+
+ /** @brief Hamming distance between two bytes. */
+ static uint8_t distance(uint8_t a, uint8_t b) { return FireCodes::popcount8(a ^ b); }
+
+ void test_ids_of_a_match_keep_minimum_distance() {
+     for (uint8_t match = 0; match < FIRE_CODE_COSETS; ++match) {
+         for (uint8_t i = 0; i < FIRE_CODE_COUNT; ++i) {
+             for (uint8_t j = i + 1; j < FIRE_CODE_COUNT; ++j) {
+                 TEST_ASSERT_GREATER_OR_EQUAL(FIRE_CODE_MIN_DISTANCE,
+                     distance(FireCodes::shooterID(match, i), FireCodes::shooterID(match, j)));
+             }
+         }
+     }
+ }
+
+ void test_three_bit_errors_never_yield_another_id() {
+     for (uint8_t i = 0; i < FIRE_CODE_COUNT; ++i) {
+         uint8_t id = FireCodes::shooterID(0, i);
+         for (uint16_t error = 1; error < 256; ++error) {
+             if (FireCodes::popcount8(error) > 3) continue;
+             for (uint8_t j = 0; j < FIRE_CODE_COUNT; ++j) {
+                 if (j != i) TEST_ASSERT_NOT_EQUAL(FireCodes::shooterID(0, j), id ^ error);
+             }
+         }
+     }
+ }
+
+ void test_matches_use_disjoint_ids() {
+     bool seen[256] = { false };
+     for (uint8_t match = 0; match < FIRE_CODE_COSETS; ++match) {
+         for (uint8_t i = 0; i < FIRE_CODE_COUNT; ++i) {
+             uint8_t id = FireCodes::shooterID(match, i);
+             TEST_ASSERT_FALSE(seen[id]);
+             seen[id] = true;
+         }
+     }
+ }
+
+ void test_remote_addresses_are_never_assigned() {
+     for (uint16_t match = 0; match < 256; ++match) {
+         for (uint8_t i = 0; i < FIRE_CODE_COUNT; ++i) {
+             uint8_t id = FireCodes::shooterID(match, i);
+             TEST_ASSERT_NOT_EQUAL(0x00, id);
+             TEST_ASSERT_NOT_EQUAL(0xFF, id);
+         }
+     }
+ }
+
+ void test_rotation_wraps_after_every_coset() {
+     for (uint8_t i = 0; i < FIRE_CODE_COUNT; ++i) {
+         TEST_ASSERT_EQUAL_HEX8(FireCodes::shooterID(0, i), FireCodes::shooterID(FIRE_CODE_COSETS, i));
+         TEST_ASSERT_NOT_EQUAL(FireCodes::shooterID(0, i), FireCodes::shooterID(1, i));
+     }
+ }
+
+ void test_codewords_are_recognised() {
+     for (uint8_t i = 0; i < FIRE_CODE_COUNT; ++i) {
+         TEST_ASSERT_TRUE(FireCodes::isCodeword(FireCodes::table[i]));
+         TEST_ASSERT_FALSE(FireCodes::isCodeword(FireCodes::table[i] ^ 0x01));
+     }
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_ids_of_a_match_keep_minimum_distance);
+     RUN_TEST(test_three_bit_errors_never_yield_another_id);
+     RUN_TEST(test_matches_use_disjoint_ids);
+     RUN_TEST(test_remote_addresses_are_never_assigned);
+     RUN_TEST(test_rotation_wraps_after_every_coset);
+     RUN_TEST(test_codewords_are_recognised);
+     return UNITY_END();
+ }
@@ -0,0 +1,112 @@
+/**
+ * @file test_game_flow.cpp
+ * @brief Host tests for GameFlow: entry/exit order, timed transitions over gameStates and outside changes.
+ */
+
+ #include <unity.h>
+ #include "Modules/GameFlow.hpp"
+
+ static char calls[64];    ///< Actions in call order: 'x' exit, 'e' entry, 't' transition, then the status digit
+ static size_t callCount;  ///< Characters in calls
+ static int lastParameter; ///< Parameter of the last call
+
+ static void note(char kind, GameStatus status, int parameter) {
+     calls[callCount++] = kind;
+     calls[callCount++] = '0' + status;
+     calls[callCount] = '\0';
+     lastParameter = parameter;
+ }
+ static void onEnter(GameStatus status, int parameter)      { note('e', status, parameter); }
+ static void onExit(GameStatus status, int parameter)       { note('x', status, parameter); }
+ static void onTransition(GameStatus status, int parameter) { note('t', status, parameter); }
+
+ /** Every status notes its entry and exit. */
+ static const GameActions actions[GameStatus_size] = {
+     { onEnter, onExit }, { onEnter, onExit }, { onEnter, onExit }, { onEnter, onExit }, { onEnter, onExit },
+     { onEnter, onExit }, { onEnter, onExit }, { onEnter, onExit }, { onEnter, onExit }, { onEnter, onExit }
+ };
+
+ static GameStatus status; ///< Status driven by the flow under test
+
+ void setUp() {
+     setMillis(1000);
+     status = GAME_WAITING;
+     callCount = 0;
+     calls[0] = '\0';
+ }
+ void tearDown() {}
+
+ void test_enter_runs_exit_entry_and_observer() {
+     GameFlow flow(actions, status, onTransition, 3);
+     TEST_ASSERT_TRUE(flow.enter(GAME_STARTING));
+     TEST_ASSERT_EQUAL_STRING("x0e1t1", calls);
+     TEST_ASSERT_EQUAL(3, lastParameter);
+     TEST_ASSERT_EQUAL(GAME_STARTING, status);
+
+     // Same status or out of range: no transition
+     TEST_ASSERT_FALSE(flow.enter(GAME_STARTING));
+     TEST_ASSERT_FALSE(flow.enter(GameStatus_size));
+     TEST_ASSERT_EQUAL(6, callCount);
+ }
+
+ void test_countdown_and_results_follow_the_shared_table() {
+     GameFlow flow(actions, status);
+     flow.enter(GAME_THREE);
+     const GameStatus steps[] = { GAME_TWO, GAME_ONE, GAME_GO, GAME_RUNNING };
+     for (uint8_t i = 0; i < 4; i++) {
+         advanceMillis(GAME_COUNTDOWN_STEP_MS - 1);
+         flow.loop();
+         TEST_ASSERT_EQUAL(steps[i] - 1, status);
+         advanceMillis(1);
+         flow.loop();
+         TEST_ASSERT_EQUAL(steps[i], status);
+     }
+     // Running has no timeout
+     advanceMillis(600000);
+     flow.loop();
+     TEST_ASSERT_EQUAL(GAME_RUNNING, status);
+
+     flow.enter(GAME_OVER);
+     advanceMillis(GAME_RESULTS_DELAY_MS);
+     flow.loop();
+     TEST_ASSERT_EQUAL(GAME_WON, status);
+ }
+
+ void test_outside_change_drops_the_timer() {
+     GameFlow flow(actions, status);
+     flow.enter(GAME_THREE);
+     status = GAME_WAITING; // e.g. Game::reset()
+     flow.loop();
+     status = GAME_THREE;   // same status again, but not entered through the flow
+     advanceMillis(GAME_COUNTDOWN_STEP_MS);
+     flow.loop();
+     TEST_ASSERT_EQUAL(GAME_THREE, status);
+ }
+
+ void test_follower_without_loop_waits_for_the_manager() {
+     GameFlow flow(actions, status);
+     flow.enter(GAME_OVER);
+     advanceMillis(GAME_RESULTS_DELAY_MS * 2);
+     TEST_ASSERT_EQUAL(GAME_OVER, status);
+     TEST_ASSERT_TRUE(flow.enter(GAME_LOST));
+     TEST_ASSERT_EQUAL(GAME_LOST, flow.getStatus());
+ }
+
+ void test_table_rows_are_consistent() {
+     for (uint8_t s = 0; s < GameStatus_size; s++) {
+         const GameState &row = gameStates[s];
+         TEST_ASSERT_TRUE(row.next < GameStatus_size);
+         // A status either stays or moves on after a while
+         TEST_ASSERT_EQUAL(row.timeout == 0, row.next == s);
+     }
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_enter_runs_exit_entry_and_observer);
+     RUN_TEST(test_countdown_and_results_follow_the_shared_table);
+     RUN_TEST(test_outside_change_drops_the_timer);
+     RUN_TEST(test_follower_without_loop_waits_for_the_manager);
+     RUN_TEST(test_table_rows_are_consistent);
+     return UNITY_END();
+ }
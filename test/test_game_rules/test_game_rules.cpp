@@ -0,0 +1,106 @@
+/**
+ * @file test_game_rules.cpp
+ * @brief Host tests for the game modes' timers: respawn, invulnerability, match clock and round breaks.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+
+ static Match *match; ///< Match 0 of Game::matches, two players, not yet running
+ static uint8_t shot; ///< Next shot counter of player 1
+
+ void setUp() {
+     setMillis(1000);
+     shot = 0;
+     Game::begin(10);
+     match = &Game::matches[0];
+     for (uint8_t i = 0; i < 2; i++) {
+         match->players[i].setGunAddress(NexusAddress(10, 0, 10 + i));
+         match->players[i].setVestAddress(NexusAddress(10, 0, 20 + i));
+     }
+ }
+ void tearDown() {}
+
+ /** @brief Starts the match in mode @p rules and arms its timers. */
+ static void play(const GameRules &rules) {
+     match->setRules(rules);
+     match->start();
+     match->setStatus(GAME_RUNNING);
+     match->play();
+ }
+
+ /** @brief Player 1 hits player 2 once with 1 HP left. */
+ static bool kill() {
+     match->players[1].setHP(1);
+     NEC_DATA code(Game::encodeFireCode(match->irProtocol, match->fireSignals[0].address, shot++));
+     return match->processHit(21, code, 0x01);
+ }
+
+ /** @brief Lets @p ms pass and fires the timers due. */
+ static void wait(uint32_t ms) {
+     advanceMillis(ms);
+     countdowner->loop();
+ }
+
+ void test_respawn_then_invulnerability() {
+     play(Rules::deathmatch);
+     TEST_ASSERT_TRUE(kill());
+     TEST_ASSERT_EQUAL_UINT16(1, match->topScore);
+     TEST_ASSERT_EQUAL_HEX32(0x02, match->protectedMask);
+
+     wait(Rules::deathmatch.respawnDelay - 1);
+     TEST_ASSERT_FALSE(match->players[1].isAlive());
+     wait(1);
+     TEST_ASSERT_EQUAL(100, match->players[1].getHP());
+     // Alive again but still protected
+     TEST_ASSERT_FALSE(kill());
+
+     wait(Rules::deathmatch.invulnerability);
+     TEST_ASSERT_EQUAL_HEX32(0, match->protectedMask);
+     TEST_ASSERT_TRUE(kill());
+ }
+
+ void test_clock_ends_a_deathmatch() {
+     play(Rules::deathmatch);
+     wait(Rules::deathmatch.duration - 1);
+     TEST_ASSERT_FALSE(match->shouldEnd());
+     wait(1);
+     TEST_ASSERT_TRUE(match->shouldEnd());
+ }
+
+ void test_timers_of_a_restarted_match_are_ignored() {
+     play(Rules::deathmatch);
+     TEST_ASSERT_TRUE(kill());
+     // Restart before the respawn and the clock are due
+     play(Rules::lastStanding);
+     match->players[1].setHP(0);
+     wait(Rules::deathmatch.duration);
+     TEST_ASSERT_FALSE(match->players[1].isAlive());
+     TEST_ASSERT_FALSE(match->timeUp);
+ }
+
+ void test_round_break_starts_the_next_round() {
+     play(Rules::bestOfThree);
+     TEST_ASSERT_TRUE(kill());
+     TEST_ASSERT_EQUAL_UINT16(1, match->topScore);
+     TEST_ASSERT_TRUE(match->roundBreak);
+     TEST_ASSERT_FALSE(match->shouldEnd());
+
+     wait(Rules::bestOfThree.respawnDelay);
+     TEST_ASSERT_FALSE(match->roundBreak);
+     TEST_ASSERT_EQUAL(100, match->players[1].getHP());
+     // No invulnerability in this mode: the second round can be decided at once
+     wait(0);
+     TEST_ASSERT_TRUE(kill());
+     TEST_ASSERT_TRUE(match->shouldEnd());
+     TEST_ASSERT_FALSE(match->roundBreak);
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_respawn_then_invulnerability);
+     RUN_TEST(test_clock_ends_a_deathmatch);
+     RUN_TEST(test_timers_of_a_restarted_match_are_ignored);
+     RUN_TEST(test_round_break_starts_the_next_round);
+     return UNITY_END();
+ }
@@ -0,0 +1,115 @@
+/**
+ * @file test_hit_batch.cpp
+ * @brief Host tests for batched hit reports: decode-time order, duplicates and batch size.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+
+ static Match *match;              ///< Three-player free-for-all, running
+ static uint8_t attackers[16];     ///< Attackers in the order Game::onHit saw them
+ static uint8_t attackerCount;     ///< Entries in attackers
+
+ static void recordHit(Match &, uint8_t, uint8_t attacker, uint16_t) { attackers[attackerCount++] = attacker; }
+
+ void setUp() {
+     setMillis(1000);
+     attackerCount = 0;
+     Game::onHit = recordHit;
+     match = new Match();
+     match->projectID = 10;
+     match->setPlayerCount(3);
+     for (uint8_t i = 0; i < 3; i++) {
+         match->players[i].setGunAddress(NexusAddress(10, 0, 10 + i));
+         match->players[i].setVestAddress(NexusAddress(10, 0, 20 + i));
+         match->players[i].setGunData(Stinger);
+     }
+     match->start();
+     match->setStatus(GAME_RUNNING);
+     match->players[0].setHP(1000000);
+ }
+
+ void tearDown() {
+     Game::onHit = nullptr;
+     delete match;
+ }
+
+ /** @brief Appends player index @p index's shot number @p shot, decoded @p offset ms into the batch. */
+ static void add(HitBatch &batch, uint8_t index, uint8_t shot, uint16_t offset) {
+     BatchedHit &hit = batch.hits[batch.count++];
+     hit.code = Game::encodeFireCode(match->irProtocol, match->fireSignals[index].address, shot);
+     hit.offset = offset;
+     hit.receivers = 0x01;
+ }
+
+ void test_batch_fits_one_frame() {
+     TEST_ASSERT_TRUE(sizeof(HitBatch) <= NEXUS_MAX_PAYLOAD_SIZE);
+ }
+
+ void test_hits_apply_in_decode_order() {
+     HitBatch batch = {};
+     add(batch, 2, 0, 4);
+     add(batch, 1, 0, 0);
+     add(batch, 2, 1, 4); // same time as the first entry: keeps its place after it
+     add(batch, 1, 1, 2);
+
+     TEST_ASSERT_EQUAL_UINT8(4, match->processBatch(20, batch));
+     const uint8_t expected[] = { 1, 1, 2, 2 };
+     TEST_ASSERT_EQUAL(4, attackerCount);
+     TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, attackers, 4);
+     TEST_ASSERT_EQUAL_UINT32(2, match->stats[1].hits);
+     TEST_ASSERT_EQUAL_UINT32(2, match->stats[2].hits);
+ }
+
+ void test_batch_matches_single_reports() {
+     HitBatch batch = {};
+     add(batch, 1, 5, 3);
+     add(batch, 2, 7, 1);
+     match->processBatch(20, batch);
+     int batched = match->players[0].getHP();
+
+     // Same hits, one report each in decode order, on a fresh match with new shooter IDs
+     tearDown();
+     setUp();
+     HitBatch single = {};
+     add(single, 2, 7, 0);
+     add(single, 1, 5, 0);
+     for (uint8_t i = 0; i < single.count; i++) {
+         TEST_ASSERT_TRUE(match->processHit(20, NEC_DATA(single.hits[i].code), 0x01));
+     }
+     TEST_ASSERT_EQUAL(batched, match->players[0].getHP());
+ }
+
+ void test_duplicates_in_a_batch_count_once() {
+     HitBatch batch = {};
+     add(batch, 1, 9, 0);
+     add(batch, 1, 9, 1); // the same shot seen again inside the window
+     TEST_ASSERT_EQUAL_UINT8(1, match->processBatch(20, batch));
+     TEST_ASSERT_EQUAL_UINT32(1, match->stats[1].hits);
+ }
+
+ void test_count_is_clamped_to_the_batch_size() {
+     HitBatch batch = {};
+     for (uint8_t i = 0; i < HIT_BATCH_SIZE; i++) add(batch, 1 + i % 2, i, i);
+     batch.count = 255;
+     TEST_ASSERT_EQUAL_UINT8(HIT_BATCH_SIZE, match->processBatch(20, batch));
+     TEST_ASSERT_EQUAL(HIT_BATCH_SIZE, attackerCount);
+ }
+
+ void test_unknown_vest_applies_nothing() {
+     HitBatch batch = {};
+     add(batch, 1, 0, 0);
+     TEST_ASSERT_EQUAL_UINT8(0, match->processBatch(99, batch));
+     TEST_ASSERT_EQUAL(0, attackerCount);
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_batch_fits_one_frame);
+     RUN_TEST(test_hits_apply_in_decode_order);
+     RUN_TEST(test_batch_matches_single_reports);
+     RUN_TEST(test_duplicates_in_a_batch_count_once);
+     RUN_TEST(test_count_is_clamped_to_the_batch_size);
+     RUN_TEST(test_unknown_vest_applies_nothing);
+     return UNITY_END();
+ }
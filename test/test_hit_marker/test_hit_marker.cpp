@@ -0,0 +1,115 @@
+/**
+ * @file test_hit_marker.cpp
+ * @brief Host tests for Game::onHit, which the Manager turns into hit markers for the shooter's gun.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+
+ static Match *match;      ///< Two-player match, running
+ static int hits;          ///< onHit calls since setUp()
+ static uint8_t lastVictim, lastAttacker;
+ static uint16_t lastDamage;
+ static bool lastKill;
+
+ static void recordHit(Match &m, uint8_t victim, uint8_t attacker, uint16_t damage) {
+     hits++;
+     lastVictim = victim;
+     lastAttacker = attacker;
+     lastDamage = damage;
+     lastKill = !m.players[victim].isAlive();
+ }
+
+ void setUp() {
+     match = new Match();
+     match->projectID = 10;
+     for (uint8_t i = 0; i < 2; i++) {
+         match->players[i].setGunAddress(NexusAddress(10, 0, 10 + i));
+         match->players[i].setVestAddress(NexusAddress(10, 0, 20 + i));
+         match->players[i].setGunData(Hammerfall);
+     }
+     match->start();
+     match->setStatus(GAME_RUNNING);
+     hits = 0;
+     Game::onHit = recordHit;
+ }
+
+ void tearDown() {
+     Game::onHit = nullptr;
+     delete match;
+ }
+
+ /** @brief Fire code of player @p index's shot number @p shot. */
+ static NEC_DATA shot(uint8_t index, uint8_t shot) {
+     return NEC_DATA(Game::encodeFireCode(match->irProtocol, match->fireSignals[index].address, shot));
+ }
+
+ void test_accepted_hit_reports_attacker_and_damage() {
+     TEST_ASSERT_TRUE(match->processHit(21, shot(0, 1), 0x01));
+     TEST_ASSERT_EQUAL(1, hits);
+     TEST_ASSERT_EQUAL_UINT8(1, lastVictim);
+     TEST_ASSERT_EQUAL_UINT8(0, lastAttacker);
+     TEST_ASSERT_EQUAL_UINT16(match->damageTable[0][0][0x01], lastDamage);
+     TEST_ASSERT_FALSE(lastKill);
+ }
+
+ void test_rejected_hits_stay_silent() {
+     match->processHit(21, shot(0, 1), 0x01);
+     TEST_ASSERT_FALSE(match->processHit(21, shot(0, 1), 0x02)); // same shot, other receiver
+     TEST_ASSERT_FALSE(match->processHit(20, shot(0, 2), 0x01)); // own gun
+     TEST_ASSERT_FALSE(match->processHit(21, NEC_DATA(0x12345678), 0x01)); // not a fire code
+     TEST_ASSERT_EQUAL(1, hits);
+
+     match->setStatus(GAME_OVER);
+     TEST_ASSERT_FALSE(match->processHit(21, shot(0, 3), 0x01));
+     TEST_ASSERT_EQUAL(1, hits);
+ }
+
+ void test_fatal_hit_is_a_kill() {
+     uint8_t counter = 0;
+     while (match->players[1].isAlive()) {
+         TEST_ASSERT_TRUE(match->processHit(21, shot(0, ++counter), 0x01));
+         TEST_ASSERT_LESS_OR_EQUAL(100, counter);
+     }
+     TEST_ASSERT_EQUAL(counter, hits);
+     TEST_ASSERT_TRUE(lastKill);
+     TEST_ASSERT_GREATER_THAN(0, lastDamage);
+ }
+
+ void test_hits_on_a_dead_player_are_rejected() {
+     // Three teams, so the game goes on after the first elimination
+     delete match;
+     match = new Match();
+     match->projectID = 10;
+     match->setPlayerCount(3);
+     for (uint8_t i = 0; i < 3; i++) {
+         match->setTeam(i + 1, i + 1);
+         match->players[i].setGunAddress(NexusAddress(10, 0, 10 + i));
+         match->players[i].setVestAddress(NexusAddress(10, 0, 20 + i));
+         match->players[i].setGunData(Hammerfall);
+     }
+     match->start();
+     match->setStatus(GAME_RUNNING);
+
+     uint8_t counter = 0;
+     while (match->players[1].isAlive()) match->processHit(21, shot(0, ++counter), 0x01);
+     TEST_ASSERT_EQUAL(GAME_RUNNING, match->status);
+     int marked = hits;
+     uint32_t landed = match->stats[2].hits;
+
+     // Neither the killer nor another opponent scores on the body
+     TEST_ASSERT_FALSE(match->processHit(21, shot(0, ++counter), 0x01));
+     TEST_ASSERT_FALSE(match->processHit(21, shot(2, 1), 0x01));
+     TEST_ASSERT_EQUAL(marked, hits);
+     TEST_ASSERT_EQUAL_UINT32(landed, match->stats[2].hits);
+     TEST_ASSERT_EQUAL_UINT32(1, match->stats[0].kills);
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_accepted_hit_reports_attacker_and_damage);
+     RUN_TEST(test_rejected_hits_stay_silent);
+     RUN_TEST(test_fatal_hit_is_a_kill);
+     RUN_TEST(test_hits_on_a_dead_player_are_rejected);
+     return UNITY_END();
+ }
@@ -0,0 +1,118 @@
+/**
+ * @file test_hit_report.cpp
+ * @brief Host tests for hit report signing, key derivation and their use by Match.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+ #include "Common/Constants_Common.h"
+
+ static const uint32_t secret[4] = HIT_REPORT_SECRET;
+
+ void setUp() {}
+ void tearDown() {}
+
+ /** @brief A report as a Vest would fill it before signing. */
+ static HitReport makeReport() {
+     HitReport report;
+     memset(&report, 0, sizeof(report));
+     report.code = 0x12ED34CB;
+     report.hp = 75;
+     report.receivers = 0x05;
+     report.seq = 1;
+     return report;
+ }
+
+ void test_siphash_reference_vector() {
+     // SipHash-2-4 paper, appendix A: key 00..0f, message 00..0e
+     const uint32_t key[4] = { 0x03020100, 0x07060504, 0x0B0A0908, 0x0F0E0D0C };
+     uint8_t message[15];
+     for (uint8_t i = 0; i < sizeof(message); i++) message[i] = i;
+     TEST_ASSERT_TRUE(SipHash::hash(key, message, sizeof(message)) == 0xA129CA6149BE45E5ULL);
+ }
+
+ void test_sign_verify_round_trip() {
+     uint32_t key[4];
+     deriveHitKey(secret, 10, 3, 0xCAFEF00D, key);
+     HitReport report = makeReport();
+     signHitReport(report, key);
+     TEST_ASSERT_TRUE(verifyHitReport(report, key));
+ }
+
+ void test_altered_report_is_rejected() {
+     uint32_t key[4];
+     deriveHitKey(secret, 10, 3, 0xCAFEF00D, key);
+     HitReport report = makeReport();
+     signHitReport(report, key);
+
+     HitReport altered = report;
+     altered.hp = 100;
+     TEST_ASSERT_FALSE(verifyHitReport(altered, key));
+     altered = report;
+     altered.code ^= 0x00010000;
+     TEST_ASSERT_FALSE(verifyHitReport(altered, key));
+     altered = report;
+     altered.seq++;
+     TEST_ASSERT_FALSE(verifyHitReport(altered, key));
+     altered = report;
+     altered.tag ^= 1;
+     TEST_ASSERT_FALSE(verifyHitReport(altered, key));
+ }
+
+ void test_key_depends_on_vest_arena_and_nonce() {
+     uint32_t key[4], other[4];
+     deriveHitKey(secret, 10, 3, 0xCAFEF00D, key);
+
+     deriveHitKey(secret, 10, 3, 0xCAFEF00D, other);
+     TEST_ASSERT_EQUAL_MEMORY(key, other, sizeof(key));
+
+     deriveHitKey(secret, 10, 4, 0xCAFEF00D, other);
+     TEST_ASSERT_FALSE(memcmp(key, other, sizeof(key)) == 0);
+     deriveHitKey(secret, 11, 3, 0xCAFEF00D, other);
+     TEST_ASSERT_FALSE(memcmp(key, other, sizeof(key)) == 0);
+     deriveHitKey(secret, 10, 3, 0xCAFEF00E, other);
+     TEST_ASSERT_FALSE(memcmp(key, other, sizeof(key)) == 0);
+
+     HitReport report = makeReport();
+     signHitReport(report, key);
+     TEST_ASSERT_FALSE(verifyHitReport(report, other));
+ }
+
+ void test_match_accepts_reports_signed_with_the_table_nonce() {
+     Match match;
+     match.projectID = 10;
+     match.players[0].setGunAddress(NexusAddress(10, 0, 1));
+     match.players[0].setVestAddress(NexusAddress(10, 0, 2));
+     match.players[1].setGunAddress(NexusAddress(10, 0, 3));
+     match.players[1].setVestAddress(NexusAddress(10, 0, 4));
+     match.start();
+
+     // The vest of player 2 only learns the nonce and derives the key itself
+     HitTable table;
+     match.buildHitTable(1, table);
+     uint32_t key[4];
+     deriveHitKey(secret, 10, 4, table.nonce, key);
+
+     HitReport report = makeReport();
+     report.code = match.fireSignals[0].data;
+     signHitReport(report, key);
+     TEST_ASSERT_TRUE(match.acceptHitReport(4, report));
+     TEST_ASSERT_FALSE(match.acceptHitReport(4, report)); // replayed
+     TEST_ASSERT_FALSE(match.acceptHitReport(2, report)); // other vest's key
+
+     // A key derived for another vest cannot sign for this one
+     deriveHitKey(secret, 10, 2, table.nonce, key);
+     report.seq = 2;
+     signHitReport(report, key);
+     TEST_ASSERT_FALSE(match.acceptHitReport(4, report));
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_siphash_reference_vector);
+     RUN_TEST(test_sign_verify_round_trip);
+     RUN_TEST(test_altered_report_is_rejected);
+     RUN_TEST(test_key_depends_on_vest_arena_and_nonce);
+     RUN_TEST(test_match_accepts_reports_signed_with_the_table_nonce);
+     return UNITY_END();
+ }
@@ -0,0 +1,147 @@
+/**
+ * @file test_hit_table.cpp
+ * @brief Host tests for the hit tables the Manager sends and the accept-set a Vest builds from them.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+
+ /** Frames of the noise mix, in five equal parts. */
+ #define NOISE_FRAMES 10000
+ /** Most frames in 100 a vest may forward from the noise mix (20.1% measured). */
+ #define NOISE_FORWARD_PERCENT 21
+
+ static Match *game; ///< 2 vs 2 match started by setUp()
+
+ void setUp() {
+     game = new Match();
+     Match &match = *game;
+     match.projectID = 10;
+     match.setPlayerCount(4);
+     for (uint8_t i = 0; i < 4; i++) {
+         match.setTeam(i + 1, i < 2 ? 1 : 2);
+         match.players[i].setVestAddress(NexusAddress(10, 0, 20 + i));
+         if (i != 3) match.players[i].setGunAddress(NexusAddress(10, 0, 10 + i));
+     }
+     match.start();
+ }
+
+ void tearDown() { delete game; }
+
+ /**
+  * @brief Vest side of the filter: integrity check plus accept-set, as in vest_accepts().
+  */
+ static bool vestAccepts(const HitAcceptSet &accept, uint32_t code) {
+     uint8_t shooter, shot;
+     return Game::decodeFireCode(game->irProtocol, code, shooter, shot) && accept.contains(shooter);
+ }
+
+ void test_table_lists_opponents_only() {
+     Match &match = *game;
+     HitTable table;
+     match.buildHitTable(0, table);
+     TEST_ASSERT_EQUAL_UINT8(2, table.count);
+     TEST_ASSERT_EQUAL_HEX8(match.fireSignals[2].address, table.shooter[0]);
+     TEST_ASSERT_EQUAL_HEX8(match.fireSignals[3].address, table.shooter[1]);
+     TEST_ASSERT_EQUAL_UINT8(12, table.gun[0]);
+     TEST_ASSERT_EQUAL_UINT8(HIT_NO_GUN, table.gun[1]);
+     TEST_ASSERT_EQUAL_UINT16(match.gunDamage[2], table.damage[0]);
+ }
+
+ void test_accept_set_holds_table_shooters() {
+     Match &match = *game;
+     HitTable table;
+     match.buildHitTable(2, table);
+     HitAcceptSet accept;
+     accept.load(table);
+     for (uint16_t id = 0; id < 256; id++) {
+         bool listed = id == match.fireSignals[0].address || id == match.fireSignals[1].address;
+         TEST_ASSERT_EQUAL(listed, accept.contains(id));
+     }
+ }
+
+ void test_vest_filter_agrees_with_manager() {
+     Match &match = *game;
+     for (uint8_t protocol = 0; protocol < 2; protocol++) {
+         match.irProtocol = protocol ? IR_PROTOCOL_TAG : IR_PROTOCOL_NEC;
+         for (uint8_t who = 1; who <= 4; who++) {
+             HitTable table;
+             match.buildHitTable(who - 1, table);
+             HitAcceptSet accept;
+             accept.load(table);
+             // Every shooter ID, intact and corrupted, plus NEC remote codes
+             for (uint16_t id = 0; id < 256; id++) {
+                 uint32_t code = Game::encodeFireCode(match.irProtocol, id, 7);
+                 uint32_t frames[3] = { code, code ^ 0x100, NEC_DATA(id, 0x45).data };
+                 for (uint8_t f = 0; f < 3; f++) {
+                     TEST_ASSERT_EQUAL(match.hasPlayerHit(NEC_DATA(frames[f]), who), vestAccepts(accept, frames[f]));
+                 }
+             }
+         }
+     }
+ }
+
+ /** @brief Next pseudo-random number (xorshift32), so the mix is reproducible. */
+ static uint32_t nextRandom(uint32_t &state) {
+     state ^= state << 13;
+     state ^= state >> 17;
+     state ^= state << 5;
+     return state;
+ }
+
+ void test_filter_cuts_noise_traffic() {
+     Match &match = *game;
+     // A second arena started after this one, so its shooter IDs use another coset
+     Match *other = new Match();
+     other->projectID = 11;
+     other->setPlayerCount(2);
+     other->start();
+
+     for (uint8_t protocol = 0; protocol < 2; protocol++) {
+         match.irProtocol = protocol ? IR_PROTOCOL_TAG : IR_PROTOCOL_NEC;
+         HitTable table;
+         match.buildHitTable(0, table);
+         HitAcceptSet accept;
+         accept.load(table);
+
+         // Garbage, NEC remote codes, own team, another arena and opponents
+         uint32_t state = 0x2545F491;
+         uint32_t received = 0, forwarded = 0, opponents = 0;
+         for (uint32_t i = 0; i < NOISE_FRAMES; i++) {
+             uint32_t r = nextRandom(state);
+             uint8_t shot = r >> 8;
+             uint32_t code;
+             switch (i % 5) {
+                 case 0:  code = r; break;
+                 case 1:  code = NEC_DATA(r >> 16, r >> 8).data; break;
+                 case 2:  code = Game::encodeFireCode(match.irProtocol, match.fireSignals[r & 1].address, shot); break;
+                 case 3:  code = Game::encodeFireCode(match.irProtocol, other->fireSignals[r & 1].address, shot); break;
+                 default: code = Game::encodeFireCode(match.irProtocol, match.fireSignals[2 + (r & 1)].address, shot); opponents++; break;
+             }
+
+             received++;
+             bool forward = vestAccepts(accept, code);
+             TEST_ASSERT_EQUAL(match.hasPlayerHit(NEC_DATA(code), 1), forward);
+             if (forward) forwarded++;
+         }
+
+         char line[96];
+         snprintf(line, sizeof(line), "protocol %u: %u frames received, %u forwarded to the Manager",
+                  protocol, unsigned(received), unsigned(forwarded));
+         TEST_MESSAGE(line);
+
+         // Every opponent shot goes through; the rest of the mix is mostly dropped
+         TEST_ASSERT_GREATER_OR_EQUAL(opponents, forwarded);
+         TEST_ASSERT_LESS_OR_EQUAL(received * NOISE_FORWARD_PERCENT / 100, forwarded);
+     }
+     delete other;
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_table_lists_opponents_only);
+     RUN_TEST(test_accept_set_holds_table_shooters);
+     RUN_TEST(test_vest_filter_agrees_with_manager);
+     RUN_TEST(test_filter_cuts_noise_traffic);
+     return UNITY_END();
+ }
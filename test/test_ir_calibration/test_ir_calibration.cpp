@@ -0,0 +1,95 @@
+/**
+ * @file test_ir_calibration.cpp
+ * @brief Host tests for the header-mark timing calibration of IRdecoder.
+ */
+
+ #include <unity.h>
+ #include "Components/IRremoteESP32/IRremoteESP32.hpp"
+
+ void setUp() {}
+ void tearDown() {}
+
+ /**
+  * @brief Feeds one encoded frame, with every pulse stretched by @p scale (Q8), into a decoder.
+  * @return Number of frames the decoder completed.
+  */
+ template <typename Protocol>
+ static int feedFrame(IRdecoder<Protocol> &decoder, uint32_t data, uint32_t scale) {
+     IRpulseTrain train;
+     IRencoder<Protocol>::encode(data, train);
+     int frames = 0;
+     for (uint8_t i = 0; i < train.length; ++i) {
+         if (decoder.feed((train.durations[i] * scale) >> 8, true)) ++frames;
+     }
+     return frames;
+ }
+
+ void test_nominal_timing_keeps_calibration() {
+     IRdecoder<NECProtocol> decoder;
+     TEST_ASSERT_EQUAL(1, feedFrame(decoder, NEC_DATA(0x12, 0x34).data, IR_SCALE_ONE));
+     TEST_ASSERT_EQUAL_UINT32(NEC_DATA(0x12, 0x34).data, decoder.frame());
+     TEST_ASSERT_EQUAL_UINT16(IR_SCALE_ONE, decoder.getCalibration());
+ }
+
+ void test_slow_receiver_decodes_and_calibrates_up() {
+     const uint32_t slow = 294; // 1.15x
+     IRdecoder<NECProtocol> decoder;
+     for (int i = 0; i < 20; ++i) {
+         TEST_ASSERT_EQUAL(1, feedFrame(decoder, NEC_DATA(i, 3 * i).data, slow));
+     }
+     TEST_ASSERT_GREATER_THAN(IR_SCALE_ONE, decoder.getCalibration());
+     TEST_ASSERT_LESS_OR_EQUAL(slow, decoder.getCalibration());
+     TEST_ASSERT_GREATER_OR_EQUAL(slow - 8, decoder.getCalibration());
+ }
+
+ void test_fast_receiver_decodes_and_calibrates_down() {
+     const uint32_t fast = 218; // 0.85x
+     IRdecoder<TagProtocol> decoder;
+     for (int i = 0; i < 20; ++i) {
+         TEST_ASSERT_EQUAL(1, feedFrame(decoder, TAG_DATA(i, 7 * i).data, fast));
+     }
+     TEST_ASSERT_LESS_THAN(IR_SCALE_ONE, decoder.getCalibration());
+     TEST_ASSERT_GREATER_OR_EQUAL(fast, decoder.getCalibration());
+ }
+
+ void test_header_outside_range_is_rejected() {
+     IRdecoder<NECProtocol> decoder;
+     TEST_ASSERT_EQUAL(0, feedFrame(decoder, NEC_DATA(1, 2).data, IR_SCALE_MAX + 40));
+     TEST_ASSERT_EQUAL(0, feedFrame(decoder, NEC_DATA(1, 2).data, IR_SCALE_MIN - 40));
+     TEST_ASSERT_EQUAL_UINT16(IR_SCALE_ONE, decoder.getCalibration());
+ }
+
+ void test_calibration_narrows_the_header_window() {
+     const uint32_t slow = 300; // 1.17x
+     const uint32_t fast = 208; // 0.81x, more than IR_SCALE_WINDOW below the slow receiver
+     IRdecoder<NECProtocol> fresh;
+     TEST_ASSERT_EQUAL(1, feedFrame(fresh, NEC_DATA(1, 2).data, fast));
+
+     IRdecoder<NECProtocol> calibrated;
+     for (int i = 0; i < 20; ++i) feedFrame(calibrated, NEC_DATA(i, i).data, slow);
+     TEST_ASSERT_EQUAL(0, feedFrame(calibrated, NEC_DATA(1, 2).data, fast));
+     TEST_ASSERT_EQUAL(1, feedFrame(calibrated, NEC_DATA(1, 2).data, IR_SCALE_MAX));
+
+     // Forgetting the calibration reopens the full range
+     calibrated.resetCalibration();
+     TEST_ASSERT_EQUAL(1, feedFrame(calibrated, NEC_DATA(1, 2).data, fast));
+ }
+
+ void test_reset_calibration() {
+     IRdecoder<NECProtocol> decoder;
+     for (int i = 0; i < 5; ++i) feedFrame(decoder, NEC_DATA(i, i).data, 300);
+     TEST_ASSERT_NOT_EQUAL(IR_SCALE_ONE, decoder.getCalibration());
+     decoder.resetCalibration();
+     TEST_ASSERT_EQUAL_UINT16(IR_SCALE_ONE, decoder.getCalibration());
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_nominal_timing_keeps_calibration);
+     RUN_TEST(test_slow_receiver_decodes_and_calibrates_up);
+     RUN_TEST(test_fast_receiver_decodes_and_calibrates_down);
+     RUN_TEST(test_header_outside_range_is_rejected);
+     RUN_TEST(test_calibration_narrows_the_header_window);
+     RUN_TEST(test_reset_calibration);
+     return UNITY_END();
+ }
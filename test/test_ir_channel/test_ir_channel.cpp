@@ -0,0 +1,109 @@
+/**
+ * @file test_ir_channel.cpp
+ * @brief Host benchmark of the NEC and tag codecs through IRchannelSimulator.
+ *
+ * Each case sends a fixed set of frames through a seeded impaired channel,
+ * prints decode rate, false positives, decode CPU time and total time
+ * (rendering included) per frame, and fails if a codec falls below the
+ * floor recorded for that channel.
+ */
+
+ #include <unity.h>
+ #include <chrono>
+ #include "Components/IRremoteESP32/IRchannelSimulator.hpp"
+
+ /** Frames sent per case. */
+ #define CHANNEL_FRAMES 200
+ /** Frames each codec must decode with jitter only. */
+ #define JITTER_FLOOR 190
+ /** NEC frames that must survive 10% glitches and 10% echoes (0.52 measured). */
+ #define NEC_GLITCH_FLOOR 90
+ /** Tag frames that must survive 10% glitches and 10% echoes (0.47 measured). */
+ #define TAG_GLITCH_FLOOR 80
+
+ static uint32_t necCodes[CHANNEL_FRAMES]; ///< NEC frames of every case.
+ static uint32_t tagCodes[CHANNEL_FRAMES]; ///< Tag frames of every case.
+
+ static void noIsr() {}
+
+ void setUp() {}
+ void tearDown() {}
+
+ /** @brief Runs one codec through a channel and prints a benchmark line. */
+ template <typename Protocol>
+ static IRchannelResult runChannel(const char *name, const IRchannelConfig &config, const uint32_t *codes) {
+     IRreceiver receiver(1, noIsr, true);
+     receiver.setProtocols(irProtocolMask(Protocol::id));
+     IRchannelSimulator simulator(config);
+     IRchannelResult result;
+
+     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+     simulator.run<Protocol>(receiver, codes, CHANNEL_FRAMES, result);
+     double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+     char line[160];
+     snprintf(line, sizeof(line), "%s jitter %u glitch %u%% echo %u%% drop %u%%: decode %.2f, false %.2f, %.2f us/frame decode, %.2f us/frame total",
+              name, config.jitter, config.glitchPercent, config.echoPercent, config.dropoutPercent,
+              result.decodeRate(), result.falsePositiveRate(), result.microsPerFrame(), micros / CHANNEL_FRAMES);
+     TEST_MESSAGE(line);
+
+     // Decode time is measured on its own, not as part of the whole run
+     TEST_ASSERT_TRUE(result.decodeMicros > 0.0f);
+     TEST_ASSERT_TRUE(result.decodeMicros < micros);
+     return result;
+ }
+
+ void test_clean_channel_decodes_everything() {
+     IRchannelConfig clean;
+     IRchannelResult nec = runChannel<NECProtocol>("NEC", clean, necCodes);
+     IRchannelResult tag = runChannel<TagProtocol>("TAG", clean, tagCodes);
+     TEST_ASSERT_EQUAL_UINT32(CHANNEL_FRAMES, nec.decoded);
+     TEST_ASSERT_EQUAL_UINT32(CHANNEL_FRAMES, tag.decoded);
+     TEST_ASSERT_EQUAL_UINT32(0, nec.falsePositives + tag.falsePositives);
+ }
+
+ void test_jitter() {
+     IRchannelConfig config;
+     config.jitter = 30;
+     IRchannelResult nec = runChannel<NECProtocol>("NEC", config, necCodes);
+     IRchannelResult tag = runChannel<TagProtocol>("TAG", config, tagCodes);
+     TEST_ASSERT_GREATER_OR_EQUAL(JITTER_FLOOR, nec.decoded);
+     TEST_ASSERT_GREATER_OR_EQUAL(JITTER_FLOOR, tag.decoded);
+     TEST_ASSERT_EQUAL_UINT32(0, nec.falsePositives + tag.falsePositives);
+ }
+
+ void test_glitches_and_echo() {
+     IRchannelConfig config;
+     config.jitter = 30;
+     config.glitchPercent = 10;
+     config.glitchWidth = 60;
+     config.echoPercent = 10;
+     config.echoDelay = 40;
+     IRchannelResult nec = runChannel<NECProtocol>("NEC", config, necCodes);
+     IRchannelResult tag = runChannel<TagProtocol>("TAG", config, tagCodes);
+     TEST_ASSERT_GREATER_OR_EQUAL(NEC_GLITCH_FLOOR, nec.decoded);
+     TEST_ASSERT_GREATER_OR_EQUAL(TAG_GLITCH_FLOOR, tag.decoded);
+     TEST_ASSERT_EQUAL_UINT32(0, tag.falsePositives);
+ }
+
+ void test_dropouts_never_forge_tag_frames() {
+     IRchannelConfig config;
+     config.dropoutPercent = 5;
+     IRchannelResult tag = runChannel<TagProtocol>("TAG", config, tagCodes);
+     TEST_ASSERT_EQUAL_UINT32(0, tag.falsePositives);
+     TEST_ASSERT_LESS_THAN(CHANNEL_FRAMES, tag.decoded);
+ }
+
+ int main(int argc, char **argv) {
+     for (int i = 0; i < CHANNEL_FRAMES; ++i) {
+         necCodes[i] = NEC_DATA(i, i * 7).data;
+         tagCodes[i] = TAG_DATA(i, i * 7).data;
+     }
+
+     UNITY_BEGIN();
+     RUN_TEST(test_clean_channel_decodes_everything);
+     RUN_TEST(test_jitter);
+     RUN_TEST(test_glitches_and_echo);
+     RUN_TEST(test_dropouts_never_forge_tag_frames);
+     return UNITY_END();
+ }
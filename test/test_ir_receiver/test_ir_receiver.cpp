@@ -0,0 +1,103 @@
+/**
+ * @file test_ir_receiver.cpp
+ * @brief Host tests for IRreceiver's edge ring: ISR-side capture and deferred decoding.
+ */
+
+ #include <unity.h>
+ #include "Components/IRremoteESP32/IRremoteESP32.hpp"
+
+ static void noIsr() {}
+
+ void setUp() { setMillis(1000); }
+ void tearDown() {}
+
+ /**
+  * @brief Captures the edges of one frame as the pin ISR would, moving the clock between them.
+  *
+  * The train ends with the inter-frame gap, so the edge closing it belongs
+  * to the next frame.
+  * @return Number of edges captured.
+  */
+ template <typename Protocol>
+ static size_t captureFrame(IRreceiver &receiver, uint32_t data) {
+     IRpulseTrain train;
+     IRencoder<Protocol>::encode(data, train);
+     for (uint8_t i = 0; i < train.length; ++i) {
+         receiver.captureEdge();
+         advanceMicros(train.durations[i]);
+     }
+     return train.length;
+ }
+
+ void test_isr_only_queues_edges() {
+     IRreceiver receiver(1, noIsr, true);
+     receiver.init();
+     size_t edges = captureFrame<NECProtocol>(receiver, NEC_DATA(0x12, 0x34).data);
+
+     // Nothing is decoded until the loop drains the ring
+     TEST_ASSERT_EQUAL(edges, receiver.pendingEdges());
+     TEST_ASSERT_EQUAL(0, receiver.available());
+
+     receiver.decodeNEC();
+     TEST_ASSERT_EQUAL(0, receiver.pendingEdges());
+     TEST_ASSERT_EQUAL(1, receiver.available());
+     TEST_ASSERT_EQUAL_HEX32(NEC_DATA(0x12, 0x34).data, receiver.readFull());
+ }
+
+ void test_frames_split_across_loops_decode() {
+     IRreceiver receiver(1, noIsr, true);
+     receiver.setProtocols(irProtocolMask(IR_PROTOCOL_TAG));
+     receiver.init();
+
+     // Drain after every edge, as a busy loop would
+     IRpulseTrain train;
+     IRencoder<TagProtocol>::encode(TAG_DATA(5, 9).data, train);
+     for (uint8_t i = 0; i < train.length; ++i) {
+         receiver.captureEdge();
+         receiver.decodeNEC();
+         advanceMicros(train.durations[i]);
+     }
+     TEST_ASSERT_EQUAL(1, receiver.available());
+     TEST_ASSERT_EQUAL_HEX32(TAG_DATA(5, 9).data, receiver.readFull());
+ }
+
+ void test_several_frames_in_one_batch() {
+     IRreceiver receiver(1, noIsr, true);
+     receiver.init();
+     for (uint8_t i = 0; i < 3; ++i) captureFrame<NECProtocol>(receiver, NEC_DATA(i, 0x40).data);
+
+     receiver.decodeNEC();
+     TEST_ASSERT_EQUAL(3, receiver.available());
+     for (uint8_t i = 0; i < 3; ++i) TEST_ASSERT_EQUAL_HEX32(NEC_DATA(i, 0x40).data, receiver.readFull());
+ }
+
+ void test_full_ring_drops_edges_then_resyncs() {
+     IRreceiver receiver(1, noIsr, true);
+     receiver.init();
+
+     // More edges than the ring holds arrive before the loop runs
+     size_t captured = 0;
+     while (captured < IR_EDGE_BUFFER_SIZE) {
+         captured += captureFrame<NECProtocol>(receiver, NEC_DATA(0x21, 0x43).data);
+     }
+     TEST_ASSERT_GREATER_THAN(0, receiver.getStats().overflows);
+     TEST_ASSERT_EQUAL(IR_EDGE_BUFFER_SIZE - 1, receiver.pendingEdges());
+
+     receiver.decodeNEC();
+     while (receiver.available()) receiver.read();
+
+     // The next frame decodes normally
+     captureFrame<NECProtocol>(receiver, NEC_DATA(0x65, 0x87).data);
+     receiver.decodeNEC();
+     TEST_ASSERT_EQUAL(1, receiver.available());
+     TEST_ASSERT_EQUAL_HEX32(NEC_DATA(0x65, 0x87).data, receiver.readFull());
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_isr_only_queues_edges);
+     RUN_TEST(test_frames_split_across_loops_decode);
+     RUN_TEST(test_several_frames_in_one_batch);
+     RUN_TEST(test_full_ring_drops_edges_then_resyncs);
+     return UNITY_END();
+ }
@@ -0,0 +1,91 @@
+/**
+ * @file test_ir_sender.cpp
+ * @brief Host tests for IRpulseRecorder and the send queue of IRsender.
+ */
+
+ #include <unity.h>
+ #include "Components/IRremoteESP32/IRremoteESP32.hpp"
+
+ /**
+  * @brief IRsender whose timer interrupt the test fires by hand.
+  */
+ class ManualSender : public IRsender {
+ public:
+     ManualSender() : IRsender(4, 0, 38000) {}
+
+     /** @brief Plays every queued pulse, as the timer ISR would. */
+     void drain() {
+         while (isBusy()) nextPulse();
+     }
+ };
+
+ void setUp() {}
+ void tearDown() {}
+
+ void test_recorder_captures_the_encoded_train() {
+     IRsender sender(4, 0, 38000);
+     IRpulseRecorder recorder;
+     sender.attachRecorder(&recorder);
+
+     TEST_ASSERT_TRUE(sender.sendNEC(NEC_DATA(0x12, 0x34)));
+     IRpulseTrain train;
+     IRencoder<NECProtocol>::encode(NEC_DATA(0x12, 0x34).data, train);
+
+     TEST_ASSERT_EQUAL_UINT16(1, recorder.frameCount());
+     TEST_ASSERT_EQUAL_UINT16(train.length, recorder.size());
+     uint32_t at = 0;
+     for (uint8_t i = 0; i < train.length; i++) {
+         TEST_ASSERT_EQUAL_UINT32(at, recorder[i].start);
+         TEST_ASSERT_EQUAL_UINT16(train.durations[i], recorder[i].duration);
+         TEST_ASSERT_EQUAL(IRpulseTrain::isMark(i), recorder[i].mark);
+         at += train.durations[i];
+     }
+     TEST_ASSERT_EQUAL_UINT32(at, recorder.elapsed());
+     TEST_ASSERT_EQUAL_UINT32(NECProtocol::headerMark, recorder[0].duration);
+ }
+
+ void test_recorder_appends_frames_and_resets() {
+     IRsender sender(4, 0, 38000);
+     IRpulseRecorder recorder;
+     sender.attachRecorder(&recorder);
+
+     sender.send<TagProtocol>(TAG_DATA(1, 2).data);
+     uint32_t first = recorder.elapsed();
+     uint16_t pulses = recorder.size();
+     sender.send<TagProtocol>(TAG_DATA(3, 4).data);
+
+     // The second frame starts where the first one ended
+     TEST_ASSERT_EQUAL_UINT16(2, recorder.frameCount());
+     TEST_ASSERT_EQUAL_UINT32(first, recorder[pulses].start);
+     TEST_ASSERT_TRUE(recorder[pulses].mark);
+
+     recorder.reset();
+     TEST_ASSERT_EQUAL_UINT16(0, recorder.size());
+     TEST_ASSERT_EQUAL_UINT16(0, recorder.frameCount());
+     TEST_ASSERT_EQUAL_UINT32(0, recorder.elapsed());
+ }
+
+ void test_full_queue_drops_frames() {
+     ManualSender sender;
+     sender.init();
+
+     // One frame goes on air at once; the queue holds the next ones (one ring slot stays free)
+     for (uint8_t i = 0; i < IR_SENDER_QUEUE_SIZE; i++) {
+         TEST_ASSERT_TRUE(sender.sendNEC(NEC_DATA(i, 0x10)));
+     }
+     TEST_ASSERT_TRUE(sender.isBusy());
+     TEST_ASSERT_FALSE(sender.sendNEC(NEC_DATA(0x99, 0x10)));
+
+     // Once the timer played everything out, frames are accepted again
+     sender.drain();
+     TEST_ASSERT_FALSE(sender.isBusy());
+     TEST_ASSERT_TRUE(sender.sendNEC(NEC_DATA(0x99, 0x10)));
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_recorder_captures_the_encoded_train);
+     RUN_TEST(test_recorder_appends_frames_and_resets);
+     RUN_TEST(test_full_queue_drops_frames);
+     return UNITY_END();
+ }
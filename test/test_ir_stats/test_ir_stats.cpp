@@ -0,0 +1,115 @@
+/**
+ * @file test_ir_stats.cpp
+ * @brief Host tests for the IR decode-quality counters of IRreceiver and the Vest's Target.
+ */
+
+ #include <unity.h>
+ #include "VEST/Target/Target.hpp"
+
+ static void noIsr() {}
+
+ void setUp() {
+     setMillis(1000);
+     Target::clear();
+     Target::clearStats();
+ }
+ void tearDown() {}
+
+ /** @brief Replays one pulse train into a receiver, edge by edge; it ends with the inter-frame gap. */
+ static void feedTrain(IRreceiver &receiver, const IRpulseTrain &train) {
+     for (uint8_t i = 0; i < train.length; ++i) {
+         receiver.feedEdge(micros());
+         advanceMicros(train.durations[i]);
+     }
+ }
+
+ /** @brief Replays one encoded NEC frame into a receiver. */
+ static void feedNEC(IRreceiver &receiver, uint32_t data) {
+     IRpulseTrain train;
+     IRencoder<NECProtocol>::encode(data, train);
+     feedTrain(receiver, train);
+ }
+
+ void test_clean_frame_counts_and_histogram() {
+     IRreceiver receiver(1, noIsr, true);
+     feedNEC(receiver, NEC_DATA(0x12, 0x34).data);
+     IRdecodeStats stats = receiver.getStats();
+
+     TEST_ASSERT_EQUAL_UINT32(1, stats.started);
+     TEST_ASSERT_EQUAL_UINT32(1, stats.completed);
+     TEST_ASSERT_EQUAL_UINT32(0, stats.invalid);
+
+     // Header space plus a mark and a space per bit, all with zero error
+     uint32_t matched = 0;
+     for (uint8_t i = 0; i < IR_ERROR_BINS; ++i) matched += stats.errorHistogram[i];
+     TEST_ASSERT_EQUAL_UINT32(1 + 2 * NEC_BITS, matched);
+     TEST_ASSERT_EQUAL_UINT32(matched, stats.errorHistogram[0]);
+ }
+
+ void test_failures_count_by_stage() {
+     IRreceiver receiver(1, noIsr, true);
+     IRpulseTrain train;
+     IRencoder<NECProtocol>::encode(NEC_DATA(0x12, 0x34).data, train);
+     train.durations[1] += 2 * NEC_THRESHOLD; // Header space out of tolerance
+     feedTrain(receiver, train);
+     IRdecodeStats stats = receiver.getStats();
+     TEST_ASSERT_EQUAL_UINT32(1, stats.started);
+     TEST_ASSERT_EQUAL_UINT32(1, stats.failed[headerSpace]);
+     TEST_ASSERT_EQUAL_UINT32(0, stats.completed);
+ }
+
+ void test_validation_failure_is_counted() {
+     IRreceiver receiver(1, noIsr, true);
+     feedNEC(receiver, 0x12345678); // Command and address bytes are not inverted pairs
+     IRdecodeStats stats = receiver.getStats();
+     TEST_ASSERT_EQUAL_UINT32(1, stats.invalid);
+     TEST_ASSERT_EQUAL_UINT32(0, stats.completed);
+     TEST_ASSERT_EQUAL(0, receiver.available());
+ }
+
+ void test_full_frame_buffer_counts_drops() {
+     IRreceiver receiver(1, noIsr, true);
+     for (uint8_t i = 0; i <= IR_RECEIVER_BUFFER_SIZE; ++i) feedNEC(receiver, NEC_DATA(i, 1).data);
+     TEST_ASSERT_EQUAL(IR_RECEIVER_BUFFER_SIZE, receiver.available());
+     TEST_ASSERT_EQUAL_UINT32(1, receiver.getStats().dropped);
+
+     receiver.clearStats();
+     IRdecodeStats cleared = receiver.getStats();
+     TEST_ASSERT_EQUAL_UINT32(0, cleared.completed + cleared.dropped + cleared.errorHistogram[0]);
+ }
+
+ void test_target_counts_duplicates_and_sums_receivers() {
+     // One shot decoded by all three receivers is one hit and two duplicates
+     NEC_DATA code(0x5A, 0x01);
+     for (uint8_t i = 0; i < Target::irReceiversCount; ++i) feedNEC(Target::irReceivers[i], code.data);
+     Target::loop();
+
+     TEST_ASSERT_EQUAL(1, Target::hasHit());
+     IRhitStats stats = Target::getStats();
+     TEST_ASSERT_EQUAL_UINT32(2, stats.duplicates);
+     TEST_ASSERT_EQUAL_UINT32(Target::irReceiversCount, stats.decode.completed);
+     TEST_ASSERT_EQUAL_UINT32(0, stats.hitDrops);
+ }
+
+ void test_target_counts_hit_drops() {
+     for (uint8_t i = 0; i <= TARGET_HIT_QUEUE_SIZE; ++i) {
+         feedNEC(Target::irReceivers[0], NEC_DATA(0x10 + i, 0x01).data);
+         Target::loop();
+     }
+     TEST_ASSERT_EQUAL(TARGET_HIT_QUEUE_SIZE, Target::hasHit());
+     TEST_ASSERT_EQUAL_UINT32(1, Target::getStats().hitDrops);
+
+     Target::clearStats();
+     TEST_ASSERT_EQUAL_UINT32(0, Target::getStats().hitDrops);
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_clean_frame_counts_and_histogram);
+     RUN_TEST(test_failures_count_by_stage);
+     RUN_TEST(test_validation_failure_is_counted);
+     RUN_TEST(test_full_frame_buffer_counts_drops);
+     RUN_TEST(test_target_counts_duplicates_and_sums_receivers);
+     RUN_TEST(test_target_counts_hit_drops);
+     return UNITY_END();
+ }
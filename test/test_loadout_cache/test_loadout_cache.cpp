@@ -0,0 +1,121 @@
+/**
+ * @file test_loadout_cache.cpp
+ * @brief Host tests for content-addressed loadouts and the Gun's LoadoutCache.
+ */
+
+ #include <unity.h>
+ #include "Modules/Loadout.hpp"
+
+ void setUp() {}
+ void tearDown() {}
+
+ /** @brief Loadout of a player carrying @p data named @p name. */
+ static Loadout loadoutOf(const GunData &data, const char *name) {
+     Player player(1);
+     player.setGunData(data);
+     player.setGunName(name);
+     Loadout loadout;
+     playerLoadout(player, loadout);
+     return loadout;
+ }
+
+ void test_hash_names_the_content() {
+     Loadout a = loadoutOf(Stinger, "Stinger");
+     Loadout b = loadoutOf(Stinger, "Stinger");
+     TEST_ASSERT_TRUE(loadoutHash(a) == loadoutHash(b));
+
+     GunData stronger = Stinger;
+     stronger.damage++;
+     TEST_ASSERT_FALSE(loadoutHash(a) == loadoutHash(loadoutOf(stronger, "Stinger")));
+     TEST_ASSERT_FALSE(loadoutHash(a) == loadoutHash(loadoutOf(Stinger, "Stinger II")));
+ }
+
+ void test_name_is_zero_padded() {
+     // Whatever followed the old name in the player's buffer must not change the hash
+     Player player(1);
+     player.setGunName("Hammerfall Heavy");
+     player.setGunName("Ghost");
+     player.setGunData(Ghost);
+     Loadout reused;
+     playerLoadout(player, reused);
+     TEST_ASSERT_TRUE(loadoutHash(reused) == loadoutHash(loadoutOf(Ghost, "Ghost")));
+     for (uint8_t i = strlen("Ghost"); i < MAX_GUN_NAME_LENGTH; i++) {
+         TEST_ASSERT_EQUAL(0, reused.name[i]);
+     }
+ }
+
+ void test_miss_then_hit() {
+     LoadoutCache cache;
+     Loadout wanted = loadoutOf(Hammerfall, "Hammerfall");
+     uint64_t hash = loadoutHash(wanted);
+     Loadout found;
+     TEST_ASSERT_FALSE(cache.find(hash, found));
+
+     cache.store(hash, wanted);
+     TEST_ASSERT_TRUE(cache.find(hash, found));
+     TEST_ASSERT_EQUAL_MEMORY(&wanted, &found, sizeof(found));
+     TEST_ASSERT_FALSE(cache.find(hash ^ 1, found));
+ }
+
+ void test_least_recently_used_is_evicted() {
+     LoadoutCache cache;
+     Loadout loadouts[LOADOUT_CACHE_SIZE + 1];
+     uint64_t hashes[LOADOUT_CACHE_SIZE + 1];
+     for (uint8_t i = 0; i <= LOADOUT_CACHE_SIZE; i++) {
+         GunData data = Stinger;
+         data.damage = 10 + i;
+         loadouts[i] = loadoutOf(data, "Stinger");
+         hashes[i] = loadoutHash(loadouts[i]);
+     }
+     for (uint8_t i = 0; i < LOADOUT_CACHE_SIZE; i++) cache.store(hashes[i], loadouts[i]);
+
+     // Using the oldest entry makes the second one the least recently used
+     Loadout found;
+     TEST_ASSERT_TRUE(cache.find(hashes[0], found));
+     cache.store(hashes[LOADOUT_CACHE_SIZE], loadouts[LOADOUT_CACHE_SIZE]);
+
+     TEST_ASSERT_FALSE(cache.find(hashes[1], found));
+     for (uint8_t i = 0; i <= LOADOUT_CACHE_SIZE; i++) {
+         if (i == 1) continue;
+         TEST_ASSERT_TRUE(cache.find(hashes[i], found));
+         TEST_ASSERT_EQUAL_UINT32(10 + i, found.gunData.damage);
+     }
+ }
+
+ void test_storing_a_cached_hash_evicts_nothing() {
+     LoadoutCache cache;
+     Loadout loadouts[LOADOUT_CACHE_SIZE];
+     uint64_t hashes[LOADOUT_CACHE_SIZE];
+     for (uint8_t i = 0; i < LOADOUT_CACHE_SIZE; i++) {
+         GunData data = Ghost;
+         data.damage = 20 + i;
+         loadouts[i] = loadoutOf(data, "Ghost");
+         hashes[i] = loadoutHash(loadouts[i]);
+         cache.store(hashes[i], loadouts[i]);
+     }
+
+     // A second answer to a retried request arrives after the first
+     cache.store(hashes[LOADOUT_CACHE_SIZE - 1], loadouts[LOADOUT_CACHE_SIZE - 1]);
+
+     Loadout found;
+     for (uint8_t i = 0; i < LOADOUT_CACHE_SIZE; i++) {
+         TEST_ASSERT_TRUE(cache.find(hashes[i], found));
+         TEST_ASSERT_EQUAL_UINT32(20 + i, found.gunData.damage);
+     }
+ }
+
+ void test_gun_start_fits_one_frame() {
+     TEST_ASSERT_LESS_OR_EQUAL(NEXUS_MAX_PAYLOAD_SIZE, sizeof(GunStart));
+     TEST_ASSERT_LESS_OR_EQUAL(NEXUS_MAX_PAYLOAD_SIZE, sizeof(Loadout));
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_hash_names_the_content);
+     RUN_TEST(test_name_is_zero_padded);
+     RUN_TEST(test_miss_then_hit);
+     RUN_TEST(test_least_recently_used_is_evicted);
+     RUN_TEST(test_storing_a_cached_hash_evicts_nothing);
+     RUN_TEST(test_gun_start_fits_one_frame);
+     return UNITY_END();
+ }
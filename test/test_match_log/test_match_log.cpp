@@ -0,0 +1,125 @@
+/**
+ * @file test_match_log.cpp
+ * @brief Host tests for MatchLog: ring appends, spill to a sink, overflow and replay.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+
+ static MatchEvent seen[2 * MATCH_LOG_SIZE]; ///< Records received by the test sink or handler
+ static size_t seenCount;                     ///< Records in seen
+ static int sinkCalls;                        ///< Calls of the test sink
+
+ static void recordSink(const MatchEvent *events, size_t count) {
+     sinkCalls++;
+     for (size_t i = 0; i < count; i++) seen[seenCount++] = events[i];
+ }
+
+ static void recordEvent(const MatchEvent &event) { seen[seenCount++] = event; }
+
+ void setUp() {
+     setMillis(5000);
+     MatchLog::setSink(nullptr);
+     MatchLog::begin();
+     seenCount = 0;
+     sinkCalls = 0;
+ }
+ void tearDown() { MatchLog::setSink(nullptr); }
+
+ void test_append_and_replay_in_order() {
+     MatchLog::append(1, MATCH_EVENT_STATUS, MATCH_LOG_NONE, MATCH_LOG_NONE, 0, GAME_RUNNING);
+     advanceMillis(40);
+     MatchLog::append(1, MATCH_EVENT_HIT, 2, 0, 17, 25);
+     TEST_ASSERT_EQUAL(2, MatchLog::size());
+
+     MatchLog::replay(recordEvent);
+     TEST_ASSERT_EQUAL(2, seenCount);
+     TEST_ASSERT_EQUAL_UINT32(0, seen[0].time);
+     TEST_ASSERT_EQUAL_UINT8(MATCH_EVENT_STATUS, seen[0].type);
+     TEST_ASSERT_EQUAL_INT32(GAME_RUNNING, seen[0].value);
+     TEST_ASSERT_EQUAL_UINT32(40, seen[1].time);
+     TEST_ASSERT_EQUAL_UINT8(1, seen[1].match);
+     TEST_ASSERT_EQUAL_UINT8(2, seen[1].player);
+     TEST_ASSERT_EQUAL_UINT8(0, seen[1].other);
+     TEST_ASSERT_EQUAL_UINT8(17, seen[1].arg);
+     TEST_ASSERT_EQUAL_INT32(25, seen[1].value);
+ }
+
+ void test_flush_spills_each_record_once() {
+     MatchLog::setSink(recordSink);
+     for (int i = 0; i < 3; i++) MatchLog::append(0, MATCH_EVENT_HP, 1, MATCH_LOG_NONE, 0, 100 - i);
+     MatchLog::flush();
+     MatchLog::flush();
+     TEST_ASSERT_EQUAL(1, sinkCalls);
+     TEST_ASSERT_EQUAL(3, seenCount);
+     TEST_ASSERT_EQUAL_INT32(98, seen[2].value);
+     // Spilled records stay available for replay
+     TEST_ASSERT_EQUAL(3, MatchLog::size());
+ }
+
+ void test_flush_across_the_wrap_keeps_order() {
+     MatchLog::setSink(recordSink);
+     for (int i = 0; i < MATCH_LOG_SIZE - 10; i++) MatchLog::append(0, MATCH_EVENT_SHOTS, 0, MATCH_LOG_NONE, 0, i);
+     MatchLog::flush();
+     seenCount = 0;
+     sinkCalls = 0;
+
+     for (int i = 0; i < 20; i++) MatchLog::append(0, MATCH_EVENT_SHOTS, 0, MATCH_LOG_NONE, 0, 1000 + i);
+     MatchLog::flush();
+     TEST_ASSERT_EQUAL(2, sinkCalls);
+     TEST_ASSERT_EQUAL(20, seenCount);
+     for (int i = 0; i < 20; i++) TEST_ASSERT_EQUAL_INT32(1000 + i, seen[i].value);
+     TEST_ASSERT_EQUAL_UINT32(0, MatchLog::lost());
+ }
+
+ void test_overflow_counts_lost_records_only_with_a_sink() {
+     for (int i = 0; i < MATCH_LOG_SIZE + 5; i++) MatchLog::append(0, MATCH_EVENT_SHOTS, 0, MATCH_LOG_NONE, 0, i);
+     TEST_ASSERT_EQUAL_UINT32(0, MatchLog::lost());
+     TEST_ASSERT_EQUAL(MATCH_LOG_SIZE, MatchLog::size());
+
+     // Replay starts at the oldest record still in RAM
+     MatchLog::replay(recordEvent);
+     TEST_ASSERT_EQUAL(MATCH_LOG_SIZE, seenCount);
+     TEST_ASSERT_EQUAL_INT32(5, seen[0].value);
+
+     MatchLog::setSink(recordSink);
+     for (int i = 0; i < MATCH_LOG_SIZE + 5; i++) MatchLog::append(0, MATCH_EVENT_SHOTS, 0, MATCH_LOG_NONE, 0, i);
+     TEST_ASSERT_EQUAL_UINT32(5, MatchLog::lost());
+ }
+
+ void test_match_logs_status_hits_and_hp() {
+     Match *match = new Match();
+     match->id = 2;
+     match->projectID = 10;
+     for (uint8_t i = 0; i < 2; i++) {
+         match->players[i].setGunAddress(NexusAddress(10, 0, 10 + i));
+         match->players[i].setVestAddress(NexusAddress(10, 0, 20 + i));
+     }
+     match->start();
+     MatchLog::begin();
+     match->setStatus(GAME_RUNNING);
+     NEC_DATA code(Game::encodeFireCode(match->irProtocol, match->fireSignals[0].address, 9));
+     TEST_ASSERT_TRUE(match->processHit(21, code, 0x01));
+
+     MatchLog::replay(recordEvent);
+     TEST_ASSERT_EQUAL(3, seenCount);
+     TEST_ASSERT_EQUAL_UINT8(MATCH_EVENT_STATUS, seen[0].type);
+     TEST_ASSERT_EQUAL_UINT8(MATCH_EVENT_HIT, seen[1].type);
+     TEST_ASSERT_EQUAL_UINT8(2, seen[1].match);
+     TEST_ASSERT_EQUAL_UINT8(1, seen[1].player);
+     TEST_ASSERT_EQUAL_UINT8(0, seen[1].other);
+     TEST_ASSERT_EQUAL_UINT8(9, seen[1].arg);
+     TEST_ASSERT_EQUAL_UINT8(MATCH_EVENT_HP, seen[2].type);
+     TEST_ASSERT_EQUAL_INT32(match->players[1].getHP(), seen[2].value);
+     delete match;
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_append_and_replay_in_order);
+     RUN_TEST(test_flush_spills_each_record_once);
+     RUN_TEST(test_flush_across_the_wrap_keeps_order);
+     RUN_TEST(test_overflow_counts_lost_records_only_with_a_sink);
+     RUN_TEST(test_match_logs_status_hits_and_hp);
+     return UNITY_END();
+ }
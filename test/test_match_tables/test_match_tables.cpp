@@ -0,0 +1,112 @@
+/**
+ * @file test_match_tables.cpp
+ * @brief Host tests for N-player matches: teams, device and shooter lookup tables and team results.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+
+ static Match *match; ///< 16 players in four teams of four, started by setUp()
+
+ /** @brief Team of player index @p i in the setUp() match. */
+ static uint8_t teamOf(uint8_t i) { return i / 4 + 1; }
+
+ void setUp() {
+     match = new Match();
+     match->projectID = 10;
+     match->setPlayerCount(GAME_MAX_PLAYERS);
+     for (uint8_t i = 0; i < GAME_MAX_PLAYERS; i++) {
+         match->setTeam(i + 1, teamOf(i));
+         match->players[i].setGunAddress(NexusAddress(10, 0, 100 + i));
+         match->players[i].setVestAddress(NexusAddress(10, 0, 200 + i));
+     }
+     match->start();
+     match->setStatus(GAME_RUNNING);
+ }
+
+ void tearDown() { delete match; }
+
+ /** @brief Fire code of player index @p index's shot number @p shot. */
+ static NEC_DATA shot(uint8_t index, uint8_t shot) {
+     return NEC_DATA(Game::encodeFireCode(match->irProtocol, match->fireSignals[index].address, shot));
+ }
+
+ void test_player_count_is_clamped() {
+     Match *other = new Match();
+     TEST_ASSERT_EQUAL_UINT8(2, other->playerCount);
+     other->setPlayerCount(GAME_MAX_PLAYERS + 5);
+     TEST_ASSERT_EQUAL_UINT8(GAME_MAX_PLAYERS, other->playerCount);
+     // Free-for-all by default: every player is its own team
+     TEST_ASSERT_EQUAL_UINT8(16, other->team[15]);
+     delete other;
+ }
+
+ void test_lookup_tables_map_devices_and_shooters() {
+     for (uint8_t i = 0; i < GAME_MAX_PLAYERS; i++) {
+         TEST_ASSERT_EQUAL_UINT8(i, match->vestToPlayer[200 + i]);
+         TEST_ASSERT_EQUAL_UINT8(i, match->gunToPlayer[100 + i]);
+         TEST_ASSERT_EQUAL_UINT8(i, match->shooterToPlayer[match->fireSignals[i].address]);
+         TEST_ASSERT_EQUAL_UINT8(i / 4 * 4, match->teamLead[i]);
+     }
+     TEST_ASSERT_EQUAL_UINT8(GAME_NO_PLAYER, match->vestToPlayer[100]);
+     TEST_ASSERT_EQUAL_UINT8(GAME_NO_PLAYER, match->gunToPlayer[200]);
+     TEST_ASSERT_EQUAL_UINT8(GAME_NO_PLAYER, match->vestToPlayer[0]);
+ }
+
+ void test_has_player_hit_follows_teams() {
+     for (uint8_t a = 0; a < GAME_MAX_PLAYERS; a++) {
+         for (uint8_t v = 0; v < GAME_MAX_PLAYERS; v++) {
+             TEST_ASSERT_EQUAL(teamOf(a) != teamOf(v), match->hasPlayerHit(shot(a, 0), v + 1));
+         }
+     }
+     TEST_ASSERT_FALSE(match->hasPlayerHit(shot(0, 0), 0));
+     TEST_ASSERT_FALSE(match->hasPlayerHit(shot(0, 0), GAME_MAX_PLAYERS + 1));
+ }
+
+ void test_every_player_can_hit_the_next_team() {
+     for (uint8_t a = 0; a < GAME_MAX_PLAYERS; a++) {
+         uint8_t victim = (a + 4) % GAME_MAX_PLAYERS;
+         int before = match->players[victim].getHP();
+         TEST_ASSERT_TRUE(match->processHit(200 + victim, shot(a, 1), 0x01));
+         TEST_ASSERT_EQUAL(before - match->damageTable[a][0][0x01], match->players[victim].getHP());
+         TEST_ASSERT_EQUAL_UINT32(1, match->stats[a].hits);
+     }
+     // Teammates and unknown vests never take damage
+     TEST_ASSERT_FALSE(match->processHit(201, shot(0, 2), 0x01));
+     TEST_ASSERT_FALSE(match->processHit(99, shot(0, 3), 0x01));
+ }
+
+ void test_team_results() {
+     uint8_t survivor;
+     TEST_ASSERT_FALSE(match->oneTeamLeft(survivor));
+
+     // Everyone outside team 3 is out; team 3 has the most HP left
+     for (uint8_t i = 0; i < GAME_MAX_PLAYERS; i++) {
+         if (teamOf(i) != 3) match->players[i].setHP(0);
+     }
+     TEST_ASSERT_TRUE(match->oneTeamLeft(survivor));
+     TEST_ASSERT_EQUAL_UINT8(3, survivor);
+     TEST_ASSERT_EQUAL_UINT8(3, match->teamWithMostHP());
+ }
+
+ void test_can_start_rejects_shared_devices() {
+     TEST_ASSERT_TRUE(match->canStart());
+     match->players[7].setVestAddress(NexusAddress(10, 0, 200));
+     TEST_ASSERT_FALSE(match->canStart());
+     match->players[7].setVestAddress(NexusAddress(10, 0, 207));
+
+     // A single team has nobody to shoot at
+     for (uint8_t i = 0; i < GAME_MAX_PLAYERS; i++) match->setTeam(i + 1, 1);
+     TEST_ASSERT_FALSE(match->canStart());
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_player_count_is_clamped);
+     RUN_TEST(test_lookup_tables_map_devices_and_shooters);
+     RUN_TEST(test_has_player_hit_follows_teams);
+     RUN_TEST(test_every_player_can_hit_the_next_team);
+     RUN_TEST(test_team_results);
+     RUN_TEST(test_can_start_rejects_shared_devices);
+     return UNITY_END();
+ }
@@ -0,0 +1,112 @@
+/**
+ * @file test_multi_match.cpp
+ * @brief Host tests for several concurrent matches on one Manager: project routing and isolation.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+
+ /** Project ID of match 0 in every test. */
+ #define FIRST_PROJECT 10
+
+ /**
+  * @brief Gives a match two players whose devices have the same deviceIDs in every match.
+  */
+ static void setUpMatch(Match &match) {
+     for (uint8_t i = 0; i < 2; i++) {
+         match.players[i].setGunAddress(NexusAddress(match.projectID, 0, 10 + i));
+         match.players[i].setVestAddress(NexusAddress(match.projectID, 0, 20 + i));
+     }
+     match.start();
+     match.setStatus(GAME_RUNNING);
+ }
+
+ void setUp() {
+     setMillis(1000);
+     Game::begin(FIRST_PROJECT);
+     Game::select(0);
+ }
+ void tearDown() {}
+
+ /** @brief Fire code of player index @p index of @p match. */
+ static NEC_DATA shot(const Match &match, uint8_t index, uint8_t shot) {
+     return NEC_DATA(Game::encodeFireCode(match.irProtocol, match.fireSignals[index].address, shot));
+ }
+
+ void test_projects_route_to_their_match() {
+     for (uint8_t i = 0; i < GAME_MAX_MATCHES; i++) {
+         TEST_ASSERT_EQUAL_PTR(&Game::matches[i], Game::matchFor(FIRST_PROJECT + i));
+         TEST_ASSERT_EQUAL_UINT8(i, Game::matches[i].id);
+         TEST_ASSERT_EQUAL_UINT8(FIRST_PROJECT + i, Game::matches[i].projectID);
+     }
+     TEST_ASSERT_NULL(Game::matchFor(FIRST_PROJECT - 1));
+     TEST_ASSERT_NULL(Game::matchFor(FIRST_PROJECT + GAME_MAX_MATCHES));
+ }
+
+ void test_routing_wraps_and_is_rebuilt() {
+     Game::begin(254);
+     TEST_ASSERT_EQUAL_PTR(&Game::matches[1], Game::matchFor(255));
+     TEST_ASSERT_EQUAL_PTR(&Game::matches[2], Game::matchFor(0));
+     TEST_ASSERT_NULL(Game::matchFor(FIRST_PROJECT));
+
+     Game::begin(FIRST_PROJECT);
+     TEST_ASSERT_NULL(Game::matchFor(254));
+     TEST_ASSERT_EQUAL_PTR(&Game::matches[0], Game::matchFor(FIRST_PROJECT));
+ }
+
+ void test_gui_selects_one_match() {
+     Game::select(2);
+     TEST_ASSERT_EQUAL_PTR(&Game::matches[2], &Game::current());
+     Game::select(GAME_MAX_MATCHES);
+     TEST_ASSERT_EQUAL_PTR(&Game::matches[2], &Game::current());
+ }
+
+ void test_matches_are_isolated() {
+     Match &first = Game::matches[0];
+     Match &second = Game::matches[1];
+     setUpMatch(first);
+     setUpMatch(second);
+
+     // Same deviceID, other project: only the routed match takes the hit
+     Match *routed = Game::matchFor(second.projectID);
+     TEST_ASSERT_TRUE(routed->processHit(21, shot(second, 0, 1), 0x01));
+     TEST_ASSERT_EQUAL(100, first.players[1].getHP());
+     TEST_ASSERT_LESS_THAN(100, second.players[1].getHP());
+
+     // A gun of the other arena seen by a vest of this one is not a hit
+     TEST_ASSERT_FALSE(routed->processHit(21, shot(first, 0, 2), 0x01));
+     TEST_ASSERT_EQUAL_UINT32(1, second.stats[0].hits);
+     TEST_ASSERT_EQUAL_UINT32(0, first.stats[0].hits);
+ }
+
+ void test_timers_find_their_match() {
+     Match &second = Game::matches[1];
+     Match &third = Game::matches[2];
+     setUpMatch(second);
+     setUpMatch(third);
+
+     second.buff(0, 1);
+     third.buff(0, 1);
+     // Renewing the second match's buff makes its first timer stale
+     advanceMillis(second.damageModel->buffDuration / 2);
+     second.buff(0, 1);
+
+     advanceMillis(second.damageModel->buffDuration / 2);
+     countdowner->loop();
+     TEST_ASSERT_EQUAL_UINT8(0, third.buffLevel[0]);
+     TEST_ASSERT_EQUAL_UINT8(1, second.buffLevel[0]);
+
+     advanceMillis(second.damageModel->buffDuration);
+     countdowner->loop();
+     TEST_ASSERT_EQUAL_UINT8(0, second.buffLevel[0]);
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_projects_route_to_their_match);
+     RUN_TEST(test_routing_wraps_and_is_rebuilt);
+     RUN_TEST(test_gui_selects_one_match);
+     RUN_TEST(test_matches_are_isolated);
+     RUN_TEST(test_timers_find_their_match);
+     return UNITY_END();
+ }
@@ -0,0 +1,62 @@
+/**
+ * @file test_nexus_queue.cpp
+ * @brief Host tests for the paced Nexus send queue used by the Manager's fan-outs.
+ */
+
+ #include <unity.h>
+ #include "Components/Nexus/Nexus.hpp"
+
+ void setUp() {
+     setMillis(1000);
+     while (Nexus::outgoingPackets.size() > 0) Nexus::outgoingPackets.remove(0);
+     espNowFramesSent() = 0;
+ }
+ void tearDown() {}
+
+ /** @brief Queues @p count one-byte packets numbered from 0. */
+ static void queue(int count) {
+     for (int i = 0; i < count; i++) {
+         uint8_t n = i;
+         TEST_ASSERT_TRUE(Nexus::queueData(7, 1, &n, NexusAddress(10, 0xFF, 20 + i % 16)));
+     }
+ }
+
+ void test_fan_out_is_spread_over_loops() {
+     // Results of a 16-player match: status and mark to every Gun and Vest
+     queue(4 * 16);
+     TEST_ASSERT_EQUAL_UINT32(0, espNowFramesSent());
+
+     int loops = 0;
+     while (Nexus::outgoingPackets.size() > 0) {
+         unsigned before = espNowFramesSent();
+         Nexus::loop();
+         TEST_ASSERT_TRUE(espNowFramesSent() - before <= NEXUS_SENDS_PER_LOOP);
+         loops++;
+     }
+     TEST_ASSERT_EQUAL_UINT32(4 * 16, espNowFramesSent());
+     TEST_ASSERT_EQUAL(4 * 16 / NEXUS_SENDS_PER_LOOP, loops);
+ }
+
+ void test_queue_keeps_order() {
+     queue(NEXUS_SENDS_PER_LOOP + 2);
+     Nexus::loop();
+     TEST_ASSERT_EQUAL(2, Nexus::outgoingPackets.size());
+     TEST_ASSERT_EQUAL_UINT8(NEXUS_SENDS_PER_LOOP, Nexus::outgoingPackets[0].payload[0]);
+     TEST_ASSERT_EQUAL_UINT8(NEXUS_SENDS_PER_LOOP + 1, Nexus::outgoingPackets[1].payload[0]);
+ }
+
+ void test_queue_is_bounded() {
+     queue(NEXUS_OUTGOING_LIMIT);
+     uint8_t n = 0;
+     TEST_ASSERT_FALSE(Nexus::queueData(7, 1, &n, NexusAddress(10, 0xFF, 20)));
+     Nexus::loop();
+     TEST_ASSERT_TRUE(Nexus::queueData(7, 1, &n, NexusAddress(10, 0xFF, 20)));
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_fan_out_is_spread_over_loops);
+     RUN_TEST(test_queue_keeps_order);
+     RUN_TEST(test_queue_is_bounded);
+     return UNITY_END();
+ }
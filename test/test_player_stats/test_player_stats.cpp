@@ -0,0 +1,118 @@
+/**
+ * @file test_player_stats.cpp
+ * @brief Host tests for PlayerStats: streaks, sliding DPS window, time-to-kill and shot inference.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+
+ void setUp() { setMillis(0); }
+ void tearDown() {}
+
+ void test_hits_and_streaks() {
+     PlayerStats stats;
+     stats.landHit(0, 10, 0);
+     stats.landHit(1, 10, 0);
+     stats.landHit(2, 15, 0);
+     stats.takeHit(20, 0); // Being hit ends the streak
+     stats.landHit(3, 10, 0);
+
+     TEST_ASSERT_EQUAL_UINT32(4, stats.hits);
+     TEST_ASSERT_EQUAL_UINT32(45, stats.damageDealt);
+     TEST_ASSERT_EQUAL_UINT32(20, stats.damageTaken);
+     TEST_ASSERT_EQUAL_UINT16(1, stats.streak);
+     TEST_ASSERT_EQUAL_UINT16(3, stats.longestStreak);
+
+     stats.reset(0);
+     TEST_ASSERT_EQUAL_UINT32(0, stats.hits + stats.damageDealt + stats.damageTaken);
+     TEST_ASSERT_EQUAL_UINT16(0, stats.longestStreak);
+ }
+
+ void test_dps_window_slides() {
+     PlayerStats stats;
+     const float window = STATS_DPS_BUCKETS * STATS_DPS_BUCKET_MS / 1000.0f;
+     stats.landHit(0, 100, 0);
+     TEST_ASSERT_TRUE(stats.dps(0) == 100 / window);
+
+     // Still inside the window on its last millisecond, gone after it
+     uint32_t end = STATS_DPS_BUCKETS * STATS_DPS_BUCKET_MS;
+     TEST_ASSERT_TRUE(stats.dps(end - 1) == 100 / window);
+     stats.landHit(1, 50, end - 1);
+     TEST_ASSERT_TRUE(stats.dps(end) == 50 / window);
+
+     // A long pause empties the whole window at once
+     TEST_ASSERT_TRUE(stats.dps(end + 60000) == 0.0f);
+ }
+
+ void test_time_to_kill() {
+     PlayerStats victim;
+     TEST_ASSERT_EQUAL_UINT32(0, victim.takeHit(30, 1000));
+     TEST_ASSERT_EQUAL_UINT32(1500, victim.takeHit(30, 2500));
+
+     // Healing restarts the clock at the next wound
+     victim.heal();
+     TEST_ASSERT_EQUAL_UINT32(0, victim.takeHit(30, 9000));
+
+     PlayerStats killer;
+     killer.landKill(1200);
+     killer.landKill(800);
+     killer.landKill(1500);
+     TEST_ASSERT_EQUAL_UINT32(3, killer.kills);
+     TEST_ASSERT_EQUAL_UINT32(1500, killer.lastTimeToKill);
+     TEST_ASSERT_EQUAL_UINT32(800, killer.bestTimeToKill);
+ }
+
+ void test_shots_inferred_from_counters() {
+     PlayerStats stats;
+     stats.landHit(3, 10, 0);   // at least 4 shots
+     stats.landHit(9, 10, 0);   // at least 10
+     stats.landHit(7, 10, 0);   // a late, older shot adds none
+     TEST_ASSERT_EQUAL_UINT32(10, stats.shotsImplied);
+     stats.landHit(120, 10, 0);
+     stats.landHit(240, 10, 0); // at least 241
+     stats.landHit(4, 10, 0);   // counter wrapped: 20 more
+     TEST_ASSERT_EQUAL_UINT32(261, stats.shotsImplied);
+     TEST_ASSERT_EQUAL_UINT32(261, stats.shotsFired());
+ }
+
+ void test_match_feeds_stats_from_process_hit() {
+     Match *match = new Match();
+     match->projectID = 10;
+     for (uint8_t i = 0; i < 2; i++) {
+         match->players[i].setGunAddress(NexusAddress(10, 0, 10 + i));
+         match->players[i].setVestAddress(NexusAddress(10, 0, 20 + i));
+         match->players[i].setGunData(Hammerfall);
+     }
+     setMillis(1000);
+     match->start();
+     match->setStatus(GAME_RUNNING);
+
+     // Hammerfall hits until the victim falls, one second apart
+     uint8_t shot = 0;
+     while (match->players[1].isAlive()) {
+         NEC_DATA code(Game::encodeFireCode(match->irProtocol, match->fireSignals[0].address, shot++));
+         TEST_ASSERT_TRUE(match->processHit(21, code, 0x01));
+         advanceMillis(1000);
+     }
+     PlayerStats &killer = match->stats[0];
+     TEST_ASSERT_EQUAL_UINT32(shot, killer.hits);
+     TEST_ASSERT_EQUAL_UINT32(100, killer.damageDealt);
+     TEST_ASSERT_EQUAL_UINT32(100, match->stats[1].damageTaken);
+     TEST_ASSERT_EQUAL_UINT32(1, killer.kills);
+     TEST_ASSERT_EQUAL_UINT32((shot - 1) * 1000UL, killer.lastTimeToKill);
+
+     // The gun's report at the end of the game raises the shot count
+     TEST_ASSERT_TRUE(match->recordShots(10, shot * 2));
+     TEST_ASSERT_TRUE(match->getAccuracy(1) == 0.5f);
+     delete match;
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_hits_and_streaks);
+     RUN_TEST(test_dps_window_slides);
+     RUN_TEST(test_time_to_kill);
+     RUN_TEST(test_shots_inferred_from_counters);
+     RUN_TEST(test_match_feeds_stats_from_process_hit);
+     return UNITY_END();
+ }
@@ -0,0 +1,152 @@
+/**
+ * @file test_replica.cpp
+ * @brief Host tests for the replication frames: deltas, forced full frames, apply and gap detection.
+ */
+
+ #include <unity.h>
+ #include "Modules/Replica.hpp"
+ #include "Common/Constants_Common.h"
+
+ /** Nexus project of the first arena. */
+ #define TEST_PROJECT 10
+
+ static Match *primary;      ///< Match as seen by the primary Manager (index 1)
+ static ReplicaFrame *last;  ///< Last full frame sent for it
+ static ReplicaFrame *full;  ///< Scratch frame for capture()
+ static ReplicaFrame *out;   ///< Scratch frame for delta()
+
+ void setUp() {
+     Game::begin(TEST_PROJECT);
+     primary = new Match();
+     primary->id = 1;
+     primary->projectID = TEST_PROJECT + 1;
+     primary->setPlayerCount(3);
+     for (uint8_t i = 0; i < 3; i++) {
+         primary->setTeam(i + 1, i == 2 ? 2 : 1);
+         primary->players[i].setGunAddress(NexusAddress(TEST_PROJECT + 1, NEXUS_GROUP_GUN, 10 + i));
+         primary->players[i].setVestAddress(NexusAddress(TEST_PROJECT + 1, NEXUS_GROUP_VEST, 20 + i));
+     }
+     primary->players[1].clearGun();
+     primary->start();
+     primary->setStatus(GAME_RUNNING);
+
+     last = new ReplicaFrame();
+     full = new ReplicaFrame();
+     out  = new ReplicaFrame();
+     memset(last, 0, sizeof(*last));
+ }
+
+ void tearDown() {
+     delete primary;
+     delete last;
+     delete full;
+     delete out;
+ }
+
+ /** @brief Builds the next frame of the primary, as the Manager's replicate() does. */
+ static uint8_t next(bool all = false) {
+     Replica::capture(*primary, *full);
+     return Replica::delta(*full, *last, *out, all);
+ }
+
+ void test_unchanged_match_sends_nothing() {
+     TEST_ASSERT_EQUAL_UINT8(Replica::frameSize(3), next());
+     TEST_ASSERT_EQUAL_UINT8(0, next());
+     TEST_ASSERT_EQUAL_UINT8(Replica::frameSize(3), next(true)); // heartbeat
+     TEST_ASSERT_EQUAL_UINT8(1, out->full);
+ }
+
+ void test_delta_lists_only_changed_players() {
+     next();
+     primary->players[2].setHP(55);
+     TEST_ASSERT_EQUAL_UINT8(Replica::frameSize(1), next());
+     TEST_ASSERT_EQUAL_UINT8(0, out->full);
+     TEST_ASSERT_EQUAL_UINT8(1, out->count);
+     TEST_ASSERT_EQUAL_UINT8(2, out->players[0].index);
+     TEST_ASSERT_EQUAL_INT16(55, out->players[0].hp);
+     TEST_ASSERT_EQUAL_UINT16(2, out->seq);
+
+     // A header change alone still costs a frame, without player entries
+     primary->topScore = 3;
+     TEST_ASSERT_EQUAL_UINT8(Replica::frameSize(0), next());
+     TEST_ASSERT_EQUAL_UINT16(3, out->header.topScore);
+ }
+
+ void test_every_tenth_frame_is_full() {
+     for (uint16_t seq = 1; seq <= 3 * REPLICA_FULL_EVERY; seq++) {
+         primary->players[0].setHP(100 - seq);
+         next();
+         TEST_ASSERT_EQUAL_UINT16(seq, out->seq);
+         bool forced = seq % REPLICA_FULL_EVERY == 0;
+         TEST_ASSERT_EQUAL(seq == 1 || forced, out->count == 3);
+         TEST_ASSERT_EQUAL(seq == 1 || forced, out->full != 0);
+     }
+ }
+
+ void test_standby_reproduces_the_match() {
+     primary->players[0].setHP(30);
+     primary->teamScore[primary->teamLead[2]] = 4;
+     primary->protectedMask = 0x4;
+     next(true);
+     TEST_ASSERT_TRUE(Replica::apply(*out));
+
+     Match &standby = Game::matches[1];
+     TEST_ASSERT_EQUAL(GAME_RUNNING, standby.status);
+     TEST_ASSERT_EQUAL_UINT8(3, standby.playerCount);
+     TEST_ASSERT_EQUAL_UINT32(0x4, standby.protectedMask);
+     for (uint8_t i = 0; i < 3; i++) {
+         TEST_ASSERT_EQUAL_INT(primary->players[i].getHP(), standby.players[i].getHP());
+         TEST_ASSERT_EQUAL_UINT8(primary->team[i], standby.team[i]);
+         TEST_ASSERT_EQUAL_HEX8(primary->fireSignals[i].address, standby.fireSignals[i].address);
+         TEST_ASSERT_EQUAL_UINT32(primary->gunDamage[i], standby.gunDamage[i]);
+         TEST_ASSERT_TRUE(primary->players[i].getVestAddress() == standby.players[i].getVestAddress());
+     }
+     TEST_ASSERT_FALSE(standby.players[1].hasGun());
+     TEST_ASSERT_EQUAL_UINT16(4, standby.teamScore[standby.teamLead[2]]);
+     // Lookup tables are rebuilt, so the standby can process hits at once
+     TEST_ASSERT_EQUAL_UINT8(2, standby.vestToPlayer[22]);
+
+     // A delta moves only the changed player
+     primary->players[1].setHP(5);
+     next();
+     TEST_ASSERT_TRUE(Replica::apply(*out));
+     TEST_ASSERT_EQUAL_INT(5, standby.players[1].getHP());
+     TEST_ASSERT_EQUAL_INT(30, standby.players[0].getHP());
+
+     out->match = GAME_MAX_MATCHES;
+     TEST_ASSERT_FALSE(Replica::apply(*out));
+ }
+
+ void test_lost_delta_is_detected_until_a_full_frame() {
+     next();
+     Replica::apply(*out);
+     TEST_ASSERT_TRUE(Replica::inSync(1));
+
+     primary->players[0].setHP(90);
+     next();                                   // lost on air
+     primary->players[0].setHP(80);
+     next();
+     Replica::apply(*out);
+     TEST_ASSERT_FALSE(Replica::inSync(1));
+
+     // Deltas in order do not repair the gap; the next forced full frame does
+     while (true) {
+         primary->players[2].setHP(primary->players[2].getHP() - 1);
+         next();
+         Replica::apply(*out);
+         if (out->full) break;
+         TEST_ASSERT_FALSE(Replica::inSync(1));
+     }
+     TEST_ASSERT_TRUE(Replica::inSync(1));
+     TEST_ASSERT_EQUAL_UINT16(REPLICA_FULL_EVERY, out->seq);
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_unchanged_match_sends_nothing);
+     RUN_TEST(test_delta_lists_only_changed_players);
+     RUN_TEST(test_every_tenth_frame_is_full);
+     RUN_TEST(test_standby_reproduces_the_match);
+     RUN_TEST(test_lost_delta_is_detected_until_a_full_frame);
+     return UNITY_END();
+ }
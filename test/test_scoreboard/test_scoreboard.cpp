@@ -0,0 +1,113 @@
+/**
+ * @file test_scoreboard.cpp
+ * @brief Host tests for the scoreboard rate limit, the frame builder and the narrator.
+ */
+
+ #include <unity.h>
+ #include "Modules/Scoreboard.hpp"
+
+ static ScoreboardFeed *feed; ///< Fresh feed of every test
+
+ void setUp() { feed = new ScoreboardFeed(); }
+ void tearDown() { delete feed; }
+
+ /** @brief A frame that differs from the zeroed start state. */
+ static Scoreboard frame(uint8_t hp) {
+     Scoreboard board;
+     memset(&board, 0, sizeof(board));
+     board.playerCount = 2;
+     board.hp[0] = hp;
+     board.hp[1] = 100;
+     return board;
+ }
+
+ void test_passes_are_spaced_by_the_interval() {
+     TEST_ASSERT_FALSE(feed->pass(SCOREBOARD_INTERVAL_MS - 1));
+     TEST_ASSERT_TRUE(feed->pass(1000));
+     TEST_ASSERT_FALSE(feed->pass(1000 + SCOREBOARD_INTERVAL_MS - 1));
+     TEST_ASSERT_TRUE(feed->pass(1000 + SCOREBOARD_INTERVAL_MS));
+ }
+
+ void test_pass_survives_millis_wrap() {
+     uint32_t start = UINT32_MAX - 100;
+     TEST_ASSERT_TRUE(feed->pass(start));
+     TEST_ASSERT_FALSE(feed->pass(start + 100));
+     TEST_ASSERT_TRUE(feed->pass(start + SCOREBOARD_INTERVAL_MS));
+ }
+
+ void test_only_changed_frames_are_sent() {
+     TEST_ASSERT_TRUE(feed->due(0, frame(100), 1000));
+     TEST_ASSERT_FALSE(feed->due(0, frame(100), 1250));
+     TEST_ASSERT_TRUE(feed->due(0, frame(90), 1500));
+     TEST_ASSERT_FALSE(feed->due(0, frame(90), 1750));
+ }
+
+ void test_unchanged_frame_is_repeated_as_heartbeat() {
+     TEST_ASSERT_TRUE(feed->due(0, frame(100), 1000));
+     TEST_ASSERT_FALSE(feed->due(0, frame(100), 1000 + SCOREBOARD_HEARTBEAT_MS - 1));
+     TEST_ASSERT_TRUE(feed->due(0, frame(100), 1000 + SCOREBOARD_HEARTBEAT_MS));
+     TEST_ASSERT_FALSE(feed->due(0, frame(100), 1000 + SCOREBOARD_HEARTBEAT_MS + 250));
+ }
+
+ void test_matches_are_limited_independently() {
+     TEST_ASSERT_TRUE(feed->due(0, frame(100), 1000));
+     TEST_ASSERT_TRUE(feed->due(1, frame(100), 1000));
+     TEST_ASSERT_TRUE(feed->due(1, frame(50), 1250));
+     TEST_ASSERT_FALSE(feed->due(0, frame(100), 1250));
+ }
+
+ void test_frames_per_second_stay_bounded() {
+     // A match whose HP changes on every loop still costs at most one frame per pass
+     uint32_t sent = 0;
+     for (uint32_t now = 1; now <= 10000; now++) {
+         if (!feed->pass(now)) continue;
+         if (feed->due(0, frame(now & 0xFF), now)) sent++;
+     }
+     TEST_ASSERT_LESS_OR_EQUAL(10000 / SCOREBOARD_INTERVAL_MS, sent);
+     TEST_ASSERT_GREATER_THAN(0, sent);
+ }
+
+ void test_build_and_narrate_every_player() {
+     Match *match = new Match();
+     match->setPlayerCount(4);
+     for (uint8_t i = 0; i < 4; i++) match->setTeam(i + 1, i + 1);
+     match->start();
+     match->setStatus(GAME_RUNNING);
+     match->players[0].setHP(40);
+     match->players[1].setHP(70);
+     match->players[3].setHP(10);
+
+     Scoreboard board;
+     Spectator::build(*match, board);
+     TEST_ASSERT_EQUAL_UINT8(4, board.playerCount);
+     TEST_ASSERT_EQUAL_UINT8(100, board.hp[2]);
+     TEST_ASSERT_EQUAL_UINT8(10, board.hp[3]);
+     TEST_ASSERT_EQUAL_UINT8(0, board.hp[4]);
+     TEST_ASSERT_EQUAL(0, board.narration[SCOREBOARD_NARRATION - 1]);
+     // The narrator looks past players 1 and 2: player 3 leads at full HP
+     TEST_ASSERT_EQUAL_STRING(Spectator::narrate(*match).c_str(), board.narration);
+     TEST_ASSERT_TRUE(strncmp(board.narration, "Player 3 is blazing", 19) == 0);
+
+     match->players[2].setHP(90);
+     TEST_ASSERT_TRUE(strncmp(Spectator::narrate(*match).c_str(), "Player 4 is hanging", 19) == 0);
+
+     match->players[3].setHP(100);
+     match->players[0].setHP(100);
+     match->players[1].setHP(100);
+     match->players[2].setHP(80);
+     TEST_ASSERT_EQUAL_STRING("The duel rages on... Every shot is a heartbeat, and the tension is lighting up the arena!",
+                              Spectator::narrate(*match).c_str());
+     delete match;
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_passes_are_spaced_by_the_interval);
+     RUN_TEST(test_pass_survives_millis_wrap);
+     RUN_TEST(test_only_changed_frames_are_sent);
+     RUN_TEST(test_unchanged_frame_is_repeated_as_heartbeat);
+     RUN_TEST(test_matches_are_limited_independently);
+     RUN_TEST(test_frames_per_second_stay_bounded);
+     RUN_TEST(test_build_and_narrate_every_player);
+     return UNITY_END();
+ }
@@ -0,0 +1,112 @@
+/**
+ * @file test_shot_codes.cpp
+ * @brief Host tests for fire codes carrying shooter ID and shot counter: exact dedup and shot stats.
+ */
+
+ #include <unity.h>
+ #include "Modules/Game.hpp"
+ #include "VEST/Target/Target.hpp"
+
+ static Match *match; ///< Two-player match, running, with a victim that cannot die
+
+ void setUp() {
+     setMillis(1000);
+     Target::clear();
+     match = new Match();
+     match->projectID = 10;
+     for (uint8_t i = 0; i < 2; i++) {
+         match->players[i].setGunAddress(NexusAddress(10, 0, 10 + i));
+         match->players[i].setVestAddress(NexusAddress(10, 0, 20 + i));
+         match->players[i].setGunData(Stinger);
+     }
+     match->start();
+     match->setStatus(GAME_RUNNING);
+     match->players[1].setHP(1000000);
+ }
+
+ void tearDown() { delete match; }
+
+ /** @brief Fire code of player 1's shot number @p shot. */
+ static uint32_t shotCode(uint8_t shot) {
+     return Game::encodeFireCode(match->irProtocol, match->fireSignals[0].address, shot);
+ }
+
+ /** @brief Replays one encoded frame into a receiver; the train ends with the inter-frame gap. */
+ static void feedFrame(IRreceiver &receiver, uint32_t data) {
+     IRpulseTrain train;
+     IRencoder<NECProtocol>::encode(data, train);
+     for (uint8_t i = 0; i < train.length; ++i) {
+         receiver.feedEdge(micros());
+         advanceMicros(train.durations[i]);
+     }
+ }
+
+ void test_codes_round_trip_and_reject_corruption() {
+     for (uint8_t protocol = 0; protocol < 2; protocol++) {
+         IRprotocolID id = protocol ? IR_PROTOCOL_TAG : IR_PROTOCOL_NEC;
+         for (uint16_t shot = 0; shot < 256; shot++) {
+             uint32_t code = Game::encodeFireCode(id, 0x5A, shot);
+             uint8_t shooter, decoded;
+             TEST_ASSERT_TRUE(Game::decodeFireCode(id, code, shooter, decoded));
+             TEST_ASSERT_EQUAL_HEX8(0x5A, shooter);
+             TEST_ASSERT_EQUAL_UINT8(shot, decoded);
+             TEST_ASSERT_FALSE(Game::decodeFireCode(id, code ^ 0x10000, shooter, decoded));
+         }
+     }
+ }
+
+ void test_receivers_fuse_one_shot_exactly() {
+     // Shot 7 reaches all three receivers, then shot 8 follows inside the dedup window
+     for (uint8_t i = 0; i < Target::irReceiversCount; ++i) feedFrame(Target::irReceivers[i], shotCode(7));
+     feedFrame(Target::irReceivers[1], shotCode(8));
+     Target::loop();
+
+     TEST_ASSERT_EQUAL(2, Target::hasHit());
+     TargetHit first = Target::readHit();
+     TEST_ASSERT_EQUAL_HEX32(shotCode(7), first.code.data);
+     TEST_ASSERT_EQUAL_HEX8(0x07, first.receivers);
+     TargetHit second = Target::readHit();
+     TEST_ASSERT_EQUAL_HEX32(shotCode(8), second.code.data);
+     TEST_ASSERT_EQUAL_HEX8(0x02, second.receivers);
+ }
+
+ void test_manager_counts_each_shot_once() {
+     TEST_ASSERT_TRUE(match->processHit(21, NEC_DATA(shotCode(3)), 0x01));
+     TEST_ASSERT_FALSE(match->processHit(21, NEC_DATA(shotCode(3)), 0x04)); // late copy of the same shot
+     TEST_ASSERT_TRUE(match->processHit(21, NEC_DATA(shotCode(4)), 0x01));  // next shot, same millisecond
+     TEST_ASSERT_EQUAL_UINT32(2, match->stats[0].hits);
+ }
+
+ void test_accuracy_from_shot_counters() {
+     // Shots 0 to 9 fired, shots 0, 4 and 9 hit
+     const uint8_t hits[] = { 0, 4, 9 };
+     for (uint8_t i = 0; i < 3; i++) match->processHit(21, NEC_DATA(shotCode(hits[i])), 0x01);
+
+     PlayerStats &stats = match->stats[0];
+     TEST_ASSERT_EQUAL_UINT32(10, stats.shotsFired());
+     TEST_ASSERT_EQUAL_UINT32(3, stats.hits);
+     TEST_ASSERT_TRUE(stats.accuracy() > 0.29f && stats.accuracy() < 0.31f);
+
+     // The gun's own count wins once it reports more shots
+     stats.reportShots(12);
+     TEST_ASSERT_EQUAL_UINT32(12, stats.shotsFired());
+ }
+
+ void test_counter_wrap_is_not_a_duplicate() {
+     // Every shot of two full counter cycles hits once
+     for (uint16_t n = 0; n < 512; n++) {
+         TEST_ASSERT_TRUE(match->processHit(21, NEC_DATA(shotCode(n & 0xFF)), 0x01));
+     }
+     TEST_ASSERT_EQUAL_UINT32(512, match->stats[0].hits);
+     TEST_ASSERT_EQUAL_UINT32(512, match->stats[0].shotsFired());
+ }
+
+ int main(int argc, char **argv) {
+     UNITY_BEGIN();
+     RUN_TEST(test_codes_round_trip_and_reject_corruption);
+     RUN_TEST(test_receivers_fuse_one_shot_exactly);
+     RUN_TEST(test_manager_counts_each_shot_once);
+     RUN_TEST(test_accuracy_from_shot_counters);
+     RUN_TEST(test_counter_wrap_is_not_a_duplicate);
+     return UNITY_END();
+ }